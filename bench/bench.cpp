@@ -0,0 +1,151 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+#include <heatsink/platform/gl.hpp>
+
+namespace {
+	using steady_clock = std::chrono::steady_clock;
+
+	// Escape a string for inclusion in a JSON document.
+	std::string escape(const std::string& s) {
+		std::string result;
+		for (auto c : s) {
+			switch (c) {
+				case '"':  result += "\\\""; break;
+				case '\\': result += "\\\\"; break;
+				case '\n': result += "\\n"; break;
+				case '\t': result += "\\t"; break;
+				default:
+					if ((unsigned char)c < 0x20) {
+						char buffer[8];
+						std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+						result += buffer;
+					} else {
+						result += c;
+					}
+			}
+		}
+
+		return result;
+	}
+
+	// Retrieve a driver identification string (`GL_VENDOR`, etc.).
+	std::string get_string(GLenum e) {
+		const auto* s = glGetString(e);
+		return s ? reinterpret_cast<const char*>(s) : "";
+	}
+}
+
+namespace heatsink::bench {
+	suite::suite(std::chrono::nanoseconds budget, std::string filter)
+	: m_budget{budget}, m_filter{std::move(filter)} {}
+
+	bool suite::is_enabled(const std::string& name) const {
+		return m_filter.empty() || name.find(m_filter) != std::string::npos;
+	}
+
+	bool suite::is_any_enabled(const std::vector<std::string>& names) const {
+		return std::any_of(names.begin(), names.end(), [this](const std::string& n) { return this->is_enabled(n); });
+	}
+
+	void suite::measure(const std::string& name, const std::string& unit, double amount, const std::function<void()>& f) {
+		if (!this->is_enabled(name))
+			return;
+
+		// Warm up caches, driver state and any lazily allocated storage.
+		for (int i = 0; i != 3; ++i)
+			f();
+		glFinish();
+
+		// Time batches, doubling in size, so that reading the clock (and
+		// synchronizing with the GPU) is amortized over many iterations.
+		std::size_t n = 0;
+		std::size_t batch = 1;
+		auto start = steady_clock::now();
+		auto elapsed = steady_clock::duration::zero();
+		while (elapsed < m_budget) {
+			for (std::size_t i = 0; i != batch; ++i)
+				f();
+
+			glFinish();
+			n      += batch;
+			batch  *= 2;
+			elapsed = steady_clock::now() - start;
+		}
+
+		this->record(name, unit, amount, n, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+	}
+
+	void suite::measure_n(const std::string& name, const std::string& unit, double amount, std::size_t n, const std::function<void()>& f) {
+		if (!this->is_enabled(name) || n == 0)
+			return;
+
+		glFinish();
+		auto start = steady_clock::now();
+		for (std::size_t i = 0; i != n; ++i)
+			f();
+
+		glFinish();
+		auto elapsed = steady_clock::now() - start;
+		this->record(name, unit, amount, n, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+	}
+
+	const std::vector<result>& suite::get_results() const {
+		return m_results;
+	}
+
+	void suite::write_json(std::ostream& out) const {
+		// The stream may still be formatted by `write_table()`.
+		out << std::defaultfloat << std::setprecision(17);
+		out << "{\n";
+		out << "\t\"driver\": {\n";
+		out << "\t\t\"vendor\": \""   << escape(get_string(GL_VENDOR))   << "\",\n";
+		out << "\t\t\"renderer\": \"" << escape(get_string(GL_RENDERER)) << "\",\n";
+		out << "\t\t\"version\": \""  << escape(get_string(GL_VERSION))  << "\"\n";
+		out << "\t},\n";
+		out << "\t\"results\": [";
+
+		for (std::size_t i = 0; i != m_results.size(); ++i) {
+			const auto& r = m_results[i];
+			out << (i ? ",\n" : "\n");
+			out << "\t\t{"
+				<< "\"name\": \"" << escape(r.name) << "\", "
+				<< "\"unit\": \"" << escape(r.unit) << "\", "
+				<< "\"rate\": " << r.rate << ", "
+				<< "\"iteration_ns\": " << r.iteration_time << ", "
+				<< "\"iterations\": " << r.iterations << "}";
+		}
+
+		out << "\n\t]\n";
+		out << "}\n";
+	}
+
+	void suite::write_table(std::ostream& out) const {
+		for (const auto& r : m_results) {
+			out << std::left << std::setw(32) << r.name
+				<< std::right << std::setw(16) << std::fixed << std::setprecision(1) << r.rate
+				<< " " << std::left << std::setw(10) << (r.unit + "/s")
+				<< std::right << std::setw(14) << r.iteration_time << " ns/iter"
+				<< std::endl;
+		}
+	}
+
+	void suite::record(const std::string& name, const std::string& unit, double amount, std::size_t n, std::chrono::nanoseconds elapsed) {
+		auto seconds = std::chrono::duration<double>(elapsed).count();
+
+		result r = {
+			.name           = name,
+			.unit           = unit,
+			.rate           = (amount * (double)n) / seconds,
+			.iteration_time = (double)elapsed.count() / (double)n,
+			.iterations     = n,
+		};
+
+		std::clog << "  " << r.name << ": " << r.rate << " " << r.unit << "/s" << std::endl;
+		m_results.push_back(std::move(r));
+	}
+}
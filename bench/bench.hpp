@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace heatsink::bench {
+	/**
+	 * A single measurement. The rate is the number of units processed per
+	 * second (such as bytes, calls or draws), averaged over every iteration.
+	 */
+	struct result {
+	public:
+		std::string name;
+		std::string unit;
+		double rate;
+		// The mean time of a single iteration, in nanoseconds.
+		double iteration_time;
+		std::size_t iterations;
+	};
+
+	/**
+	 * Runs benchmarks and collects their results. Each benchmark is run for
+	 * (at least) a fixed time budget, after a short warm-up; the GPU is
+	 * synchronized with `glFinish()` before the clock is read, so work the
+	 * driver defers is included in the time.
+	 */
+	class suite {
+	public:
+		/**
+		 * Create a suite that spends the given time on each benchmark. Only
+		 * benchmarks whose name contains the filter are run.
+		 */
+		suite(std::chrono::nanoseconds budget, std::string filter = "");
+
+	public:
+		/**
+		 * Check if a benchmark passes the filter.
+		 */
+		bool is_enabled(const std::string& name) const;
+		/**
+		 * Check if any benchmark of a group passes the filter, so that the
+		 * setup of the group can be skipped otherwise.
+		 */
+		bool is_any_enabled(const std::vector<std::string>& names) const;
+
+		/**
+		 * Call the function repeatedly until the time budget is spent, where
+		 * each call processes the given amount of units.
+		 */
+		void measure(const std::string& name, const std::string& unit, double amount, const std::function<void()>&);
+		/**
+		 * Call the function the given number of times, for operations too
+		 * slow (or with too many side effects) to run until the budget is
+		 * spent, such as linking a program.
+		 */
+		void measure_n(const std::string& name, const std::string& unit, double amount, std::size_t n, const std::function<void()>&);
+
+		/**
+		 * Retrieve every result measured so far, in order.
+		 */
+		const std::vector<result>& get_results() const;
+
+		/**
+		 * Write the results as a JSON document, along with the identification
+		 * strings of the driver they were measured on.
+		 */
+		void write_json(std::ostream&) const;
+		/**
+		 * Write the results as a human readable table.
+		 */
+		void write_table(std::ostream&) const;
+
+	private:
+		// Record a result, and report it as it is measured.
+		void record(const std::string& name, const std::string& unit, double amount, std::size_t n, std::chrono::nanoseconds);
+
+	private:
+		std::chrono::nanoseconds m_budget;
+		std::string m_filter;
+		std::vector<result> m_results;
+	};
+
+	// The benchmark groups; each is defined in its own translation unit.
+	void run_buffer(suite&);
+	void run_texture(suite&);
+	void run_uniform(suite&);
+	void run_program(suite&);
+	void run_draw(suite&);
+}
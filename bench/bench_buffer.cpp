@@ -0,0 +1,49 @@
+#include "bench.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/ring_buffer.hpp>
+
+namespace heatsink::bench {
+	void run_buffer(suite& s) {
+		if (!s.is_any_enabled({"buffer.update", "buffer.map", "ring_buffer.write", "buffer.update_small", "ring_buffer.write_small"}))
+			return;
+
+		// Large enough to measure bandwidth instead of per-call overhead.
+		constexpr std::size_t size = 4 << 20;
+		std::vector<GLubyte> data(size, 0x5a);
+
+		auto b = gl::buffer(GL_ARRAY_BUFFER, size, GL_STREAM_DRAW);
+		s.measure("buffer.update", "bytes", size, [&] {
+			b.update(data.begin(), data.end());
+		});
+
+		s.measure("buffer.map", "bytes", size, [&] {
+			auto m = b.map(GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+			std::memcpy(m.get_data(), data.data(), size);
+		});
+
+		auto ring = gl::ring_buffer(GL_ARRAY_BUFFER, size, 3);
+		s.measure("ring_buffer.write", "bytes", size, [&] {
+			ring.write(data.begin(), data.end());
+			ring.advance();
+		});
+
+		// Small updates measure the fixed cost of each path.
+		constexpr std::size_t small = 256;
+		auto v = b.make_view(0, small);
+		s.measure("buffer.update_small", "calls", 1, [&] {
+			v.update(data.begin(), data.begin() + small);
+		});
+
+		auto small_ring = gl::ring_buffer(GL_ARRAY_BUFFER, small * 1024, 3);
+		s.measure("ring_buffer.write_small", "calls", 1024, [&] {
+			for (int i = 0; i != 1024; ++i)
+				small_ring.write(data.begin(), data.begin() + small);
+
+			small_ring.advance();
+		});
+	}
+}
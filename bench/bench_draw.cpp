@@ -0,0 +1,76 @@
+#include "bench.hpp"
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/draw_batch.hpp>
+#include <heatsink/gl/framebuffer.hpp>
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/shader.hpp>
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/gl/vertex_array.hpp>
+
+namespace {
+	// The draws are as small as possible, so only submission is measured.
+	constexpr auto g_vertex = R"(
+		#version 430 core
+		void main() {
+			gl_Position = vec4(vec2(gl_VertexID & 1, gl_VertexID >> 1) * 0.01, 0.0, 1.0);
+		}
+	)";
+
+	constexpr auto g_fragment = R"(
+		#version 430 core
+		out vec4 f_color;
+		void main() {
+			f_color = vec4(1.0);
+		}
+	)";
+
+	constexpr int g_draws = 1000;
+}
+
+namespace heatsink::bench {
+	void run_draw(suite& s) {
+		if (!s.is_any_enabled({"draw.arrays", "draw.elements", "draw_batch.submit"}))
+			return;
+
+		// Offscreen windows may not have a usable default framebuffer.
+		auto target = gl::texture::immutable(GL_TEXTURE_2D, GL_RGBA8, glm::uvec2(64));
+		auto fbo = gl::framebuffer();
+		fbo.attach(GL_COLOR_ATTACHMENT0, target);
+		fbo.validate();
+		fbo.use();
+
+		auto vs  = gl::shader(g_vertex, GL_VERTEX_SHADER, "bench_draw");
+		auto fs  = gl::shader(g_fragment, GL_FRAGMENT_SHADER, "bench_draw");
+		auto p   = gl::program({vs, fs}, "bench_draw");
+		auto vao = gl::vertex_array();
+
+		std::vector<GLuint> indices = {0, 1, 2};
+		auto elements = gl::buffer(GL_ELEMENT_ARRAY_BUFFER, indices.begin(), indices.end());
+		vao.set_elements(elements);
+
+		p.use();
+		vao.bind();
+		s.measure("draw.arrays", "draws", g_draws, [&] {
+			for (int i = 0; i != g_draws; ++i)
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+		});
+
+		s.measure("draw.elements", "draws", g_draws, [&] {
+			for (int i = 0; i != g_draws; ++i)
+				glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, nullptr);
+		});
+
+		auto batch = gl::draw_batch();
+		s.measure("draw_batch.submit", "draws", g_draws, [&] {
+			for (int i = 0; i != g_draws; ++i)
+				batch.draw(p, vao, GL_TRIANGLES, GL_UNSIGNED_INT, {3, 1, 0, 0, (GLuint)i});
+
+			batch.submit();
+		});
+	}
+}
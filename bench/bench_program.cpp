@@ -0,0 +1,78 @@
+#include "bench.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/program_cache.hpp>
+#include <heatsink/gl/shader.hpp>
+
+namespace {
+	constexpr auto g_vertex = R"(
+		#version 430 core
+		layout(location = 0) in vec3 a_position;
+		layout(location = 1) in vec3 a_normal;
+		uniform mat4 u_transform;
+		out vec3 v_normal;
+		void main() {
+			v_normal = mat3(u_transform) * a_normal;
+			gl_Position = u_transform * vec4(a_position, 1.0);
+		}
+	)";
+
+	constexpr auto g_fragment = R"(
+		#version 430 core
+		in vec3 v_normal;
+		uniform vec3 u_light;
+		out vec4 f_color;
+		void main() {
+			f_color = vec4(vec3(max(dot(normalize(v_normal), u_light), 0.0)), 1.0);
+		}
+	)";
+}
+
+namespace heatsink::bench {
+	void run_program(suite& s) {
+		if (!s.is_any_enabled({"program.link", "program.from_binary", "program_cache.load"}))
+			return;
+
+		// Drivers may cache compiled shaders themselves; a counter in each
+		// source keeps every link distinct.
+		std::size_t n = 0;
+		auto unique = [&](const char* source) {
+			return std::string(source) + "\n// " + std::to_string(n) + "\n";
+		};
+
+		s.measure_n("program.link", "programs", 1, 20, [&] {
+			auto vs = gl::shader(unique(g_vertex), GL_VERTEX_SHADER, "bench_program");
+			auto fs = gl::shader(unique(g_fragment), GL_FRAGMENT_SHADER, "bench_program");
+			auto p  = gl::program({vs, fs}, "bench_program");
+			++n;
+		});
+
+		auto vs = gl::shader(g_vertex, GL_VERTEX_SHADER, "bench_program");
+		auto fs = gl::shader(g_fragment, GL_FRAGMENT_SHADER, "bench_program");
+		auto binary = gl::program::retrievable({vs, fs}, "bench_program").get_binary();
+		s.measure_n("program.from_binary", "programs", 1, 20, [&] {
+			auto p = gl::program::from_binary(binary, "bench_program");
+		});
+
+		auto directory = std::filesystem::temp_directory_path() / "heatsink_bench_cache";
+		{
+			auto cache   = gl::program_cache(directory);
+			auto stages  = std::vector<GLenum>{GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+			auto sources = std::vector<std::string>{g_vertex, g_fragment};
+
+			// The first load fills the cache; every later one is a hit.
+			cache.load(stages, sources, "bench_program");
+			s.measure_n("program_cache.load", "programs", 1, 20, [&] {
+				auto p = cache.load(stages, sources, "bench_program");
+			});
+
+			cache.clear();
+		}
+
+		std::filesystem::remove_all(directory);
+	}
+}
@@ -0,0 +1,36 @@
+#include "bench.hpp"
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/pixel_format.hpp>
+#include <heatsink/gl/ring_buffer.hpp>
+#include <heatsink/gl/texture.hpp>
+
+namespace heatsink::bench {
+	void run_texture(suite& s) {
+		if (!s.is_any_enabled({"texture.update", "texture.update_pbo"}))
+			return;
+
+		constexpr GLuint side = 1024;
+		constexpr std::size_t size = side * side * 4;
+		std::vector<GLubyte> pixels(size, 0x7f);
+
+		auto t = gl::texture::immutable(GL_TEXTURE_2D, GL_RGBA8, glm::uvec2(side));
+		auto format = gl::pixel_format(GL_RGBA8);
+		s.measure("texture.update", "bytes", size, [&] {
+			t.update(0, pixels.begin(), pixels.end(), format);
+		});
+
+		// Uploads sourced from a pixel unpack buffer are queued on the GPU,
+		// so this mostly measures the copy into the persistent mapping.
+		auto ring = gl::ring_buffer(GL_PIXEL_UNPACK_BUFFER, size, 3);
+		s.measure("texture.update_pbo", "bytes", size, [&] {
+			auto v = ring.write(pixels.begin(), pixels.end());
+			t.update(0, v, format);
+			ring.advance();
+		});
+	}
+}
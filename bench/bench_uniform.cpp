@@ -0,0 +1,70 @@
+#include "bench.hpp"
+
+#include <glm/glm.hpp>
+
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/shader.hpp>
+#include <heatsink/gl/uniform_state.hpp>
+
+namespace {
+	constexpr auto g_vertex = R"(
+		#version 430 core
+		uniform mat4 u_transform;
+		uniform vec4 u_color;
+		out vec4 v_color;
+		void main() {
+			v_color = u_color;
+			gl_Position = u_transform * vec4(0.0, 0.0, 0.0, 1.0);
+		}
+	)";
+
+	constexpr auto g_fragment = R"(
+		#version 430 core
+		in vec4 v_color;
+		out vec4 f_color;
+		void main() {
+			f_color = v_color;
+		}
+	)";
+}
+
+namespace heatsink::bench {
+	void run_uniform(suite& s) {
+		if (!s.is_any_enabled({"uniform.update", "uniform.update_cached", "uniform_state.flush"}))
+			return;
+
+		auto vs = gl::shader(g_vertex, GL_VERTEX_SHADER, "bench_uniform");
+		auto fs = gl::shader(g_fragment, GL_FRAGMENT_SHADER, "bench_uniform");
+		auto p  = gl::program({vs, fs}, "bench_uniform");
+		p.use();
+
+		// Each call looks the uniform up by name, as most callers do.
+		auto color = glm::vec4(1.0f);
+		s.measure("uniform.update", "calls", 1000, [&] {
+			for (int i = 0; i != 1000; ++i) {
+				color.x = (float)i;
+				p["u_color"].update(color);
+			}
+		});
+
+		auto u = p.get_uniform("u_color");
+		s.measure("uniform.update_cached", "calls", 1000, [&] {
+			for (int i = 0; i != 1000; ++i) {
+				color.x = (float)i;
+				u.update(color);
+			}
+		});
+
+		auto state     = gl::uniform_state(p);
+		auto transform = state.find("u_transform");
+		auto tint      = state.find("u_color");
+		s.measure("uniform_state.flush", "calls", 1000, [&] {
+			for (int i = 0; i != 1000; ++i) {
+				color.x = (float)i;
+				state.set(transform, glm::mat4(color.x));
+				state.set(tint, color);
+				state.flush();
+			}
+		});
+	}
+}
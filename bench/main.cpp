@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <heatsink/platform/context.hpp>
+#include <heatsink/platform/window.hpp>
+
+#include "bench.hpp"
+
+namespace {
+	void print_usage(const char* name) {
+		std::cerr
+			<< "usage: " << name << " [--json <path>] [--filter <name>] [--time <ms>]\n"
+			<< "  --json    write the results as JSON to the path (or `-` for stdout)\n"
+			<< "  --filter  only run benchmarks whose name contains the given string\n"
+			<< "  --time    the time spent on each benchmark, in milliseconds\n";
+	}
+}
+
+int main(int argc, char** argv) {
+	std::string json;
+	std::string filter;
+	auto budget = std::chrono::milliseconds(250);
+
+	for (int i = 1; i < argc; ++i) {
+		auto has_value = i + 1 < argc;
+		if (!std::strcmp(argv[i], "--json") && has_value) {
+			json = argv[++i];
+		} else if (!std::strcmp(argv[i], "--filter") && has_value) {
+			filter = argv[++i];
+		} else if (!std::strcmp(argv[i], "--time") && has_value) {
+			budget = std::chrono::milliseconds(std::atoi(argv[++i]));
+		} else {
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Debug contexts validate every call, which would dominate the results.
+	auto ctx = heatsink::context({.major = 4, .minor = 5}, heatsink::context::profile::core, false);
+	auto win = heatsink::window::offscreen(ctx);
+	win.use();
+
+	auto suite = heatsink::bench::suite(budget, filter);
+	heatsink::bench::run_buffer(suite);
+	heatsink::bench::run_texture(suite);
+	heatsink::bench::run_uniform(suite);
+	heatsink::bench::run_program(suite);
+	heatsink::bench::run_draw(suite);
+
+	// The JSON must be the only output on stdout when written there.
+	suite.write_table((json == "-") ? std::cerr : std::cout);
+	if (json == "-") {
+		suite.write_json(std::cout);
+	} else if (!json.empty()) {
+		std::ofstream file(json);
+		suite.write_json(file);
+		if (!file) {
+			std::cerr << "could not write \"" << json << "\"." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -20,4 +20,10 @@ namespace heatsink::gl {
 	 * `GL_LINK_STATUS` of the program is false.
 	 */
 	void write_program_log(std::ostream&, GLuint name, const std::string& from = "");
+	/**
+	 * Format a program pipeline error log and output it to a stream. This
+	 * function should only be called when there is a pipeline error, that is,
+	 * when the `GL_VALIDATE_STATUS` of the pipeline is false.
+	 */
+	void write_pipeline_log(std::ostream&, GLuint name, const std::string& from = "");
 }
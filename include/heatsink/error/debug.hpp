@@ -10,7 +10,8 @@ namespace heatsink {
 	 * Retrieve a stream to write additional error information to. Many heatsink
 	 * exceptions will also to an error stream; this method prepare that stream
 	 * and appends a prefix ("heatsink::namespace") as exceptions do. By
-	 * default, this stream points to `std::cerr`.
+	 * default, this stream points to `std::cerr`; with the `none` diagnostics
+	 * level, it discards everything written to it.
 	 */
 	std::ostream& make_error_stream(const std::string& where);
 
@@ -0,0 +1,42 @@
+#pragma once
+
+// The diagnostics level heatsink was built with; see `diagnostics_level`.
+// This is set by the `HEATSINK_DIAGNOSTICS` CMake option, and must be the
+// same for the library and every translation unit that includes it.
+#if !defined(HEATSINK_DIAGNOSTICS)
+#define HEATSINK_DIAGNOSTICS 2
+#endif
+
+namespace heatsink {
+	/**
+	 * The amount of checking and reporting compiled into heatsink.
+	 * - `none` disables all error messages; `make_error_stream()` discards
+	 *   its output (and does not use `std::cerr`). Exceptions are still
+	 *   thrown for errors outside of hot paths.
+	 * - `errors` keeps error messages and the validation of calls that
+	 *   allocate or create objects, but compiles out the validation of hot
+	 *   paths (`buffer::update()`, `uniform::update()`, etc.). Passing
+	 *   mismatched data to these is then undefined behavior.
+	 * - `validation` checks every call.
+	 *
+	 * With the default `auto` CMake setting, `validation` is used for Debug
+	 * builds and `errors` for every other configuration. If the macro is not
+	 * defined at all, the level is `validation`.
+	 */
+	enum class diagnostics {
+		none       = 0,
+		errors     = 1,
+		validation = 2,
+	};
+
+	/**
+	 * The diagnostics level selected at build time.
+	 */
+	inline constexpr auto diagnostics_level = (diagnostics)HEATSINK_DIAGNOSTICS;
+
+	/**
+	 * Whether hot paths validate their arguments. Checks are written as
+	 * `if constexpr (has_validation)`, so that they have no cost otherwise.
+	 */
+	inline constexpr bool has_validation = (diagnostics_level >= diagnostics::validation);
+}
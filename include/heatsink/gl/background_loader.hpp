@@ -0,0 +1,136 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/fence.hpp>
+#include <heatsink/gl/shader.hpp>
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/platform/window.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Creates OpenGL objects on a worker thread, using a hidden context that
+	 * shares objects with a window. Jobs are run in submission order; each is
+	 * followed by a fence that the worker waits on, so that a job's future
+	 * only becomes ready once the GPU has finished its commands, and its
+	 * results can be used by the render thread right away.
+	 *
+	 * Only objects that are shared between contexts may be created this way:
+	 * buffers, textures, shaders and programs, but not vertex arrays or
+	 * framebuffers. The results should not be used by the render thread until
+	 * their future is ready.
+	 */
+	class background_loader {
+	public:
+		/**
+		 * Create the shared context (with `window::offscreen()`) and start the
+		 * worker thread. This must be called from the thread that owns the
+		 * given window (as required by most windowing systems), which is made
+		 * current again afterwards.
+		 */
+		background_loader(const window&);
+
+		// The worker thread refers to the loader, so it can be neither copied
+		// nor moved.
+		background_loader(const background_loader&) = delete;
+		~background_loader();
+
+		background_loader& operator =(const background_loader&) = delete;
+
+	public:
+		/**
+		 * Queue a function to be run on the worker thread, where the shared
+		 * context is current. Any exception it throws is rethrown by the
+		 * returned future.
+		 */
+		template<class Function>
+		std::future<std::invoke_result_t<Function>> submit(Function&&);
+
+		/**
+		 * Queue the creation of a buffer from a copy of the given data. See
+		 * `buffer::immutable()`.
+		 */
+		template<std::contiguous_iterator Iterator>
+		std::future<buffer> load_buffer(GLenum, Iterator begin, Iterator end, GLbitfield access = 0);
+		/**
+		 * Queue the creation of a texture from a KTX2 or DDS file, with every
+		 * level uploaded. See `texture_file`.
+		 */
+		std::future<texture> load_texture(const std::filesystem::path&);
+		/**
+		 * Queue the compilation of a shader. See `shader::shader()`.
+		 */
+		std::future<shader> load_shader(std::string source, GLenum stage, std::string from = "");
+
+		/**
+		 * Retrieve the number of jobs that have not yet started.
+		 */
+		std::size_t get_pending_count() const;
+
+	private:
+		// Run jobs on the worker thread until the loader is destroyed.
+		void run();
+		// Add a type-erased job to the queue and wake the worker.
+		void enqueue(std::function<void()>);
+
+	private:
+		// The hidden window holding the shared context.
+		window m_window;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::deque<std::function<void()>> m_jobs;
+		bool m_stopping;
+
+		// Started last, once every other member has been initialized.
+		std::thread m_thread;
+	};
+}
+
+namespace heatsink::gl {
+	template<class Function>
+	std::future<std::invoke_result_t<Function>> background_loader::submit(Function&& f) {
+		using result_type = std::invoke_result_t<Function>;
+
+		// `std::function` must be copyable, so the task is held by pointer.
+		auto task = std::make_shared<std::packaged_task<result_type()>>(
+			[f = std::forward<Function>(f)]() mutable -> result_type {
+				if constexpr (std::is_void_v<result_type>) {
+					f();
+					fence().wait();
+				} else {
+					auto result = f();
+					fence().wait();
+					return result;
+				}
+			}
+		);
+
+		auto future = task->get_future();
+		this->enqueue([task] { (*task)(); });
+		return future;
+	}
+
+	template<std::contiguous_iterator Iterator>
+	std::future<buffer> background_loader::load_buffer(GLenum target, Iterator begin, Iterator end, GLbitfield access) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_standard_layout_v<T>);
+
+		return this->submit([target, access, data = std::vector<T>(begin, end)] {
+			return buffer::immutable(target, data.begin(), data.end(), access);
+		});
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * The kinds of access that must observe incoherent writes (from shader
+	 * storage, image stores, or atomic counters) made before a barrier. Each
+	 * value names how the data will be consumed *after* the barrier; use the
+	 * bitwise operators to combine them. See `memory_barrier()`.
+	 */
+	enum class barrier : GLbitfield {
+		vertex_attrib_array  = GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT,
+		element_array        = GL_ELEMENT_ARRAY_BARRIER_BIT,
+		uniform              = GL_UNIFORM_BARRIER_BIT,
+		texture_fetch        = GL_TEXTURE_FETCH_BARRIER_BIT,
+		shader_image_access  = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+		command              = GL_COMMAND_BARRIER_BIT,
+		pixel_buffer         = GL_PIXEL_BUFFER_BARRIER_BIT,
+		texture_update       = GL_TEXTURE_UPDATE_BARRIER_BIT,
+		buffer_update        = GL_BUFFER_UPDATE_BARRIER_BIT,
+		framebuffer          = GL_FRAMEBUFFER_BARRIER_BIT,
+		transform_feedback   = GL_TRANSFORM_FEEDBACK_BARRIER_BIT,
+		atomic_counter       = GL_ATOMIC_COUNTER_BARRIER_BIT,
+		shader_storage       = GL_SHADER_STORAGE_BARRIER_BIT,
+		client_mapped_buffer = GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,
+		query_buffer         = GL_QUERY_BUFFER_BARRIER_BIT,
+
+		all = GL_ALL_BARRIER_BITS
+	};
+
+	/**
+	 * Combine two sets of barrier bits.
+	 */
+	constexpr barrier operator |(barrier, barrier);
+	/**
+	 * Intersect two sets of barrier bits.
+	 */
+	constexpr barrier operator &(barrier, barrier);
+
+	/**
+	 * Order the incoherent memory writes of previous commands before the given
+	 * kinds of access by later commands (`glMemoryBarrier()`). For example, a
+	 * compute dispatch that writes vertex data should be followed by
+	 * `memory_barrier(barrier::vertex_attrib_array)` before drawing with it.
+	 */
+	void memory_barrier(barrier);
+	/**
+	 * Like `memory_barrier()`, but only orders accesses from fragment shaders
+	 * within the same framebuffer region (`glMemoryBarrierByRegion()`). Only
+	 * a subset of the barrier bits are valid; see the OpenGL 4.5 reference.
+	 */
+	void memory_barrier_by_region(barrier);
+}
+
+namespace heatsink::gl {
+	constexpr barrier operator |(barrier a, barrier b) {
+		return static_cast<barrier>(static_cast<GLbitfield>(a) | static_cast<GLbitfield>(b));
+	}
+
+	constexpr barrier operator &(barrier a, barrier b) {
+		return static_cast<barrier>(static_cast<GLbitfield>(a) & static_cast<GLbitfield>(b));
+	}
+}
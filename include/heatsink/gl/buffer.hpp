@@ -1,13 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iterator>
 #include <ostream>
 #include <type_traits>
+#include <vector>
 
 #include <heatsink/error/debug.hpp>
+#include <heatsink/error/diagnostics.hpp>
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/fence.hpp>
+#include <heatsink/gl/memory_tracker.hpp>
 #include <heatsink/gl/object.hpp>
 #include <heatsink/gl/pixel_format.hpp>
 #include <heatsink/platform/gl.hpp>
@@ -15,6 +21,9 @@
 #include <heatsink/traits/memory.hpp>
 
 namespace heatsink::gl {
+	// The result of `buffer::read()`; see `heatsink/gl/readback.hpp`.
+	class readback;
+
 	/**
 	 * A basic OpenGL buffer type. This represents the base functionality common
 	 * across all types (or targets, as referred to in OpenGL documentation).
@@ -122,6 +131,13 @@ namespace heatsink::gl {
 		 */
 		template<std::contiguous_iterator Iterator>
 		void update(Iterator begin, Iterator end);
+		/**
+		 * Copy the contents of another buffer (or view) into this buffer. The
+		 * sizes must be equal, and the ranges may not overlap if both are in
+		 * the same buffer. The copy is performed by the GPU, without reading
+		 * the data back to client memory.
+		 */
+		void copy(const const_view&);
 
 		/**
 		 * Clear the buffer store to the specified value. The format species how
@@ -153,6 +169,29 @@ namespace heatsink::gl {
 		 */
 		template<standard_layout T = GLubyte>
 		mapping<T> map(GLbitfield access);
+		/**
+		 * Create a write-only mapping for streaming, which neither waits for
+		 * pending commands nor preserves the previous contents of the range
+		 * (`GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT`). Writes
+		 * are flushed explicitly; see `mapping::mark_dirty()`. The caller must
+		 * ensure (with fences) that the GPU is no longer reading the range,
+		 * and must write every element that will be read afterwards.
+		 */
+		template<standard_layout T = GLubyte>
+		mapping<T> map_unsynchronized();
+		/**
+		 * Start an asynchronous copy of this buffer into client-mappable
+		 * memory; see `readback` (`heatsink/gl/readback.hpp`). Unlike mapping
+		 * the buffer directly, this does not wait for pending commands.
+		 */
+		readback read() const;
+
+		/**
+		 * Bind the range of this buffer to the given index of its target, for
+		 * targets with indexed bindings (such as `GL_UNIFORM_BUFFER`). For a
+		 * view, only the range it represents is visible through the index.
+		 */
+		void bind_range(std::size_t index) const;
 
 		/**
 		 * Check if a buffer is immutable; that is, created with the
@@ -240,6 +279,15 @@ namespace heatsink::gl {
 		 * to the methods using it to only use the range specified by this view.
 		 */
 		using buffer::bind;
+		/**
+		 * Bind the range represented by this view to an indexed binding point.
+		 * See `buffer::bind_range()`.
+		 */
+		using buffer::bind_range;
+		/**
+		 * Read back the range represented by this view. See `buffer::read()`.
+		 */
+		using buffer::read;
 
 		/**
 		 * A view implements a subset of the `buffer` interface. All methods
@@ -250,6 +298,7 @@ namespace heatsink::gl {
 		using buffer::is_immutable;
 		using buffer::is_empty;
 		
+		using buffer::get;
 		using buffer::get_target;
 		using buffer::get_size;
 	};
@@ -284,12 +333,21 @@ namespace heatsink::gl {
 		 * additional state-changing methods from `buffer`.
 		 */
 		using buffer::update;
+		using buffer::copy;
 		using buffer::clear;
 		using buffer::invalidate;
 
 		using buffer::rebind;
 		using buffer::make_view;
 		using buffer::map;
+		using buffer::map_unsynchronized;
+
+	public:
+		/**
+		 * Allow a mutable view to be passed wherever a constant view of the
+		 * same range is accepted (such as `uniform_block::bind()`).
+		 */
+		operator const_view() const;
 	};
 
 	/**
@@ -341,9 +399,48 @@ namespace heatsink::gl {
 		/**
 		 * Synchronize a data write in client memory with OpenGL/GPU memory. The
 		 * buffer must have been mapped as explicitly flushable, else this
-		 * method will raise an assertion.
+		 * method will raise an assertion. If any range was marked with
+		 * `mark_dirty()` (or `write()`), only the dirty ranges are flushed,
+		 * with one call per disjoint range, and the ranges are then cleared;
+		 * otherwise, the entire mapping is flushed.
+		 */
+		void flush();
+		/**
+		 * Record that a range of the mapping (measured in elements of `T`)
+		 * was written, and must be flushed by the next `flush()`. Overlapping
+		 * and adjacent ranges are merged as they are recorded.
+		 */
+		void mark_dirty(std::size_t first, std::size_t count);
+		/**
+		 * Copy values into the mapping, starting at the given element, and
+		 * mark the written range as dirty.
+		 */
+		void write(std::size_t first, const T&);
+		template<std::contiguous_iterator Iterator>
+		void write(std::size_t first, Iterator begin, Iterator end);
+		/**
+		 * Retrieve the number of disjoint dirty ranges waiting for `flush()`.
 		 */
-		void flush() const;
+		std::size_t get_dirty_count() const;
+
+		/**
+		 * Guard a range of the mapping (measured in elements of `T`) with a new
+		 * fence. This should be called after submitting the commands that read
+		 * from the range, so that later writers can check `would_block()` or
+		 * `wait()` before overwriting the data still in use by the GPU.
+		 */
+		void attach_fence(std::size_t first, std::size_t count);
+		/**
+		 * Check if writing to the given range would have to wait for the GPU;
+		 * that is, if a fence attached to an overlapping range has not yet been
+		 * signaled. This only queries the fences, and never blocks or flushes.
+		 */
+		bool would_block(std::size_t first, std::size_t count) const;
+		/**
+		 * Block until every fence attached to a range overlapping the given
+		 * range has been signaled. Those fences are released afterwards.
+		 */
+		void wait(std::size_t first, std::size_t count);
 
 		/**
 		 * Check if the mapping instance is valid. Separate from the buffer, a
@@ -397,11 +494,50 @@ namespace heatsink::gl {
 		const T* data() const;
 		T* data();
 
+	private:
+		// A range of the mapping guarded by a fence. See `attach_fence()`.
+		struct fenced_range {
+		public:
+			// Check if this range intersects the given range.
+			bool overlaps(std::size_t first, std::size_t count) const;
+
+		public:
+			std::size_t first;
+			std::size_t count;
+			fence sync;
+		};
+
+		// A written range of the mapping, from `first` up to (but not
+		// including) `last`. See `mark_dirty()`.
+		struct dirty_range {
+		public:
+			std::size_t first;
+			std::size_t last;
+		};
+
+		// Check that the given range is within the bounds of the mapping.
+		void validate_range(std::size_t first, std::size_t count) const;
+		// Flush a range of the mapping, measured in bytes.
+		void flush_range(std::size_t offset, std::size_t size) const;
+		// Release the OpenGL mapping, if this instance still holds one.
+		void unmap();
+		// Unbind the buffer after it was bound to be mapped, flushed, or
+		// unmapped, if it is a pixel pack or unpack buffer; those redirect
+		// every later client pixel transfer into the buffer while bound.
+		void release_binding() const;
+
 	private:
 		// The data pointer returned by the OpenGL map.
 		T* m_data;
 		// The access parameters, for checking read/write validity.
 		GLbitfield m_access;
+
+		// The fences attached to ranges of this mapping.
+		std::vector<fenced_range> m_fences;
+		// The disjoint written ranges, sorted by position, and whether any
+		// range has been marked since the mapping was created.
+		std::vector<dirty_range> m_dirty;
+		bool m_tracking;
 	};
 }
 
@@ -438,8 +574,14 @@ namespace heatsink::gl {
 		if (this->is_empty())
 			return;
 
-		this->bind();
-		glBufferData(this->get_target(), (GLsizeiptr)m_size, address_of(*begin), usage);
+		if (has_direct_state_access()) {
+			glNamedBufferData(this->get(), (GLsizeiptr)m_size, address_of(*begin), usage);
+		} else {
+			this->bind();
+			glBufferData(this->get_target(), (GLsizeiptr)m_size, address_of(*begin), usage);
+		}
+
+		memory_tracker::allocate(GL_BUFFER, this->get(), m_size);
 	}
 
 	template<std::contiguous_iterator Iterator>
@@ -448,32 +590,38 @@ namespace heatsink::gl {
 		static_assert(std::is_standard_layout_v<T>);
 
 		assert(this->is_valid());
-		if (auto size = std::distance(begin, end) * sizeof(T); size != m_size) {
-			make_error_stream("gl::buffer")
-				<< "cannot assign data "
-				<< "(size=" << size << ") "
-				<< "to buffer "
-				<< "(size=" << m_size << ")." << std::endl;
-
-			throw exception("gl::buffer", "data size mismatch.");
-		}
-		// The current offset must match the alignment of the datatype.
-		if (m_base % sizeof(T)) {
-			make_error_stream("gl::buffer")
-				<< "buffer view "
-				<< "(offset=" << m_base << ") "
-				<< "is not compatiable with alignment of datatype "
-				<< "(size=" << sizeof(T) << ")." << std::endl;
-
-			throw exception("gl::buffer", "bad buffer view alignment.");
+		if constexpr (has_validation) {
+			if (auto size = std::distance(begin, end) * sizeof(T); size != m_size) {
+				make_error_stream("gl::buffer")
+					<< "cannot assign data "
+					<< "(size=" << size << ") "
+					<< "to buffer "
+					<< "(size=" << m_size << ")." << std::endl;
+
+				throw exception("gl::buffer", "data size mismatch.");
+			}
+			// The current offset must match the alignment of the datatype.
+			if (m_base % sizeof(T)) {
+				make_error_stream("gl::buffer")
+					<< "buffer view "
+					<< "(offset=" << m_base << ") "
+					<< "is not compatiable with alignment of datatype "
+					<< "(size=" << sizeof(T) << ")." << std::endl;
+
+				throw exception("gl::buffer", "bad buffer view alignment.");
+			}
 		}
 
 		// Again, there are no specific rules for updating `0` bytes.
 		if (this->is_empty())
 			return;
 
-		this->bind();
-		glBufferSubData(this->get_target(), m_base, m_size, address_of(*begin));
+		if (has_direct_state_access()) {
+			glNamedBufferSubData(this->get(), m_base, m_size, address_of(*begin));
+		} else {
+			this->bind();
+			glBufferSubData(this->get_target(), m_base, m_size, address_of(*begin));
+		}
 	}
 
 	template<tensor T>
@@ -526,8 +674,12 @@ namespace heatsink::gl {
 		auto pfmt  = format.get();
 		auto ptype = format.get_datatype();
 
-		this->bind();
-		glClearBufferSubData(this->get_target(), ifmt, m_base, m_size, pfmt, ptype, address_of(&t));
+		if (has_direct_state_access()) {
+			glClearNamedBufferSubData(this->get(), ifmt, m_base, m_size, pfmt, ptype, address_of(t));
+		} else {
+			this->bind();
+			glClearBufferSubData(this->get_target(), ifmt, m_base, m_size, pfmt, ptype, address_of(t));
+		}
 	}
 
 	template<standard_layout T>
@@ -536,7 +688,17 @@ namespace heatsink::gl {
 		if (this->is_empty())
 			throw exception("gl::buffer", "cannot map empty buffer.");
 
-		return mapping<T>(*this, access);
+		return mapping<T>(view(*this), access);
+	}
+
+	template<standard_layout T>
+	buffer::mapping<T> buffer::map_unsynchronized() {
+		constexpr GLbitfield access = GL_MAP_WRITE_BIT
+			| GL_MAP_INVALIDATE_RANGE_BIT
+			| GL_MAP_UNSYNCHRONIZED_BIT
+			| GL_MAP_FLUSH_EXPLICIT_BIT;
+
+		return this->map<T>(access);
 	}
 
 	template<bool Const>
@@ -574,28 +736,28 @@ namespace heatsink::gl {
 
 	template<standard_layout T>
 	buffer::mapping<T>::mapping(mapping&& other) noexcept
-	: basic_view(std::move(other)), m_data{other.m_data}, m_access{other.m_access} {
+	: basic_view(std::move(other)), m_data{other.m_data}, m_access{other.m_access}, m_fences{std::move(other.m_fences)},
+	  m_dirty{std::move(other.m_dirty)}, m_tracking{other.m_tracking} {
 		other.m_data = nullptr;
 	}
 
 	template<standard_layout T>
 	buffer::mapping<T>::~mapping() {
-		if (m_data) {
-			this->bind();
-			glUnmapBuffer(this->get_target());
-		}
+		this->unmap();
 	}
 
 	template<standard_layout T>
 	buffer::mapping<T>& buffer::mapping<T>::operator =(mapping&& other) noexcept {
-		basic_view(std::move(other));
-		if (m_data) {
-			this->bind();
-			glUnmapBuffer(this->get_target());
-		}
+		// Release the current mapping before the view is reassigned.
+		this->unmap();
 
+		basic_view::operator =(std::move(other));
 		m_data   = other.m_data;
 		m_access = other.m_access;
+		m_fences = std::move(other.m_fences);
+		m_dirty  = std::move(other.m_dirty);
+
+		m_tracking = other.m_tracking;
 
 		other.m_data = nullptr;
 		return *this;
@@ -603,7 +765,7 @@ namespace heatsink::gl {
 
 	template<standard_layout T>
 	buffer::mapping<T>::mapping(const buffer& other, GLbitfield access, bool readonly)
-	: basic_view<true>(other), m_access{access} {
+	: basic_view<true>(other), m_access{access}, m_tracking{false} {
 		if (!(access & GL_MAP_READ_BIT) && !(access & GL_MAP_WRITE_BIT))
 			throw exception("gl::buffer::mapping", "mapping must be either readable or writable.");
 
@@ -621,8 +783,13 @@ namespace heatsink::gl {
 			throw exception("gl::buffer::mapping", "bad buffer mapping alignment.");
 		}
 
-		this->bind();
-		m_data = glMapBufferRange(this->get_target(), offset, size, access);
+		if (has_direct_state_access()) {
+			m_data = static_cast<T*>(glMapNamedBufferRange(this->get(), offset, size, access));
+		} else {
+			this->bind();
+			m_data = static_cast<T*>(glMapBufferRange(this->get_target(), offset, size, access));
+			this->release_binding();
+		}
 		
 		// This likely occurs because a view of the buffer is already mapped.
 		if (!m_data)
@@ -630,12 +797,106 @@ namespace heatsink::gl {
 	}
 
 	template<standard_layout T>
-	void buffer::mapping<T>::flush() const {
+	void buffer::mapping<T>::flush() {
 		assert(this->is_valid());
+		assert(m_access & GL_MAP_FLUSH_EXPLICIT_BIT);
 
-		this->bind();
 		// Use `basic_view::get_size()`; the mapping `size()` is not in bytes.
-		glFlushMappedBufferRange(this->get_target(), this->get_offset(), basic_view::get_size());
+		if (!m_tracking) {
+			this->flush_range(0, basic_view::get_size());
+			return;
+		}
+
+		for (const auto& r : m_dirty)
+			this->flush_range(r.first * sizeof(T), (r.last - r.first) * sizeof(T));
+
+		m_dirty.clear();
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::mark_dirty(std::size_t first, std::size_t count) {
+		assert(this->is_valid());
+		if constexpr (has_validation)
+			this->validate_range(first, count);
+
+		m_tracking = true;
+		if (count == 0)
+			return;
+
+		auto last = first + count;
+		// Find the first range that could touch the new one (ending at or
+		// after its start), then absorb every range starting before its end.
+		auto it = std::lower_bound(m_dirty.begin(), m_dirty.end(), first, [](const dirty_range& r, std::size_t f) {
+			return r.last < f;
+		});
+
+		auto end = it;
+		for (; end != m_dirty.end() && end->first <= last; ++end) {
+			first = std::min(first, end->first);
+			last  = std::max(last, end->last);
+		}
+
+		if (it == end) {
+			m_dirty.insert(it, dirty_range{first, last});
+		} else {
+			*it = dirty_range{first, last};
+			m_dirty.erase(it + 1, end);
+		}
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::write(std::size_t first, const T& value) {
+		this->write(first, &value, &value + 1);
+	}
+
+	template<standard_layout T>
+	template<std::contiguous_iterator Iterator>
+	void buffer::mapping<T>::write(std::size_t first, Iterator begin, Iterator end) {
+		static_assert(std::is_same_v<typename std::iterator_traits<Iterator>::value_type, T>);
+
+		auto count = (std::size_t)std::distance(begin, end);
+		this->mark_dirty(first, count);
+		std::copy(begin, end, this->get_data() + first);
+	}
+
+	template<standard_layout T>
+	std::size_t buffer::mapping<T>::get_dirty_count() const {
+		return m_dirty.size();
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::attach_fence(std::size_t first, std::size_t count) {
+		assert(this->is_valid());
+		this->validate_range(first, count);
+
+		// Release any fences that have already been signaled, so the list only
+		// ever holds the ranges that are still in flight.
+		std::erase_if(m_fences, [](const fenced_range& r) { return r.sync.is_signaled(); });
+		m_fences.push_back({.first = first, .count = count, .sync = fence()});
+	}
+
+	template<standard_layout T>
+	bool buffer::mapping<T>::would_block(std::size_t first, std::size_t count) const {
+		assert(this->is_valid());
+		this->validate_range(first, count);
+
+		return std::any_of(m_fences.begin(), m_fences.end(), [&](const fenced_range& r) {
+			return r.overlaps(first, count) && !r.sync.is_signaled();
+		});
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::wait(std::size_t first, std::size_t count) {
+		assert(this->is_valid());
+		this->validate_range(first, count);
+
+		std::erase_if(m_fences, [&](const fenced_range& r) {
+			if (!r.overlaps(first, count))
+				return false;
+
+			r.sync.wait();
+			return true;
+		});
 	}
 
 	template<standard_layout T>
@@ -658,7 +919,7 @@ namespace heatsink::gl {
 		if (!(m_access & GL_MAP_READ_BIT))
 			throw exception("gl::buffer::maping", "mapping is not readable.");
 		
-		return m_data;
+		return (m_data + this->get_size());
 	}
 
 	template<standard_layout T>
@@ -717,4 +978,55 @@ namespace heatsink::gl {
 	T* buffer::mapping<T>::data() {
 		return this->get_data();
 	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::validate_range(std::size_t first, std::size_t count) const {
+		if (first + count > this->get_size()) {
+			make_error_stream("gl::buffer::mapping")
+				<< "range "
+				<< "(first=" << first << ", count=" << count << ") "
+				<< "is out of bounds of mapping "
+				<< "(size=" << this->get_size() << ")." << std::endl;
+
+			throw exception("gl::buffer::mapping", "mapping range out of bounds.");
+		}
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::flush_range(std::size_t offset, std::size_t size) const {
+		// Note that the flushed range is relative to the start of the mapping.
+		if (has_direct_state_access()) {
+			glFlushMappedNamedBufferRange(this->get(), (GLintptr)offset, (GLsizeiptr)size);
+		} else {
+			this->bind();
+			glFlushMappedBufferRange(this->get_target(), (GLintptr)offset, (GLsizeiptr)size);
+			this->release_binding();
+		}
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::unmap() {
+		if (!m_data)
+			return;
+
+		if (has_direct_state_access()) {
+			glUnmapNamedBuffer(this->get());
+		} else {
+			this->bind();
+			glUnmapBuffer(this->get_target());
+			this->release_binding();
+		}
+	}
+
+	template<standard_layout T>
+	void buffer::mapping<T>::release_binding() const {
+		auto t = this->get_target();
+		if (t == GL_PIXEL_PACK_BUFFER || t == GL_PIXEL_UNPACK_BUFFER)
+			name_traits<GL_BUFFER>::bind(0, t);
+	}
+
+	template<standard_layout T>
+	bool buffer::mapping<T>::fenced_range::overlaps(std::size_t f, std::size_t c) const {
+		return (f < first + count) && (first < f + c);
+	}
 }
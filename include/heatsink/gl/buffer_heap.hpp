@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Sub-allocates ranges of a few large immutable buffers, so that many
+	 * meshes can share the same vertex and index buffers (which is required
+	 * to batch them with `draw_batch`). Each pool keeps its free ranges
+	 * ordered by both offset, to merge neighbours when a range is freed, and
+	 * by size, to find the smallest range that fits an allocation.
+	 *
+	 * Allocations are identified by handle rather than by view, since
+	 * `defragment()` may move them; views and offsets must be retrieved again
+	 * after a defragmentation pass has moved any data.
+	 */
+	class buffer_heap {
+	public:
+		/**
+		 * The identifier of an allocation within a heap.
+		 */
+		using handle = std::size_t;
+
+		/**
+		 * A summary of the memory usage of a heap. The fragmentation is the
+		 * fraction of free memory outside of the largest free range, from `0`
+		 * (all free memory is contiguous) up to `1`.
+		 */
+		struct statistics {
+		public:
+			std::size_t pool_count;
+			std::size_t allocation_count;
+
+			std::size_t capacity;
+			std::size_t used_size;
+			std::size_t largest_free_size;
+
+			float occupancy;
+			float fragmentation;
+		};
+
+	public:
+		/**
+		 * Create a heap whose buffers have the given target and size. Pools are
+		 * created (with `GL_DYNAMIC_STORAGE_BIT`, so that views can be updated)
+		 * as they are needed; none exist until the first allocation.
+		 */
+		buffer_heap(GLenum target, std::size_t pool_size);
+
+	public:
+		/**
+		 * Allocate a range of the given size, with an offset that is a
+		 * multiple of the given alignment. The alignment does not need to be a
+		 * power of two; for vertex data, the vertex stride can be used so that
+		 * the offset converts exactly to a base vertex. The size is padded to
+		 * a multiple of the alignment, as `buffer::mapping` requires. An
+		 * exception is thrown if the size exceeds the pool size.
+		 */
+		handle allocate(std::size_t size, std::size_t alignment = 1);
+		/**
+		 * Return the range of an allocation to its pool.
+		 */
+		void free(handle);
+
+		/**
+		 * Compact each pool by moving allocations towards its start, copying
+		 * their data on the GPU. At most the given number of bytes are moved,
+		 * so that the work can be spread over several frames. Returns the
+		 * number of bytes actually moved.
+		 */
+		std::size_t defragment(std::size_t budget = std::numeric_limits<std::size_t>::max());
+
+		/**
+		 * Create a view of the range of an allocation.
+		 */
+		buffer::view make_view(handle);
+		buffer::const_view make_view(handle) const;
+		/**
+		 * Retrieve the buffer containing an allocation, which is shared with
+		 * every other allocation in the same pool.
+		 */
+		const buffer& get_buffer(handle) const;
+		/**
+		 * Retrieve the offset (in bytes) of an allocation within its buffer.
+		 */
+		std::size_t get_offset(handle) const;
+		/**
+		 * Retrieve the (padded) size of an allocation in bytes.
+		 */
+		std::size_t get_size(handle) const;
+
+		/**
+		 * Compute the current usage and fragmentation of the heap.
+		 */
+		statistics get_statistics() const;
+
+	private:
+		// The location of a live allocation.
+		struct allocation {
+		public:
+			std::size_t pool;
+			std::size_t offset;
+			std::size_t size;
+			std::size_t alignment;
+		};
+
+		// A single buffer, with its free ranges and allocations.
+		struct pool {
+		public:
+			buffer storage;
+
+			// Free ranges, by offset (to size) and by size (to offset).
+			std::map<std::size_t, std::size_t> ranges;
+			std::multimap<std::size_t, std::size_t> sizes;
+			// Allocations by offset, used to compact the pool.
+			std::map<std::size_t, handle> allocations;
+		};
+
+	private:
+		// Try to allocate within a pool; returns `false` if no range fits.
+		bool allocate(std::size_t pool, handle, std::size_t size, std::size_t alignment);
+
+		// Add a free range to a pool, merging it with its neighbours.
+		void insert_range(pool&, std::size_t offset, std::size_t size);
+		// Remove a free range (by its offset) from a pool.
+		void erase_range(pool&, std::size_t offset);
+		// Rebuild the free ranges of a pool from its allocations.
+		void rebuild_ranges(pool&);
+
+		// Copy the contents of an allocation to a lower offset in its pool.
+		void move(pool&, allocation&, std::size_t offset);
+
+	private:
+		GLenum m_target;
+		std::size_t m_pool_size;
+
+		std::vector<pool> m_pools;
+		std::unordered_map<handle, allocation> m_allocations;
+		handle m_next;
+	};
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <heatsink/gl/program.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A set of programs being compiled and linked in the background. Builds
+	 * are submitted with `submit_files()`, which returns immediately with a ticket;
+	 * `poll()` then finishes (and introspects) every program the driver has
+	 * completed, so it can be called once per frame while a loading screen
+	 * keeps rendering. This relies on `GL_KHR_parallel_shader_compile`; on
+	 * contexts without it, builds still work, but `poll()` blocks.
+	 */
+	class build_queue {
+	public:
+		/**
+		 * The identifier of a submitted build, used to retrieve the program.
+		 */
+		using ticket = std::size_t;
+
+	public:
+		/**
+		 * Create an empty queue. If the context supports parallel compilation,
+		 * the number of driver compiler threads is set to the given count
+		 * (`glMaxShaderCompilerThreadsKHR()`); this is shared by the whole
+		 * context. A count of zero lets the implementation decide.
+		 */
+		build_queue(std::size_t threads = 0);
+
+		// A queue owns its pending programs, so it can only be moved.
+		build_queue(const build_queue&) = delete;
+		build_queue(build_queue&&) = default;
+
+		build_queue& operator =(const build_queue&) = delete;
+		build_queue& operator =(build_queue&&) = default;
+
+	public:
+		/**
+		 * Submit a program built from a set of shader file paths; see
+		 * `program::from_files()` for the naming requirements. The sources are
+		 * read and submitted to the driver immediately, but compile and link
+		 * errors are only reported by `take()`.
+		 */
+		ticket submit_files(const std::vector<std::filesystem::path>&);
+		/**
+		 * Submit a program built from a set of existing shaders, which may be
+		 * `shader::deferred()`. See `submit_files()`; the shaders may be
+		 * destroyed as soon as this returns.
+		 */
+		ticket submit(const std::vector<program::shader_name>&, const std::string& from = "");
+
+		/**
+		 * Finish every build the driver has completed, without blocking (when
+		 * parallel compilation is available). Returns the number of builds
+		 * that are still in progress.
+		 */
+		std::size_t poll();
+		/**
+		 * Block until every submitted build has finished.
+		 */
+		void wait();
+
+		/**
+		 * Check if the given build has finished (successfully or not), such
+		 * that `take()` will not block.
+		 */
+		bool is_ready(ticket) const;
+		/**
+		 * Remove a build from the queue and return its program, blocking if it
+		 * has not yet finished. If the build failed, its exception is thrown
+		 * here instead. The ticket cannot be used again afterwards.
+		 */
+		program take(ticket);
+
+		/**
+		 * Retrieve the number of builds that have not yet finished.
+		 */
+		std::size_t get_pending_count() const;
+
+	private:
+		// A submitted program and its build result.
+		struct entry {
+		public:
+			program result;
+			// Whether `program::finish()` has been called.
+			bool finished;
+			// The exception thrown while finishing, if the build failed.
+			std::exception_ptr error;
+		};
+
+	private:
+		// Finish the given build, capturing any exception it throws.
+		static void finish(entry&);
+
+	private:
+		// The builds that have not yet been taken, by ticket.
+		std::map<ticket, entry> m_entries;
+		// The ticket to be returned by the next `submit()`.
+		ticket m_next;
+	};
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/uniform_state.hpp>
+#include <heatsink/gl/vertex_array.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A list of recorded rendering commands, replayed later on the thread
+	 * that owns the context. Recording never calls into OpenGL, so separate
+	 * buffers may be filled concurrently by worker threads (see
+	 * `thread_pool`), then executed in order on the GL thread. Commands and
+	 * their data are appended to a single linear arena that keeps its
+	 * capacity across `reset()`, so steady-state recording does not allocate.
+	 *
+	 * Programs, vertex arrays, uniform stores and buffers are referenced, not
+	 * copied, so they must remain valid until the buffer has been executed.
+	 * A single buffer must not be recorded into by several threads at once.
+	 */
+	class command_buffer {
+	public:
+		/**
+		 * Create an empty buffer, with the given sort key. See `execute()`.
+		 */
+		command_buffer(std::uint64_t key = 0);
+
+	public:
+		/**
+		 * Record a change to the program used by subsequent draws.
+		 */
+		void use_program(const program&);
+		/**
+		 * Record a change to the vertex array used by subsequent draws.
+		 */
+		void bind_vertex_array(const vertex_array&);
+
+		/**
+		 * Record a uniform value; the value is copied into the arena, and set
+		 * on the store at replay. Every store set by a buffer is flushed
+		 * before each of its subsequent draws.
+		 */
+		template<tensor T> requires (std::is_array_v<T> == false && std::is_trivially_copyable_v<T>)
+		void set_uniform(uniform_state&, uniform_state::handle, const T&);
+
+		/**
+		 * Record an update of the entire range of a buffer view. The data is
+		 * copied into the arena, so the range may be reused right away.
+		 */
+		template<std::contiguous_iterator Iterator>
+		void update_buffer(const buffer::view&, Iterator begin, Iterator end);
+
+		/**
+		 * Record a non-indexed draw of the vertex array in use.
+		 */
+		void draw_arrays(GLenum mode, GLint first, GLsizei count, GLsizei instances = 1);
+		/**
+		 * Record an indexed draw of the vertex array in use, starting at the
+		 * given index (not byte offset) of its element buffer.
+		 */
+		void draw_elements(GLenum mode, GLenum type, GLsizei count, std::size_t first = 0, GLint base_vertex = 0, GLsizei instances = 1);
+
+		/**
+		 * Discard every recorded command, keeping the allocated memory.
+		 */
+		void reset();
+		/**
+		 * Issue every recorded command, in order, on the current context. The
+		 * buffer is not reset, so it may be executed again.
+		 */
+		void execute() const;
+
+		/**
+		 * Retrieve the key that orders this buffer in `execute()`.
+		 */
+		std::uint64_t get_key() const;
+		/**
+		 * Set the key that orders this buffer in `execute()`.
+		 */
+		void set_key(std::uint64_t);
+		/**
+		 * Retrieve the number of recorded commands.
+		 */
+		std::size_t get_command_count() const;
+		/**
+		 * Retrieve the number of bytes of the arena in use.
+		 */
+		std::size_t get_size() const;
+
+	public:
+		/**
+		 * Execute a set of buffers in order of their keys; buffers with equal
+		 * keys are executed in the order given. This allows work recorded out
+		 * of order (such as per-worker buffers) to be replayed
+		 * deterministically, for example by pass or by material.
+		 */
+		static void execute(const std::vector<const command_buffer*>&);
+
+	private:
+		// The kinds of recorded commands.
+		enum class opcode : std::uint32_t {
+			use_program,
+			bind_vertex_array,
+			set_uniform,
+			update_buffer,
+			draw_arrays,
+			draw_elements,
+		};
+
+		// The header preceding each command in the arena. The payload (of
+		// `size` bytes, padded to the alignment of the header) follows it.
+		struct header {
+		public:
+			opcode op;
+			std::uint32_t size;
+		};
+
+		// Applies a recorded uniform value to its store.
+		using uniform_setter = void (*)(uniform_state&, uniform_state::handle, const std::byte*);
+
+		// The payload of `set_uniform`, followed by the value.
+		struct uniform_command {
+		public:
+			uniform_state* state;
+			uniform_state::handle handle;
+			uniform_setter setter;
+		};
+
+		// The payload of `update_buffer`, followed by the data.
+		struct update_command {
+		public:
+			std::size_t view;
+			std::size_t size;
+		};
+
+		// The payload of `draw_arrays` and `draw_elements`.
+		struct draw_command {
+		public:
+			GLenum mode;
+			GLenum type;
+			GLsizei count;
+			GLsizei instances;
+			GLint first;
+			GLint base_vertex;
+			std::size_t offset;
+		};
+
+	private:
+		// Append a command with the given payload size to the arena, and
+		// return a pointer to the payload.
+		std::byte* push(opcode, std::size_t size);
+		// Append a command with a trivially copyable payload, followed by
+		// `extra` bytes of data (which the caller fills in).
+		template<typename T>
+		std::byte* push(opcode, const T&, std::size_t extra = 0);
+
+	private:
+		std::uint64_t m_key;
+		std::vector<std::byte> m_arena;
+		std::size_t m_commands;
+		// Views are not trivially copyable, so they are kept out of the arena
+		// and referenced by index.
+		std::vector<buffer::view> m_views;
+	};
+}
+
+namespace heatsink::gl {
+	template<tensor T> requires (std::is_array_v<T> == false && std::is_trivially_copyable_v<T>)
+	void command_buffer::set_uniform(uniform_state& state, uniform_state::handle handle, const T& value) {
+		uniform_setter setter = [](uniform_state& s, uniform_state::handle h, const std::byte* data) {
+			T v;
+			std::memcpy(&v, data, sizeof(T));
+			s.set(h, v);
+		};
+
+		auto* data = this->push(opcode::set_uniform, uniform_command{&state, handle, setter}, sizeof(T));
+		std::memcpy(data, &value, sizeof(T));
+	}
+
+	template<std::contiguous_iterator Iterator>
+	void command_buffer::update_buffer(const buffer::view& v, Iterator begin, Iterator end) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		auto size = (std::size_t)std::distance(begin, end) * sizeof(T);
+		auto* data = this->push(opcode::update_buffer, update_command{m_views.size(), size}, size);
+		if (size != 0)
+			std::memcpy(data, std::to_address(begin), size);
+
+		m_views.push_back(v);
+	}
+
+	template<typename T>
+	std::byte* command_buffer::push(opcode op, const T& payload, std::size_t extra) {
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		auto* data = this->push(op, sizeof(T) + extra);
+		std::memcpy(data, &payload, sizeof(T));
+		return data + sizeof(T);
+	}
+}
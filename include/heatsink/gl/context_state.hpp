@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include <heatsink/platform/context.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Information about a created OpenGL context that is needed while issuing
+	 * commands, rather than while creating the context itself. Each `window`
+	 * holds one for its context, and makes it current in `window::use()`. This
+	 * lets objects choose between code paths (such as direct state access)
+	 * without querying OpenGL on every call. The state also shadows the object
+	 * bindings of the context, so redundant `glBind*()` calls can be skipped.
+	 */
+	class context_state {
+	public:
+		/**
+		 * The number of binds checked against the binding shadow. A hit is a
+		 * bind that was skipped because the name was already bound; a miss is
+		 * a bind that had to be passed on to OpenGL.
+		 */
+		struct binding_statistics {
+		public:
+			std::size_t hits;
+			std::size_t misses;
+		};
+
+	public:
+		/**
+		 * Retrieve the state of the context current on the calling thread. If
+		 * no state has been made current (for example, if the context was not
+		 * created through a `window`), a state is created for the calling
+		 * thread from whatever OpenGL context is current.
+		 */
+		static context_state& get_current();
+		/**
+		 * Set the state used by `get_current()` on the calling thread. Passing
+		 * `nullptr` reverts to the per-thread fallback state.
+		 */
+		static void set_current(context_state*);
+
+	public:
+		/**
+		 * Create the state for the currently active OpenGL context. The context
+		 * must be current on the calling thread, as its version is queried.
+		 */
+		context_state();
+
+		// The state is referred to by address from `get_current()`, so it can
+		// be neither copied nor moved.
+		context_state(const context_state&) = delete;
+		~context_state();
+
+		context_state& operator =(const context_state&) = delete;
+
+	public:
+		/**
+		 * Retrieve the version of the OpenGL context, as reported by the
+		 * implementation (not as requested during creation).
+		 */
+		context::version get_version() const;
+
+		/**
+		 * Check if the context supports OpenGL 4.5 direct state access. When
+		 * true, objects are created with `glCreate*()` and modified by name
+		 * instead of being bound first.
+		 */
+		bool has_direct_state_access() const;
+		/**
+		 * Check if the context supports `GL_KHR_parallel_shader_compile` (or
+		 * the equivalent ARB extension). When true, shaders and programs can
+		 * be polled for completion without blocking; see `shader::deferred()`.
+		 */
+		bool has_parallel_shader_compile() const;
+		/**
+		 * Check if the context supports `GL_ARB_bindless_texture`. When true,
+		 * textures can be made resident and sampled through 64-bit handles
+		 * instead of texture units; see `texture::get_handle()`.
+		 */
+		bool has_bindless_texture() const;
+		/**
+		 * Check if the context supports OpenGL 4.6 (or
+		 * `GL_ARB_indirect_parameters`). When true, indirect draws can read
+		 * their draw count from a buffer; see `draw_batch::draw_indirect()`.
+		 */
+		bool has_indirect_parameters() const;
+
+		/**
+		 * Check if the context supports OpenGL 4.1 separate shader objects (or
+		 * `GL_ARB_separate_shader_objects`). When true, uniforms are updated
+		 * by program with `glProgramUniform*()`; otherwise, the program is
+		 * used and `glUniform*()` is called instead.
+		 */
+		bool has_separate_shader_objects() const;
+		/**
+		 * Retrieve the maximum number of work groups of a compute dispatch in
+		 * each dimension (`GL_MAX_COMPUTE_WORK_GROUP_COUNT`). This is zero if
+		 * the context does not support compute shaders.
+		 */
+		glm::uvec3 get_max_work_group_count() const;
+
+		/**
+		 * Record that the given name of an object type is being bound to a
+		 * target and unit (use `0` for types without units). Returns `false`
+		 * if the name is already bound, in which case the `glBind*()` call can
+		 * be skipped; this is used by `name_traits<>::bind()`.
+		 */
+		bool set_binding(GLenum type, GLenum target, std::size_t unit, GLuint name);
+		/**
+		 * Forget the binding of a single target and unit; the next bind to it
+		 * always reaches OpenGL. This is needed when a binding changes as a
+		 * side effect, like the element buffer when a vertex array is bound.
+		 */
+		void invalidate_binding(GLenum type, GLenum target, std::size_t unit = 0);
+		/**
+		 * Forget every shadowed binding and pixel storage parameter. This must
+		 * be called if OpenGL binding state is changed outside of heatsink
+		 * (for example, by another library or by calling `glBind*()` directly).
+		 */
+		void invalidate_bindings();
+		/**
+		 * Reset every binding of the given name to `0`, as OpenGL does when a
+		 * bound object is deleted from the current context. This is used by
+		 * `name_traits<>::destroy()`.
+		 */
+		void release_name(GLenum type, GLuint name);
+
+		/**
+		 * Set a pixel storage parameter (such as `GL_UNPACK_ALIGNMENT`),
+		 * returning its previous value. The parameters are shadowed like
+		 * bindings, so `glPixelStorei()` is only called when a value changes.
+		 * See `pixel_store_scope`.
+		 */
+		GLint set_pixel_store(GLenum pname, GLint value);
+
+		/**
+		 * Record that the bindless handle of the given texture name is being
+		 * made resident. Returns `false` if it is already resident, in which
+		 * case the `glMakeTextureHandleResidentARB()` call can be skipped.
+		 * Residency is per context, like bindings.
+		 */
+		bool set_resident(GLuint name, GLuint64 handle);
+		/**
+		 * Forget the residency of the given texture name, returning the handle
+		 * that must be made non-resident (or `0` if it was not resident). This
+		 * is also used by `name_traits<GL_TEXTURE>::destroy()`, so that no
+		 * handle outlives its texture.
+		 */
+		GLuint64 clear_resident(GLuint name);
+		/**
+		 * Check if the bindless handle of the given texture name is resident.
+		 */
+		bool is_resident(GLuint name) const;
+
+		/**
+		 * Retrieve the number of binds skipped (hits) and passed on to OpenGL
+		 * (misses) since construction or the last reset.
+		 */
+		binding_statistics get_binding_statistics() const;
+		/**
+		 * Reset the hit and miss counters to zero. The shadowed bindings are
+		 * not affected.
+		 */
+		void reset_binding_statistics();
+
+	private:
+		// The version queried from the context during construction.
+		context::version m_version;
+		// Whether the parallel shader compile extension is available.
+		bool m_parallel_compile;
+		// Whether the bindless texture extension is available.
+		bool m_bindless;
+		// Whether indirect draw counts can be sourced from a buffer.
+		bool m_indirect_parameters;
+		// Whether uniforms can be updated without using their program.
+		bool m_separate_shader_objects;
+		// The dispatch limits, queried once as they are used on every dispatch.
+		glm::uvec3 m_max_work_group_count;
+
+		// The name bound to each object type/target/unit combination, packed
+		// into a single key. A missing entry means the binding is unknown.
+		std::unordered_map<std::uint64_t, GLuint> m_bindings;
+		// The value of each pixel storage parameter set (or queried) so far.
+		std::unordered_map<GLenum, GLint> m_pixel_store;
+		// The counters returned by `get_binding_statistics()`.
+		binding_statistics m_statistics;
+		// The resident bindless handle of each texture name.
+		std::unordered_map<GLuint, GLuint64> m_resident;
+	};
+
+	/**
+	 * Sets a pixel storage parameter of the current context for the lifetime
+	 * of this object, and restores its previous value afterwards. For example,
+	 * tightly packed rows are transferred with an alignment of `1`.
+	 */
+	class pixel_store_scope {
+	public:
+		pixel_store_scope(GLenum pname, GLint value);
+
+		// The value must be restored exactly once, so it cannot be copied.
+		pixel_store_scope(const pixel_store_scope&) = delete;
+		~pixel_store_scope();
+
+		pixel_store_scope& operator =(const pixel_store_scope&) = delete;
+
+	private:
+		GLenum m_pname;
+		GLint m_previous;
+	};
+
+	/**
+	 * Check if the current context supports direct state access. Equivalent to
+	 * `context_state::get_current().has_direct_state_access()`.
+	 */
+	bool has_direct_state_access();
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A bounded queue of OpenGL debug messages, filled by the debug callback
+	 * and drained by the application (usually once per frame, as done by
+	 * `window::flush_buffers()`). This allows `GL_DEBUG_OUTPUT` to be used
+	 * without `GL_DEBUG_OUTPUT_SYNCHRONOUS`, which serializes the driver; the
+	 * callback may then be invoked from any driver thread, at any time.
+	 *
+	 * Pushing is lock-free and never allocates or blocks; messages are
+	 * dropped (and counted) when the queue is full, and truncated to
+	 * `max_length` characters. Only one thread may drain the queue at once.
+	 */
+	class debug_queue {
+	public:
+		/**
+		 * A single message, as passed to the debug callback.
+		 */
+		struct message {
+		public:
+			GLenum source;
+			GLenum type;
+			GLuint id;
+			GLenum severity;
+			std::string text;
+		};
+
+		/**
+		 * The longest message text that is kept; longer messages are cut.
+		 */
+		static constexpr std::size_t max_length = 512;
+
+	public:
+		/**
+		 * Create a queue that holds at least the given number of messages
+		 * between drains. The capacity is rounded up to a power of two.
+		 */
+		explicit debug_queue(std::size_t capacity = 256);
+
+		// The callback refers to the queue by address, so it cannot be moved.
+		debug_queue(const debug_queue&) = delete;
+		debug_queue& operator =(const debug_queue&) = delete;
+
+	public:
+		/**
+		 * A `GLDEBUGPROC` that pushes each message into the queue passed as
+		 * its user parameter.
+		 */
+		static void GLAPIENTRY callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* text, const void* queue);
+
+		/**
+		 * Install this queue as the debug message callback of the current
+		 * context, enabling `GL_DEBUG_OUTPUT` and disabling
+		 * `GL_DEBUG_OUTPUT_SYNCHRONOUS`. The queue must outlive the context,
+		 * or be uninstalled before it is destroyed.
+		 */
+		void install();
+
+		/**
+		 * Add a message to the queue. This may be called from any thread.
+		 * Returns `false` if the queue is full, and the message was dropped.
+		 */
+		bool push(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* text);
+		/**
+		 * Remove every queued message, in the order they were pushed, passing
+		 * each to the given function. Returns the number of messages popped.
+		 */
+		std::size_t drain(const std::function<void(const message&)>&);
+
+		/**
+		 * Retrieve the number of messages dropped because the queue was
+		 * full, and reset the count.
+		 */
+		std::size_t take_dropped();
+		/**
+		 * Retrieve the number of messages the queue can hold.
+		 */
+		std::size_t get_capacity() const;
+
+	private:
+		// A queued message. The sequence number tells producers and the
+		// consumer whether the slot is free or filled for their position.
+		struct slot {
+		public:
+			std::atomic<std::size_t> sequence;
+			GLenum source;
+			GLenum type;
+			GLuint id;
+			GLenum severity;
+			std::size_t length;
+			GLchar text[max_length];
+		};
+
+	private:
+		std::unique_ptr<slot[]> m_slots;
+		std::size_t m_mask;
+
+		// The next position to push to, shared by every producer, and the
+		// next position to pop from, owned by the consumer. These are kept on
+		// separate cache lines so that producers do not contend with draining.
+		alignas(64) std::atomic<std::size_t> m_head;
+		alignas(64) std::size_t m_tail;
+
+		// The number of messages dropped since the last `take_dropped()`.
+		std::atomic<std::size_t> m_dropped;
+	};
+}
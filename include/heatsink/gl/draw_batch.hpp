@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/vertex_array.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Collects indexed draws and submits them with as few commands as
+	 * possible. Each draw is recorded with its program, vertex array and an
+	 * arbitrary state key (for example, identifying the textures it samples).
+	 * On `submit()`, the draws are sorted by these and written to a
+	 * `GL_DRAW_INDIRECT_BUFFER`, and each run of draws sharing the same state
+	 * is issued with a single `glMultiDrawElementsIndirect()`. This requires
+	 * OpenGL 4.3.
+	 *
+	 * Draws within a run share a vertex array, so meshes should be packed
+	 * into shared vertex and index buffers and selected by the command's
+	 * first index and base vertex. Per-draw data can be fetched in shaders
+	 * through the base instance (or `gl_DrawID`, on OpenGL 4.6).
+	 */
+	class draw_batch {
+	public:
+		/**
+		 * The parameters of a single indexed draw, laid out as expected by
+		 * the indirect draw commands (`DrawElementsIndirectCommand`).
+		 */
+		struct command {
+		public:
+			GLuint count;
+			GLuint instance_count;
+			GLuint first_index;
+			GLint base_vertex;
+			GLuint base_instance;
+		};
+
+	public:
+		/**
+		 * Create an empty batch. The indirect buffer is allocated on the first
+		 * call to `submit()`, and grows as needed.
+		 */
+		draw_batch();
+
+	public:
+		/**
+		 * Record an indexed draw of the given primitive mode and index type.
+		 * The program and vertex array are referenced, not copied, so they
+		 * must remain valid until the next `submit()` or `clear()`.
+		 */
+		void draw(const program&, const vertex_array&, GLenum mode, GLenum type, const command&, std::uint64_t state = 0);
+
+		/**
+		 * Sort and issue every recorded draw, then clear the batch. The given
+		 * function is called whenever the state key changes between runs, and
+		 * before the first one, to bind the corresponding resources.
+		 */
+		void submit(const std::function<void(std::uint64_t)>& apply = nullptr);
+		/**
+		 * Discard every recorded draw without issuing it.
+		 */
+		void clear();
+
+		/**
+		 * Retrieve the number of draws currently recorded.
+		 */
+		std::size_t get_draw_count() const;
+		/**
+		 * Retrieve the number of multi-draw commands issued by the last call
+		 * to `submit()`.
+		 */
+		std::size_t get_submit_count() const;
+		/**
+		 * Retrieve the indirect buffer, which holds the sorted commands of the
+		 * last call to `submit()`.
+		 */
+		const buffer& get_buffer() const;
+
+	public:
+		/**
+		 * Issue the commands of an indirect buffer, reading the number of
+		 * draws (as a `GLuint`, up to the given maximum) from a
+		 * `GL_PARAMETER_BUFFER` view. This allows the commands and their
+		 * count to be generated on the GPU, such as by a culling pass. The
+		 * program and vertex array must already be in use. An exception is
+		 * thrown if the context does not support indirect parameters.
+		 */
+		static void draw_indirect(GLenum mode, GLenum type, const buffer::const_view& commands, const buffer::const_view& count, std::size_t max);
+
+	private:
+		// A recorded draw and the state it must be issued with.
+		struct record {
+		public:
+			const program* shader;
+			const vertex_array* vao;
+			std::uint64_t state;
+			GLenum mode;
+			GLenum type;
+
+			command cmd;
+		};
+
+	private:
+		std::vector<record> m_records;
+		// The commands of every record, in sorted order.
+		std::vector<command> m_commands;
+		buffer m_buffer;
+		std::size_t m_submits;
+	};
+}
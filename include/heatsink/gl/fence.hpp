@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL sync object, created with `glFenceSync()`. A fence is signaled
+	 * once the GPU has completed all commands submitted before it, which makes
+	 * it possible to tell when resources (such as a `buffer::view` or
+	 * `texture::view`) are no longer being read. This class has the same
+	 * semantics as `object` in terms of lifetime, but does not actually extend
+	 * it as sync objects are not named with a `GLuint`.
+	 */
+	class fence {
+	public:
+		/**
+		 * The duration type used for timed waits. OpenGL measures timeouts in
+		 * nanoseconds.
+		 */
+		using duration = std::chrono::nanoseconds;
+
+	public:
+		/**
+		 * Create an invalid instance of a fence. `is_valid()` is guaranteed to
+		 * be `false` for an instance returned from this function. This is
+		 * useful for containers of fences where not every slot is in use.
+		 */
+		static fence null();
+
+	public:
+		/**
+		 * Insert a new fence into the OpenGL command stream. The fence will be
+		 * signaled once all previously submitted commands have completed.
+		 */
+		fence();
+
+		// Like `object`, fences can only be moved.
+		fence(const fence&) = delete;
+		fence(fence&&) noexcept;
+		~fence();
+
+		fence& operator =(const fence&) = delete;
+		fence& operator =(fence&&) noexcept;
+
+	private:
+		// Create an invalid instance of a fence (a proxy for `null()`).
+		fence(std::nullptr_t);
+
+	public:
+		/**
+		 * Check if the GPU has signaled the fence. This only queries the sync
+		 * status and never flushes or blocks, so it is cheap enough to call
+		 * before every write to decide whether a wait would stall.
+		 */
+		bool is_signaled() const;
+
+		/**
+		 * Block the calling thread until the fence is signaled or the timeout
+		 * expires. The wait spins briefly first, as most fences are signaled
+		 * shortly after they are first waited on, before letting the driver
+		 * put the thread to sleep for the remainder of the timeout. Returns
+		 * `false` if the timeout expired before the fence was signaled.
+		 */
+		bool wait(duration timeout = duration::max()) const;
+		/**
+		 * Make the GPU wait for the fence before executing any commands
+		 * submitted after this call (`glWaitSync()`). This does not block the
+		 * calling thread; it is mostly useful between shared contexts.
+		 */
+		void wait_gpu() const;
+
+		/**
+		 * Check if the fence instance is valid. A fence should be valid unless
+		 * it was created with `null()` or has been moved from. Calling any
+		 * member functions on an invalid fence is undefined behavior, although
+		 * it is likely to raise an assertion.
+		 */
+		bool is_valid() const;
+
+		/**
+		 * Retrieve the OpenGL sync handle for this fence. Use with caution; the
+		 * handle is still managed by the instance.
+		 */
+		GLsync get() const;
+
+	private:
+		// The OpenGL sync handle. Invalid when set to `nullptr`.
+		GLsync m_sync;
+	};
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include <heatsink/gl/fence.hpp>
+#include <heatsink/gl/query.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Limits the number of frames the CPU may run ahead of the GPU, and
+	 * measures the time of each frame on both. A fence is inserted after each
+	 * swap; before the next frame starts, the pacer waits until fewer than
+	 * `get_max_frames_in_flight()` frames are still being processed. Lower
+	 * limits reduce input latency (input is sampled closer to when the frame
+	 * is displayed) at the cost of throughput, as the CPU and GPU overlap
+	 * less; a limit of `1` fully serializes them.
+	 *
+	 * The pacer is driven by `window::flush_buffers(frame_pacer&)`, which
+	 * calls `end_frame()` before the swap and `begin_frame()` after it. GPU
+	 * times are measured with timestamp queries, read back once the fence of
+	 * their frame has been signaled, so they lag behind the CPU times.
+	 */
+	class frame_pacer {
+	public:
+		/**
+		 * The duration type of every measurement.
+		 */
+		using duration = std::chrono::nanoseconds;
+
+		/**
+		 * The timings of the most recent frames. The averages and maximum are
+		 * taken over the most recent frames, up to the window of the pacer.
+		 */
+		struct statistics {
+		public:
+			// The time between the last two swaps.
+			duration frame_time;
+			// The time from the start of the last frame to its swap.
+			duration cpu_time;
+			// The GPU time of the most recent frame with a result.
+			duration gpu_time;
+			// The time spent blocked on the frame limit before the last frame.
+			duration wait_time;
+
+			duration average_frame_time;
+			duration average_gpu_time;
+			// A measure of jitter; large differences between the maximum and
+			// the average show uneven pacing.
+			duration max_frame_time;
+
+			// The number of frames completed, and currently in flight.
+			std::size_t frames;
+			std::size_t in_flight;
+		};
+
+	public:
+		/**
+		 * Create a pacer allowing the given number of frames in flight (or no
+		 * limit, if `0`), keeping statistics over the given number of frames.
+		 */
+		frame_pacer(std::size_t max_frames_in_flight = 2, std::size_t window = 60);
+
+		// The pacer owns its fences and queries, so it can only be moved.
+		frame_pacer(const frame_pacer&) = delete;
+		frame_pacer(frame_pacer&&) = default;
+
+		frame_pacer& operator =(const frame_pacer&) = delete;
+		frame_pacer& operator =(frame_pacer&&) = default;
+
+	public:
+		/**
+		 * Start a frame, right after the previous frame was swapped. This
+		 * fences the previous frame, collects the timings of completed frames,
+		 * and blocks while too many frames are in flight.
+		 */
+		void begin_frame();
+		/**
+		 * Finish a frame, right before it is swapped.
+		 */
+		void end_frame();
+
+		/**
+		 * Change the maximum number of frames in flight. `0` removes the
+		 * limit, leaving pacing to the driver.
+		 */
+		void set_max_frames_in_flight(std::size_t);
+		std::size_t get_max_frames_in_flight() const;
+
+		/**
+		 * Retrieve the timings of the most recent frames.
+		 */
+		statistics get_statistics() const;
+
+	private:
+		// A frame and the timestamps recorded at its start and end. The fence
+		// is inserted once the frame is swapped (it is null until then).
+		struct frame {
+		public:
+			fence sync;
+			query begin;
+			query end;
+		};
+
+		// Read the timings of every signaled frame, and recycle its queries.
+		void collect();
+		// Retrieve a recycled (or new) timestamp query.
+		query acquire();
+
+	private:
+		std::size_t m_max_in_flight;
+		std::size_t m_window;
+
+		// The frame currently being recorded, and the frames in flight
+		// (oldest first).
+		frame m_current;
+		std::deque<frame> m_frames;
+		// Whether the current frame was begun, and ended.
+		bool m_begun;
+		bool m_ended;
+		// Queries whose results have been read, and can be recorded again.
+		std::vector<query> m_free;
+
+		std::chrono::steady_clock::time_point m_start;
+		std::chrono::steady_clock::time_point m_swap;
+
+		statistics m_statistics;
+		// The most recent frame and GPU times, up to the window size.
+		std::deque<duration> m_frame_times;
+		std::deque<duration> m_gpu_times;
+	};
+}
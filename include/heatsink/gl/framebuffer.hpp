@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <heatsink/gl/object.hpp>
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL framebuffer object. Attachments are specified as a mip level
+	 * of a texture or texture view; a view covering a single layer (or face)
+	 * of a layered texture attaches only that layer. Multisample attachments
+	 * are resolved into another framebuffer with `resolve()`, and attachments
+	 * whose contents are no longer needed (such as a depth buffer after the
+	 * last pass reading it) should be discarded with `discard()`, so that
+	 * tiled GPUs can skip writing them back to memory.
+	 */
+	class framebuffer : public object<GL_FRAMEBUFFER> {
+	public:
+		/**
+		 * Create an instance referring to the default framebuffer (of the
+		 * current window), with the given size. This is valid as the
+		 * destination of `resolve()`, and for `discard()` and `clear()`.
+		 */
+		static framebuffer default_framebuffer(glm::uvec2);
+
+	public:
+		/**
+		 * Create a new framebuffer with no attachments. The target is the
+		 * binding used by `bind()`; `GL_FRAMEBUFFER` binds for both drawing
+		 * and reading.
+		 */
+		framebuffer(GLenum target = GL_FRAMEBUFFER);
+
+	private:
+		// Create an instance of the default framebuffer with the given size.
+		framebuffer(std::nullptr_t, glm::uvec2);
+
+	public:
+		/**
+		 * Attach the given mip level of a texture (or view) to an attachment
+		 * point, such as `GL_COLOR_ATTACHMENT0` or `GL_DEPTH_ATTACHMENT`. The
+		 * view must cover the full extent of the level; only its layers may be
+		 * a subset, and only if it covers exactly one layer.
+		 */
+		void attach(GLenum attachment, const texture::const_view&, std::size_t mip = 0);
+		/**
+		 * Remove the texture attached to an attachment point (if any).
+		 */
+		void detach(GLenum attachment);
+		/**
+		 * Set the color attachments written by fragment shader outputs. By
+		 * default, only `GL_COLOR_ATTACHMENT0` is written.
+		 */
+		void set_draw_buffers(const std::vector<GLenum>&);
+
+		/**
+		 * Check if the framebuffer is complete; that is, it can be rendered to.
+		 * An exception is thrown describing the reason otherwise.
+		 */
+		void validate() const;
+
+		/**
+		 * Copy the contents of this framebuffer into another, resolving
+		 * multisample attachments (`glBlitFramebuffer()`). The color buffer
+		 * read is `GL_COLOR_ATTACHMENT0`, written to the destination's draw
+		 * buffers. Depth and stencil buffers can only be copied with
+		 * `GL_NEAREST` filtering, and between buffers of equal size.
+		 */
+		void resolve(framebuffer&, GLbitfield mask = GL_COLOR_BUFFER_BIT, GLenum filter = GL_NEAREST) const;
+		/**
+		 * Mark the contents of the given attachments as undefined
+		 * (`glInvalidateFramebuffer()`). For the default framebuffer, use
+		 * `GL_COLOR`, `GL_DEPTH` and `GL_STENCIL` instead.
+		 */
+		void discard(const std::vector<GLenum>& attachments);
+
+		/**
+		 * Clear a single draw buffer (by index into the draw buffers) to the
+		 * given color.
+		 */
+		void clear(std::size_t drawbuffer, const glm::vec4&);
+		/**
+		 * Clear the depth and stencil buffers to the given values.
+		 */
+		void clear(float depth, GLint stencil = 0);
+
+		/**
+		 * Bind the framebuffer and set the viewport to cover it entirely.
+		 */
+		void use() const;
+
+		/**
+		 * Retrieve the size of the renderable area; the smallest size of all
+		 * attachments (or the size given for the default framebuffer).
+		 */
+		glm::uvec2 get_extents() const;
+
+	private:
+		// Recalculate `m_extents` from the attachments.
+		void update_extents();
+
+	private:
+		// The size of each attachment, at the attached level.
+		std::map<GLenum, glm::uvec2> m_attachments;
+		glm::uvec2 m_extents;
+	};
+}
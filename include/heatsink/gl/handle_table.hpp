@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A table of bindless texture handles, stored in a buffer so that shaders
+	 * can index it (for example, by a material index from a multi-draw). The
+	 * table is edited on the CPU, and the changed range is uploaded by
+	 * `flush()`. Textures are made resident when they are inserted; they stay
+	 * resident until they are destroyed (or made non-resident explicitly), as
+	 * a texture may be referenced by more than one table.
+	 *
+	 * In GLSL, a storage buffer table is declared as `sampler2D textures[]`
+	 * (with `ARB_bindless_texture`), or as `uvec2` pairs. As uniform blocks
+	 * use `std140` arrays, each handle in a `GL_UNIFORM_BUFFER` table takes
+	 * 16 bytes instead of 8.
+	 */
+	class handle_table {
+	public:
+		/**
+		 * Create an empty table with room for the given number of handles
+		 * before the buffer must grow. The target is the buffer binding shaders
+		 * read it from: `GL_SHADER_STORAGE_BUFFER` or `GL_UNIFORM_BUFFER`.
+		 */
+		handle_table(GLenum target = GL_SHADER_STORAGE_BUFFER, std::size_t capacity = 256);
+
+	public:
+		/**
+		 * Make the texture resident and add its handle to the table, returning
+		 * the index it can be accessed at. Indices of erased handles are reused.
+		 */
+		std::size_t insert(texture&);
+		/**
+		 * Replace the handle at the given index with that of another texture.
+		 */
+		void assign(std::size_t, texture&);
+		/**
+		 * Remove the handle at the given index (it is set to zero). The texture
+		 * is not made non-resident. Erasing an index that is already free has
+		 * no effect.
+		 */
+		void erase(std::size_t);
+
+		/**
+		 * Upload every change made since the last flush. If the table grew, the
+		 * buffer is reallocated, which invalidates previous views of it.
+		 */
+		void flush();
+		/**
+		 * Bind the table to the given index of its target. This does not flush.
+		 */
+		void bind(std::size_t index) const;
+
+		/**
+		 * Retrieve the handle at the given index (which may be zero).
+		 */
+		GLuint64 get_handle(std::size_t) const;
+		/**
+		 * Retrieve the number of indices in use (including erased indices that
+		 * have not been reused yet).
+		 */
+		std::size_t get_size() const;
+		/**
+		 * Retrieve the buffer backing the table.
+		 */
+		const buffer& get_buffer() const;
+
+	private:
+		// Write a handle to the CPU copy of the table and mark it as changed.
+		void write(std::size_t, GLuint64);
+
+	private:
+		// The table as it is laid out in the buffer; each handle takes up
+		// `m_stride` elements (the remainder being padding).
+		std::vector<GLuint64> m_data;
+		std::size_t m_stride;
+		std::size_t m_size;
+		// Erased indices, available for reuse.
+		std::vector<std::size_t> m_free;
+
+		// The range of indices changed since the last flush.
+		std::size_t m_dirty_begin;
+		std::size_t m_dirty_end;
+
+		buffer m_buffer;
+	};
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/attribute.hpp>
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/ring_buffer.hpp>
+#include <heatsink/gl/vertex_array.hpp>
+#include <heatsink/gl/vertex_format.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An indexed mesh drawn many times per call, with a second vertex stream
+	 * that advances once per instance. Per-vertex attributes read from one
+	 * vertex buffer binding point, and per-instance attributes (declared as
+	 * members of an instance structure, through `vertex_format`) from
+	 * another with a divisor of `1`. Instance data is usually streamed
+	 * through a `ring_buffer`; the ring is bound once, and each draw selects
+	 * its instances with a base instance instead of rebinding.
+	 *
+	 * This requires OpenGL 4.3 (see `vertex_array::set_attribute_format()`).
+	 */
+	class instanced_mesh {
+	public:
+		/**
+		 * Create a mesh with no attributes, where each instance is the given
+		 * number of bytes (usually `sizeof(Instance)`).
+		 */
+		instanced_mesh(std::size_t instance_stride);
+
+	public:
+		/**
+		 * Set the format of a per-vertex attribute. The format may be inferred
+		 * from a member of the vertex structure (such as `&vertex::position`).
+		 */
+		void set_vertex_attribute(const attribute&, vertex_format);
+		/**
+		 * Set the format of a per-vertex attribute, specifying the conversion
+		 * type. See `vertex_array::set_attribute()`.
+		 */
+		void set_vertex_attribute(const attribute&, vertex_format, vertex_array::conversion);
+		/**
+		 * Set the format of a per-instance attribute. The packing stride of
+		 * the format must equal the instance stride of the mesh.
+		 */
+		void set_instance_attribute(const attribute&, vertex_format);
+		/**
+		 * Set the format of a per-instance attribute, specifying the
+		 * conversion type. See the above overload.
+		 */
+		void set_instance_attribute(const attribute&, vertex_format, vertex_array::conversion);
+
+		/**
+		 * Attach the per-vertex data of the mesh.
+		 */
+		void set_vertices(buffer::const_view, std::size_t stride);
+		/**
+		 * Attach the index buffer of the mesh, holding indices of the given
+		 * type. Every index in the buffer is drawn by `draw()`.
+		 */
+		void set_elements(const buffer&, GLenum type);
+
+		/**
+		 * Write the range of instances into the ring buffer, and draw the
+		 * mesh once for each of them. The ring buffer must be targeted at
+		 * `GL_ARRAY_BUFFER`, and the value type must be the instance stride
+		 * in size.
+		 */
+		template<std::contiguous_iterator Iterator>
+		void draw(ring_buffer&, Iterator begin, Iterator end, GLenum mode = GL_TRIANGLES);
+		/**
+		 * Draw the mesh once for each instance in a view of the given number
+		 * of instances. The view must be aligned to the instance stride.
+		 */
+		void draw(const buffer::const_view& instances, std::size_t count, GLenum mode = GL_TRIANGLES);
+
+		/**
+		 * Retrieve the number of bytes per instance.
+		 */
+		std::size_t get_instance_stride() const;
+		/**
+		 * Retrieve the underlying vertex array.
+		 */
+		const vertex_array& get_vertex_array() const;
+
+	private:
+		// The binding points of the per-vertex and per-instance streams.
+		static constexpr std::size_t vertex_binding   = 0;
+		static constexpr std::size_t instance_binding = 1;
+
+	private:
+		// Bind a buffer to the instance stream, unless it is already bound,
+		// then issue the draw with the given base instance.
+		void draw(const buffer::const_view& instances, std::size_t base, std::size_t count, GLenum mode);
+		// Raise an exception if a per-instance format has the wrong stride.
+		void validate_instance_format(const vertex_format&) const;
+
+	private:
+		vertex_array m_vao;
+		std::size_t m_instance_stride;
+
+		// The type and number of indices in the element buffer.
+		GLenum m_index_type;
+		std::size_t m_index_count;
+
+		// The buffer (and offset) currently bound to the instance stream, so
+		// that consecutive draws from a ring buffer do not rebind it.
+		GLuint m_instances;
+		std::size_t m_instances_offset;
+	};
+}
+
+namespace heatsink::gl {
+	template<std::contiguous_iterator Iterator>
+	void instanced_mesh::draw(ring_buffer& ring, Iterator begin, Iterator end, GLenum mode) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		if (sizeof(T) != m_instance_stride)
+			throw exception("gl::instanced_mesh", "instance size mismatch.");
+
+		auto count = (std::size_t)std::distance(begin, end);
+		if (count == 0)
+			return;
+
+		// The ring aligns writes to the value size, which is the stride, so
+		// the offset of the view is always a whole number of instances.
+		auto v = ring.write(begin, end);
+		assert(v.get_offset() % m_instance_stride == 0);
+
+		this->draw(buffer::const_view(ring.get_buffer()), v.get_offset() / m_instance_stride, count, mode);
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A global account of the device memory allocated through `buffer` and
+	 * `texture` storage. Each allocation is recorded under its object type and
+	 * name when storage is (re)allocated, and released in
+	 * `name_traits<>::destroy()`. Allocations are grouped by the label given
+	 * with `object<>::set_label()`, so that a snapshot shows which subsystem
+	 * owns what memory.
+	 *
+	 * The sizes are those requested by the application (texture sizes are
+	 * derived from `format_traits`, the extents, and the mip levels); drivers
+	 * pad and align storage, so the device may report more memory in use.
+	 * Sparse textures are recorded as empty, as their commitment varies. The
+	 * tracker is shared by every context and thread; names are assumed to be
+	 * unique, which only holds for contexts that share objects.
+	 */
+	class memory_tracker {
+	public:
+		/**
+		 * The amount of memory recorded for a category of allocations.
+		 */
+		struct usage {
+		public:
+			// The number of bytes currently allocated.
+			std::size_t bytes;
+			// The number of objects with an allocation.
+			std::size_t count;
+			// The largest value of `bytes` since the last `reset_peak()`.
+			std::size_t peak;
+		};
+
+		/**
+		 * The state of every recorded allocation at a point in time.
+		 */
+		struct snapshot {
+		public:
+			// The totals of all buffers and all textures.
+			usage buffers;
+			usage textures;
+			// The total of every allocation, regardless of type.
+			usage total;
+			// The totals per object label. Unlabeled objects are under "".
+			std::map<std::string, usage> labels;
+			// The budget set with `set_budget()`, or `0` if there is none.
+			std::size_t budget;
+		};
+
+		/**
+		 * The memory available to the device, as reported by the driver
+		 * through `GL_NVX_gpu_memory_info` or `GL_ATI_meminfo`. Values the
+		 * driver does not report are `0`.
+		 */
+		struct device_memory {
+		public:
+			// Whether either extension is supported by the current context.
+			bool is_available;
+			// The total dedicated video memory (NVX only).
+			std::size_t total;
+			// The dedicated video memory currently available.
+			std::size_t available;
+			// The number of evictions, and the total bytes evicted, since the
+			// process started (NVX only). An increase means the device is
+			// oversubscribed.
+			std::size_t evictions;
+			std::size_t evicted;
+		};
+
+	public:
+		// The tracker only has global state.
+		memory_tracker() = delete;
+
+	public:
+		/**
+		 * Record that an object now holds the given number of bytes. A
+		 * previous allocation of the same object is replaced.
+		 */
+		static void allocate(GLenum type, GLuint name, std::size_t bytes);
+		/**
+		 * Forget the allocation of an object, if any. This is used by
+		 * `name_traits<>::destroy()`.
+		 */
+		static void release(GLenum type, GLuint name);
+
+		/**
+		 * Label an object, both for the tracker and (when `GL_KHR_debug` or
+		 * OpenGL 4.3 is available) for debuggers, with `glObjectLabel()`. Only
+		 * the labels of buffers and textures are recorded, and kept until the
+		 * object is released. See `object<>::set_label()`.
+		 */
+		static void set_label(GLenum type, GLuint name, const std::string&);
+		/**
+		 * Retrieve the label of an object, or an empty string if it has none.
+		 */
+		static std::string get_label(GLenum type, GLuint name);
+
+		/**
+		 * Retrieve the current totals of every recorded allocation.
+		 */
+		static snapshot get_snapshot();
+		/**
+		 * Retrieve the number of bytes currently recorded, and the high-water
+		 * mark of that value.
+		 */
+		static std::size_t get_total();
+		static std::size_t get_peak();
+		/**
+		 * Restart every high-water mark from the current totals, for example
+		 * to measure the peak of a single level or frame.
+		 */
+		static void reset_peak();
+
+		/**
+		 * Set the number of bytes the application intends to stay within, or
+		 * `0` for no budget. An error is logged to the debug stream once each
+		 * time an allocation crosses the budget; allocations are not refused.
+		 */
+		static void set_budget(std::size_t);
+		/**
+		 * Check if the recorded total is larger than the budget.
+		 */
+		static bool is_over_budget();
+
+		/**
+		 * Query the driver for the memory available to the current context.
+		 * This is independent of any recorded allocation.
+		 */
+		static device_memory query_device();
+	};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/gl/texture_file.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Streams the mip chains of large textures in over several frames. A
+	 * streamed texture starts with only its smallest levels resident, and is
+	 * clamped to them with `texture::set_level_range()` so that it can be
+	 * sampled immediately. The remaining levels are uploaded from least to
+	 * most detailed during `advance()`, up to a fixed number of bytes per
+	 * frame, and the clamp is lowered as each level completes. This spreads
+	 * the upload cost of startup (and of loading new assets) over time.
+	 */
+	class mip_streamer {
+	public:
+		/**
+		 * Create a streamer that uploads up to the given number of bytes per
+		 * call to `advance()`. At least one image is always uploaded per call
+		 * while any are pending, even if it is larger than the budget.
+		 */
+		mip_streamer(std::size_t budget);
+
+	public:
+		/**
+		 * Start streaming a texture file into the given texture, which must
+		 * have been created (with `texture::immutable()`, but no data) with the
+		 * target, format, extents and mip count of the file. It must not be
+		 * moved or destroyed
+		 * until it is resident (or `cancel()` is called). The given number of
+		 * the smallest levels are uploaded immediately.
+		 */
+		void stream(texture&, texture_file, std::size_t resident = 1);
+		/**
+		 * Stop streaming into the given texture. The levels already uploaded
+		 * remain resident and in use.
+		 */
+		void cancel(const texture&);
+
+		/**
+		 * Upload pending levels up to the budget. This should be called once
+		 * per frame.
+		 */
+		void advance();
+
+		/**
+		 * Check if every level of the given texture has been uploaded. This is
+		 * `true` for any texture not being streamed.
+		 */
+		bool is_resident(const texture&) const;
+		/**
+		 * Retrieve the number of bytes still waiting to be uploaded.
+		 */
+		std::size_t get_pending_size() const;
+		/**
+		 * Retrieve the number of bytes uploaded per call to `advance()`.
+		 */
+		std::size_t get_budget() const;
+
+	private:
+		// A texture being streamed. The images are uploaded in order from the
+		// front of `pending`, which is sorted from the smallest level up.
+		struct entry {
+		public:
+			texture* target;
+			texture_file file;
+
+			std::vector<texture_file::image> pending;
+			std::size_t next;
+		};
+
+	private:
+		// Upload the next image of an entry, lowering the level clamp if that
+		// completes its level. Returns the number of bytes uploaded.
+		std::size_t upload_next(entry&);
+
+	private:
+		std::size_t m_budget;
+		// Textures with images left to upload, serviced round-robin.
+		std::vector<entry> m_entries;
+		std::size_t m_cursor;
+	};
+}
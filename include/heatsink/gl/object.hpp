@@ -2,7 +2,10 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <string>
+#include <utility>
 
+#include <heatsink/gl/memory_tracker.hpp>
 #include <heatsink/platform/gl.hpp>
 #include <heatsink/traits/name.hpp>
 
@@ -27,7 +30,8 @@ namespace heatsink::gl {
 	public:
 		/**
 		 * Create a new OpenGL object. This calls the appropriate `glGen*()`
-		 * method for the templatize object type. Some objects may take no
+		 * method for the templatize object type, or `glCreate*()` when the
+		 * context supports direct state access. Some objects may take no
 		 * arguments, while others will take a bind target enumeration.
 		 */
 		explicit object()
@@ -40,7 +44,6 @@ namespace heatsink::gl {
 		object(object&&) noexcept;
 		~object();
 
-		object& operator =(const object&) = delete;
 		object& operator =(object&&) noexcept;
 
 	protected:
@@ -55,6 +58,7 @@ namespace heatsink::gl {
 		// Allow an object to be copied internally. This is usefully for `view`-
 		// like classes used in some object types.
 		object(const object&) = default;
+		object& operator =(const object&) = default;
 
 	public:
 		/**
@@ -87,6 +91,19 @@ namespace heatsink::gl {
 		GLenum get_target() const
 			requires (name::has_target == true);
 
+		/**
+		 * Give the object a human-readable label; it appears in debuggers
+		 * and debug messages (through `glObjectLabel()`), and groups the
+		 * memory of buffers and textures in `memory_tracker`. Labels are
+		 * shared between views of the same object.
+		 */
+		void set_label(const std::string&);
+		/**
+		 * Retrieve the label given with `set_label()`, or an empty string.
+		 * Only buffer and texture labels are recorded.
+		 */
+		std::string get_label() const;
+
 	protected:
 		// Permanently change the bind target of this object. This also performs
 		// the same functions as `bind()` after the target is changed.
@@ -135,7 +152,7 @@ namespace heatsink::gl {
 
 	template<GLenum V>
 	object<V>::object(GLenum target) requires (name::has_target == true)
-	: detail::object_target_mixin<V>(), m_name{name::create()} {
+	: detail::object_target_mixin<V>(), m_name{name::create(target)} {
 		// Set the target after the object has been created so it is left in
 		// the correct state in case of an exception.
 		detail::object_target_mixin<V>::set_target(target);
@@ -158,7 +175,7 @@ namespace heatsink::gl {
 		if (m_name)
 			name::destroy(m_name);
 
-		detail::object_target_mixin::operator =(std::move(other));
+		detail::object_target_mixin<V>::operator =(std::move(other));
 		m_name = other.m_name;
 
 		other.reset();
@@ -215,6 +232,18 @@ namespace heatsink::gl {
 		return detail::object_target_mixin<V>::get_target();
 	}
 
+	template<GLenum V>
+	void object<V>::set_label(const std::string& label) {
+		assert(this->is_valid());
+		memory_tracker::set_label(V, m_name, label);
+	}
+
+	template<GLenum V>
+	std::string object<V>::get_label() const {
+		assert(this->is_valid());
+		return memory_tracker::get_label(V, m_name);
+	}
+
 	template<GLenum V>
 	void object<V>::rebind(GLenum target) requires (name::has_target == true) {
 		assert(this->is_valid());
@@ -222,7 +251,7 @@ namespace heatsink::gl {
 		detail::object_target_mixin<V>::set_target(target);
 		// An object that will be rebound normally should not have a bind unit,
 		// but check to ensure correct syntax.
-		if constexpr (name::has_bind_unit)
+		if constexpr (name::has_image_unit)
 			this->bind(0u);
 		else
 			this->bind();
@@ -232,7 +261,8 @@ namespace heatsink::gl {
 	void object<V>::reset() {
 		m_name = 0;
 		// Reset the target to ensure the object is left in an invalid state.
-		detail::object_target_mixin<V>::set_target(GL_NONE);
+		if constexpr (name::has_target)
+			detail::object_target_mixin<V>::set_target(GL_NONE);
 	}
 
 	template<GLenum V>
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+#include <heatsink/gl/query.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * The latest occlusion results of a set of objects, identified by a key
+	 * chosen by the application (such as an entity ID). Each frame, an
+	 * object's proxy (usually its bounding box, drawn without color or depth
+	 * writes) is drawn between `begin()` and `end()`; the query results are
+	 * collected by `advance()` once they are available, never waiting on the
+	 * GPU. Results therefore lag by a frame or more:
+	 *
+	 * - `is_visible()` gives the latest known result for CPU-side culling. An
+	 *   object is treated as visible until a result is known, or once its
+	 *   latest result is older than the latency the cache was created with.
+	 * - `conditional()` renders on the GPU conditionally on the most recent
+	 *   query, so that hidden objects are skipped without any readback.
+	 *
+	 * Hidden objects must keep being tested, or they will never be found to be
+	 * visible again.
+	 */
+	class occlusion_cache {
+	public:
+		/**
+		 * Identifies an object of the application.
+		 */
+		using key = std::uint64_t;
+
+		/**
+		 * An active occlusion test; the test ends when this is destroyed. See
+		 * `occlusion_cache::test()`.
+		 */
+		class scope;
+
+	public:
+		/**
+		 * Create a cache of the given query target (`GL_ANY_SAMPLES_PASSED`,
+		 * `GL_ANY_SAMPLES_PASSED_CONSERVATIVE`, or `GL_SAMPLES_PASSED`, which
+		 * also counts the samples). Results are trusted for the given number
+		 * of frames after the test was issued.
+		 */
+		occlusion_cache(GLenum target = GL_ANY_SAMPLES_PASSED, std::size_t latency = 3);
+
+		// The cache owns its queries, so it can only be moved.
+		occlusion_cache(const occlusion_cache&) = delete;
+		occlusion_cache(occlusion_cache&&) = default;
+
+		occlusion_cache& operator =(const occlusion_cache&) = delete;
+		occlusion_cache& operator =(occlusion_cache&&) = default;
+
+	public:
+		/**
+		 * Begin the occlusion test of an object. Only one test may be active at
+		 * a time, and no other query of the same target may be active.
+		 */
+		void begin(key);
+		/**
+		 * End the active occlusion test.
+		 */
+		void end();
+		/**
+		 * Begin a test that is ended automatically when the result goes out of
+		 * scope. See `begin()`.
+		 */
+		[[nodiscard]] scope test(key);
+
+		/**
+		 * Finish the current frame, collecting the results of every query that
+		 * has become available (without blocking), and recycling the queries
+		 * that are no longer needed.
+		 */
+		void advance();
+
+		/**
+		 * Check if an object was visible in its latest known result. This is
+		 * `true` if there is no result yet, or if it is out of date.
+		 */
+		bool is_visible(key) const;
+		/**
+		 * Retrieve the number of samples that passed in the latest known
+		 * result (`1` or `0` for the `ANY_SAMPLES` targets), if any.
+		 */
+		std::uint64_t get_samples(key) const;
+		/**
+		 * Retrieve the most recently issued query of an object, or `nullptr` if
+		 * it has never been tested.
+		 */
+		const query* get_query(key) const;
+		/**
+		 * Begin conditional rendering on the most recent query of an object.
+		 * If the object has never been tested, draws are always performed.
+		 * See `conditional_render`.
+		 */
+		[[nodiscard]] conditional_render conditional(key, GLenum mode = GL_QUERY_NO_WAIT) const;
+
+		/**
+		 * Forget an object, releasing its queries.
+		 */
+		void erase(key);
+		/**
+		 * Forget every object. No test may be active.
+		 */
+		void clear();
+
+		/**
+		 * Retrieve the number of objects with results or pending queries.
+		 */
+		std::size_t get_size() const;
+		/**
+		 * Retrieve the number of queries that have been issued, but whose
+		 * results have not been collected yet.
+		 */
+		std::size_t get_pending_count() const;
+
+	private:
+		// A query issued for an object, and the frame it was issued during.
+		struct issued {
+		public:
+			query test;
+			std::size_t frame;
+			bool collected;
+		};
+
+		// The queries and latest result of an object.
+		struct entry {
+		public:
+			// The issued queries, oldest first. The newest is kept after it
+			// is collected, as it is used for conditional rendering.
+			std::vector<issued> queries;
+
+			bool known;
+			std::uint64_t samples;
+			// The frame the query of the latest result was issued during.
+			std::size_t frame;
+		};
+
+	private:
+		// Retrieve a recycled (or new) query.
+		query acquire();
+
+	private:
+		GLenum m_target;
+		std::size_t m_latency;
+		std::size_t m_frame;
+
+		std::unordered_map<key, entry> m_entries;
+		// Queries whose results were collected, and can be reissued.
+		std::vector<query> m_free;
+
+		// The object whose test is active, if any.
+		entry* m_active;
+	};
+
+	/**
+	 * See forward declaration in `occlusion_cache`.
+	 */
+	class occlusion_cache::scope {
+	public:
+		/**
+		 * Begin the test of an object; see `occlusion_cache::begin()`.
+		 */
+		scope(occlusion_cache&, key);
+
+		// A test must end exactly once, so it cannot be copied or moved.
+		scope(const scope&) = delete;
+		~scope();
+
+		scope& operator =(const scope&) = delete;
+
+	private:
+		// The cache to end the test with.
+		occlusion_cache& m_cache;
+	};
+}
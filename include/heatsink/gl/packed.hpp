@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/enum.hpp>
+#include <heatsink/traits/memory.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A 16-bit IEEE half-precision float (`GL_HALF_FLOAT`), stored as its raw
+	 * bits. Use `encode()` to convert from full-width floats. Like the other
+	 * scalar types, this may be used in arrays (such as `half uv[2]`) to
+	 * infer a `vertex_format`.
+	 */
+	struct half {
+	public:
+		GLhalf bits;
+	};
+
+	/**
+	 * Four signed, normalized components packed into 32 bits (10 bits each
+	 * for x, y and z, and 2 bits for w; `GL_INT_2_10_10_10_REV`). This is
+	 * usually used for normals and tangents, which only need around 10 bits
+	 * of precision.
+	 */
+	struct int_2_10_10_10_rev {
+	public:
+		GLuint bits;
+	};
+	/**
+	 * Four unsigned, normalized components packed into 32 bits; see
+	 * `int_2_10_10_10_rev` (`GL_UNSIGNED_INT_2_10_10_10_REV`).
+	 */
+	struct uint_2_10_10_10_rev {
+	public:
+		GLuint bits;
+	};
+
+	/**
+	 * The smallest-type form of an index buffer; see `make_index_buffer()`.
+	 */
+	struct index_buffer {
+	public:
+		buffer elements;
+		// The type of each index; `GL_UNSIGNED_SHORT` or `GL_UNSIGNED_INT`.
+		GLenum type;
+		std::size_t count;
+	};
+
+	/**
+	 * Convert a range of floats to another vertex data type. The output must
+	 * hold as many elements as the input (or a quarter as many, for the four
+	 * component packed types). Integer outputs are normalized: signed types
+	 * map `[-1, 1]` to the full range of the type (snorm), and unsigned types
+	 * map `[0, 1]` (unorm); values outside the range are clamped. Where the
+	 * target supports it, the conversions are vectorized.
+	 */
+	void encode(const GLfloat* begin, const GLfloat* end, half*);
+	void encode(const GLfloat* begin, const GLfloat* end, GLbyte*);
+	void encode(const GLfloat* begin, const GLfloat* end, GLshort*);
+	void encode(const GLfloat* begin, const GLfloat* end, GLubyte*);
+	void encode(const GLfloat* begin, const GLfloat* end, GLushort*);
+	void encode(const GLfloat* begin, const GLfloat* end, int_2_10_10_10_rev*);
+	void encode(const GLfloat* begin, const GLfloat* end, uint_2_10_10_10_rev*);
+
+	/**
+	 * Convert a range of float tensors (such as `glm::vec3`) to the given
+	 * type, as a flat array. The result can be passed directly to
+	 * `buffer::set()`, or copied into a vertex structure.
+	 */
+	template<standard_layout T, std::contiguous_iterator Iterator>
+	std::vector<T> encode(Iterator begin, Iterator end);
+
+	/**
+	 * Select the smallest index type able to address the given number of
+	 * vertices. `GL_UNSIGNED_SHORT` is used for up to 65535 vertices; the
+	 * largest value is left unused, so that it can be used as the primitive
+	 * restart index.
+	 */
+	GLenum select_index_type(std::size_t vertex_count);
+	/**
+	 * Create a `GL_ELEMENT_ARRAY_BUFFER` from a range of 32-bit indices,
+	 * narrowed to 16 bits if `select_index_type()` allows it, halving the
+	 * size of the buffer. Every index must be less than the vertex count.
+	 */
+	index_buffer make_index_buffer(const GLuint* begin, const GLuint* end, std::size_t vertex_count, GLenum usage = GL_STATIC_DRAW);
+}
+
+namespace heatsink {
+	// Packed types are treated as scalars, so that they can be used to infer
+	// a `vertex_format` from a structure member.
+	template<> struct is_tensor<gl::half>                : std::true_type {};
+	template<> struct is_tensor<gl::int_2_10_10_10_rev>  : std::true_type {};
+	template<> struct is_tensor<gl::uint_2_10_10_10_rev> : std::true_type {};
+}
+
+namespace heatsink::gl {
+	template<> struct make_enum<half>                : detail::enum_constant<GL_HALF_FLOAT> {};
+	template<> struct make_enum<int_2_10_10_10_rev>  : detail::enum_constant<GL_INT_2_10_10_10_REV> {};
+	template<> struct make_enum<uint_2_10_10_10_rev> : detail::enum_constant<GL_UNSIGNED_INT_2_10_10_10_REV> {};
+
+	template<standard_layout T, std::contiguous_iterator Iterator>
+	std::vector<T> encode(Iterator begin, Iterator end) {
+		using V = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_same_v<std::remove_all_extents_t<tensor_decay_t<V>>, GLfloat>);
+
+		constexpr auto components = sizeof(V) / sizeof(GLfloat);
+		constexpr auto per_output = is_packed(make_enum_v<T>) ? 4 : 1;
+
+		auto count = (std::size_t)std::distance(begin, end) * components;
+		if (count % per_output != 0)
+			throw exception("gl::encode", "packed types require four components per value.");
+
+		std::vector<T> result(count / per_output);
+		if (count != 0) {
+			const auto* data = reinterpret_cast<const GLfloat*>(std::to_address(begin));
+			encode(data, data + count, result.data());
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/program_pipeline.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Reuses program pipelines by the combination of separable programs they
+	 * are built from. Looking up a combination for the first time creates its
+	 * pipeline; later lookups only cost a map search. The programs must
+	 * outlive the pipelines that use them; call `erase()` before destroying
+	 * (or reloading) one.
+	 *
+	 * Pipelines are not validated, as the result of validation depends on the
+	 * current state (such as the samplers bound to each unit). Call
+	 * `program_pipeline::validate()` before drawing if needed.
+	 */
+	class pipeline_cache {
+	public:
+		/**
+		 * Create an empty cache.
+		 */
+		pipeline_cache() = default;
+
+	public:
+		/**
+		 * Retrieve the pipeline that uses every stage of each of the given
+		 * separable programs, creating it if needed. The programs should have
+		 * distinct stages; where they overlap, the last one is used.
+		 */
+		const program_pipeline& get(const std::vector<std::reference_wrapper<const program>>&);
+
+		/**
+		 * Destroy every pipeline that uses the given program.
+		 */
+		void erase(const program&);
+		/**
+		 * Destroy every pipeline.
+		 */
+		void clear();
+
+		/**
+		 * Retrieve the number of pipelines in the cache.
+		 */
+		std::size_t get_size() const;
+
+	private:
+		// The pipelines, keyed by the names of their programs (in order).
+		std::map<std::vector<GLuint>, program_pipeline> m_pipelines;
+	};
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <heatsink/gl/query.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A GPU profiler measuring named, nestable scopes with timestamp queries.
+	 * Queries are kept for a number of frames before their results are read,
+	 * so reading never stalls the pipeline; any result still unavailable at
+	 * that point is dropped rather than waited on. Each scope also pushes a
+	 * debug group (`glPushDebugGroup()`), so that frame captures in tools like
+	 * RenderDoc or Nsight show the same hierarchy.
+	 */
+	class profiler {
+	public:
+		/**
+		 * An active profiler scope; the scope ends when this is destroyed. See
+		 * `profiler::profile()`.
+		 */
+		class scope;
+
+		/**
+		 * The measurements of a single scope, identified by its name and the
+		 * names of its parent scopes. The average is taken over the most
+		 * recent samples, up to the window size of the profiler.
+		 */
+		struct result {
+		public:
+			std::string name;
+			std::size_t depth;
+
+			std::chrono::nanoseconds last;
+			std::chrono::nanoseconds average;
+			std::size_t samples;
+		};
+
+	public:
+		/**
+		 * Create a profiler whose queries are read back the given number of
+		 * frames after they are recorded, averaging each scope over the given
+		 * number of samples.
+		 */
+		profiler(std::size_t latency = 3, std::size_t window = 60);
+
+		// The profiler owns its queries, so it can only be moved.
+		profiler(const profiler&) = delete;
+		profiler(profiler&&) = default;
+
+		profiler& operator =(const profiler&) = delete;
+		profiler& operator =(profiler&&) = default;
+
+	public:
+		/**
+		 * Begin a named scope, nested inside the currently open scope (if any).
+		 * Scopes must be ended in the reverse order they were begun.
+		 */
+		void begin(const std::string&);
+		/**
+		 * End the most recently begun scope.
+		 */
+		void end();
+		/**
+		 * Begin a scope that is ended automatically when the result goes out
+		 * of scope. See `begin()`.
+		 */
+		[[nodiscard]] scope profile(const std::string&);
+
+		/**
+		 * Finish the current frame. Every scope must have been ended. The
+		 * queries of the oldest frame are read back (if available) and recycled.
+		 */
+		void advance();
+
+		/**
+		 * Retrieve the measurements of every scope seen so far, in the order
+		 * they were first begun (which keeps children after their parents).
+		 */
+		std::vector<result> get_results() const;
+		/**
+		 * Write a line for every scope's last and average time, indented by
+		 * depth. This is intended to be called once per frame (or less).
+		 */
+		void write(std::ostream&) const;
+
+		/**
+		 * Retrieve the number of scope samples dropped because their queries
+		 * were not yet available when read back.
+		 */
+		std::size_t get_dropped_count() const;
+
+	private:
+		// A recorded scope within a single frame. The history is an index into
+		// `m_scopes`, and the others into the queries of the frame.
+		struct sample {
+		public:
+			std::size_t history;
+			std::size_t first;
+			std::size_t last;
+		};
+
+		// The queries and samples recorded during a single frame.
+		struct frame {
+		public:
+			std::vector<query> queries;
+			std::vector<sample> samples;
+			// The number of queries in use this frame (the rest are spares).
+			std::size_t used;
+		};
+
+		// The accumulated history of a scope.
+		struct history {
+		public:
+			std::string path;
+			std::string name;
+			std::size_t depth;
+
+			// A ring of the most recent durations, and the next slot to write.
+			std::vector<std::chrono::nanoseconds> durations;
+			std::size_t head;
+			std::chrono::nanoseconds last;
+		};
+
+	private:
+		// Retrieve a recycled (or new) timestamp query and record it.
+		std::size_t record(frame&);
+		// Read back the results of a frame and reset it for reuse.
+		void collect(frame&);
+
+	private:
+		// The frames in flight, written in order.
+		std::vector<frame> m_frames;
+		// The index of the frame currently being recorded.
+		std::size_t m_frame;
+		// The maximum number of samples averaged per scope.
+		std::size_t m_window;
+
+		// Every scope seen, by its full path (parent names joined by '/').
+		std::map<std::string, std::size_t> m_paths;
+		std::vector<history> m_scopes;
+		// The open scopes (indices into `m_frames[m_frame].samples`).
+		std::vector<std::size_t> m_stack;
+
+		// Whether debug groups are supported by the context.
+		bool m_debug_groups;
+		// The number of samples dropped instead of stalling.
+		std::size_t m_dropped;
+	};
+
+	/**
+	 * See forward declaration in `profiler`.
+	 */
+	class profiler::scope {
+	public:
+		/**
+		 * Begin a scope with the given name; see `profiler::begin()`.
+		 */
+		scope(profiler&, const std::string&);
+
+		// A scope must end exactly once, so it cannot be copied or moved.
+		scope(const scope&) = delete;
+		~scope();
+
+		scope& operator =(const scope&) = delete;
+
+	private:
+		// The profiler to end the scope with.
+		profiler& m_profiler;
+	};
+}
@@ -5,9 +5,14 @@
 #include <string>
 #include <vector>
 
+#include <glm/glm.hpp>
+
 #include <heatsink/gl/attribute.hpp>
+#include <heatsink/gl/buffer.hpp>
 #include <heatsink/gl/shader.hpp>
+#include <heatsink/gl/storage_block.hpp>
 #include <heatsink/gl/uniform.hpp>
+#include <heatsink/gl/uniform_block.hpp>
 #include <heatsink/platform/gl.hpp>
 
 namespace heatsink::gl {
@@ -25,6 +30,20 @@ namespace heatsink::gl {
 		 * that the lifetime is tied to that of the shader it is created with.
 		 */
 		class shader_name;
+
+		/**
+		 * The linked executable of a program, as retrieved from the driver
+		 * with `glGetProgramBinary()`. The format is implementation specific,
+		 * so a binary is only valid for the driver (and version) that created
+		 * it. The stages are kept so that a reloaded program can restore its
+		 * stage-specific state, like the compute work group size.
+		 */
+		struct binary {
+		public:
+			GLenum format;
+			std::vector<GLubyte> data;
+			std::vector<GLenum> stages;
+		};
 	
 	public:
 		/**
@@ -36,6 +55,37 @@ namespace heatsink::gl {
 		 * construction of the program.
 		 */
 		static program from_files(const std::vector<std::filesystem::path>&);
+		/**
+		 * Construct a program like the standard constructor, but hint that the
+		 * linked binary will be retrieved (`GL_PROGRAM_BINARY_RETRIEVABLE_HINT`).
+		 * The binary is only guaranteed to be available through `get_binary()`
+		 * for programs created this way (or with `from_binary()`).
+		 */
+		static program retrievable(const std::vector<shader_name>&, const std::string& from = "");
+		/**
+		 * Construct a program from a binary previously returned by
+		 * `get_binary()`, skipping compilation and linking. The driver may
+		 * reject a binary (for example, after it has been updated), in which
+		 * case an exception is thrown and the program must be linked from its
+		 * sources instead. See `program_cache`.
+		 */
+		static program from_binary(const binary&, const std::string& from = "");
+		/**
+		 * Construct a program like the standard constructor, but without
+		 * waiting for the link to finish. Poll `is_complete()`, then call
+		 * `finish()` to check for errors and introspect the program; no other
+		 * member functions may be called before then. The shaders may be
+		 * deferred themselves, and may be destroyed right after this call.
+		 */
+		static program deferred(const std::vector<shader_name>&, const std::string& from = "");
+		/**
+		 * Construct a program like the standard constructor, but linked with
+		 * `GL_PROGRAM_SEPARABLE`, so that its stages can be combined with the
+		 * stages of other separable programs in a `program_pipeline`. This
+		 * usually holds a single stage; each vertex and fragment shader is
+		 * then linked once, instead of once per combination.
+		 */
+		static program separable(const std::vector<shader_name>&, const std::string& from = "");
 
 	public:
 		/**
@@ -58,9 +108,24 @@ namespace heatsink::gl {
 	private:
 		// Create a program with the given shader names; this constructor is
 		// utilized by the public variant and the static creation methods.
-		program(const std::vector<GLuint>& names, const std::string& from);
+		program(const std::vector<GLuint>& names, const std::string& from, bool retrievable, bool deferred, bool separable = false);
+		// Create a program from a retrieved binary. See `from_binary()`.
+		program(const binary&, const std::string& from);
 
 	public:
+		/**
+		 * Check if linking has finished, without blocking. This is always
+		 * `true` for programs that were not deferred, or if the context does
+		 * not support parallel compilation (where `finish()` blocks instead).
+		 */
+		bool is_complete() const;
+		/**
+		 * Wait for a deferred link to finish, throw an exception if it (or the
+		 * compilation of any of its shaders) failed, and introspect the
+		 * program. This has no effect on a program that is already finished.
+		 */
+		void finish();
+
 		/**
 		 * "Bind" the shader to the current context. Any draw calls after this
 		 * method is called will use this shader to process, until another
@@ -68,6 +133,22 @@ namespace heatsink::gl {
 		 */
 		void use() const;
 
+		/**
+		 * Launch the given number of work groups of a compute program. The
+		 * program is `use()`-ed first. Each component of the count must be
+		 * non-zero and within `GL_MAX_COMPUTE_WORK_GROUP_COUNT`. Note that the
+		 * results are only visible to later commands after the appropriate
+		 * `memory_barrier()`.
+		 */
+		void dispatch(glm::uvec3 groups) const;
+		/**
+		 * Launch a compute program with the work group count sourced from a
+		 * buffer; the view must start with three `GLuint`s (the layout of
+		 * `DispatchIndirectCommand`), be targeted at
+		 * `GL_DISPATCH_INDIRECT_BUFFER`, and be aligned to four bytes.
+		 */
+		void dispatch_indirect(const buffer::const_view&) const;
+
 		/**
 		 * Check if the program instance is valid. A program should be valid
 		 * unless it has thrown an exception or been moved from. Calling any
@@ -83,6 +164,35 @@ namespace heatsink::gl {
 		 * Note that an assertion is raised if `is_valid()` would equal `false`.
 		 */
 		GLuint get() const;
+		/**
+		 * Retrieve the linked binary of this program, so that it can be stored
+		 * and passed to `from_binary()` later. The program must have been
+		 * created with `retrievable()` or `from_binary()`.
+		 */
+		binary get_binary() const;
+
+		/**
+		 * Check if the program contains a compute shader. A compute program
+		 * cannot contain other stages, and can only be used with `dispatch()`.
+		 */
+		bool is_compute() const;
+		/**
+		 * Check if the program was linked with `separable()`, and can be used
+		 * in a `program_pipeline`.
+		 */
+		bool is_separable() const;
+		/**
+		 * Retrieve the stage (such as `GL_VERTEX_SHADER`) of each shader that
+		 * was linked into the program.
+		 */
+		const std::vector<GLenum>& get_stages() const;
+		/**
+		 * Retrieve the local size of the compute shader; the number of
+		 * invocations in each work group, as declared with
+		 * `layout(local_size_x = ...) in`. Use this to derive the group count
+		 * for `dispatch()` from the number of items to process.
+		 */
+		glm::uvec3 get_work_group_size() const;
 
 		/**
 		 * Retrieve the specified attribute, if it exists. The attribute must be
@@ -96,10 +206,25 @@ namespace heatsink::gl {
 		 * alter the state of the program/shader overall.
 		 */
 		uniform get_uniform(const std::string&);
+		/**
+		 * Retrieve the specified uniform block, if it exists. The block must be
+		 * active and have been discovered through introspection. Like
+		 * `get_uniform()`, this is non-const as the block binding can be set.
+		 */
+		uniform_block& get_uniform_block(const std::string&);
+		/**
+		 * Retrieve the specified shader storage block, if it exists. The block
+		 * must be active and have been discovered through introspection.
+		 */
+		storage_block& get_storage_block(const std::string&);
 
 	private:
-		// Link the specified `GL_SHADER` identifiers to this program.
-		void link(const std::vector<GLuint>& names, const std::string& from);
+		// Attach the specified `GL_SHADER` identifiers and submit the link.
+		void link(const std::vector<GLuint>& names);
+		// Raise an exception if the program is still waiting on `finish()`.
+		void validate_finished() const;
+		// Query the attributes, uniforms, and blocks of the linked program.
+		void introspect();
 
 	public:
 		/**
@@ -110,11 +235,26 @@ namespace heatsink::gl {
 	private:
 		// The OpenGL identifier for this program.
 		GLuint m_name;
+		// The stages of the shaders linked into this program.
+		std::vector<GLenum> m_stages;
+		// Whether the program was linked with `GL_PROGRAM_SEPARABLE`.
+		bool m_separable;
+		// The path or ID used to identify the program in its error log.
+		std::string m_from;
+		// The shaders still attached while a deferred link is pending; this is
+		// empty once the program is finished.
+		std::vector<GLuint> m_pending;
+		// The local size of the compute shader (zero if not a compute program).
+		glm::uvec3 m_work_group_size;
 
 		// The introspected attribute names mapped to their values.
 		std::map<std::string, attribute> m_attributes;
 		// The introspected uniform names mapped to their values.
 		std::map<std::string, uniform> m_uniforms;
+		// The introspected uniform block names mapped to their values.
+		std::map<std::string, uniform_block> m_uniform_blocks;
+		// The introspected storage block names mapped to their values.
+		std::map<std::string, storage_block> m_storage_blocks;
 	};
 
 	/**
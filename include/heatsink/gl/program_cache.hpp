@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/shader_cache.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An on-disk cache of linked program binaries. Programs are loaded from
+	 * the same file paths as `program::from_files()`; if a binary for the
+	 * exact same sources was stored by the same driver, it is loaded with
+	 * `program::from_binary()` instead of compiling and linking the shaders.
+	 * Each entry is keyed by a hash of the shader stages and sources, the
+	 * driver vendor/renderer/version strings, and the context version, so a
+	 * changed shader or driver update is a cache miss rather than an error.
+	 */
+	class program_cache {
+	public:
+		/**
+		 * The results of every `load()` since construction or the last reset.
+		 * A rejected binary (one the driver refused to load, even though the
+		 * key matched) is also counted as a miss. The time saved is estimated
+		 * from the link time recorded with each entry, minus the time taken to
+		 * load its binary.
+		 */
+		struct statistics {
+		public:
+			std::size_t hits;
+			std::size_t misses;
+			std::size_t rejected;
+
+			std::chrono::nanoseconds time_saved;
+		};
+
+	public:
+		/**
+		 * Create a cache backed by the given directory, creating it if needed.
+		 * The driver strings are queried here, so the context the programs
+		 * will be used with must be current. An exception is thrown if the
+		 * implementation does not support any program binary formats.
+		 */
+		program_cache(std::filesystem::path directory);
+
+	public:
+		/**
+		 * Load a program from a set of shader file paths; see
+		 * `program::from_files()` for the file naming requirements. The cached
+		 * binary is used if present and accepted, otherwise the shaders are
+		 * linked and the resulting binary is written back to the cache.
+		 * Failing to write an entry is reported, but is not an error.
+		 */
+		program load(const std::vector<std::filesystem::path>&);
+		/**
+		 * Load a program from shader sources (such as variants from
+		 * `shader::preprocess()`), with one stage per source. A program ID may
+		 * be passed for error logs. On a miss, the shaders are taken from the
+		 * given shader cache if there is one, so a variant shared between
+		 * programs is still only compiled once.
+		 */
+		program load(const std::vector<GLenum>& stages, const std::vector<std::string>& sources,
+			const std::string& from = "", shader_cache* = nullptr);
+
+		/**
+		 * Remove every entry written by a cache to this directory.
+		 */
+		void clear();
+
+		/**
+		 * Retrieve the directory backing this cache.
+		 */
+		const std::filesystem::path& get_directory() const;
+
+		/**
+		 * Retrieve the hit, miss, and rejection counts and the estimated time
+		 * saved since construction or the last reset.
+		 */
+		statistics get_statistics() const;
+		/**
+		 * Reset all counters (and the time saved) to zero.
+		 */
+		void reset_statistics();
+
+	private:
+		// Load a program from its sources, identifying each shader in the logs
+		// by the matching ID; used by both public variants of `load()`.
+		program load(const std::vector<GLenum>& stages, const std::vector<std::string>& sources,
+			const std::vector<std::string>& ids, const std::string& from, shader_cache*);
+		// Compute the cache key for a set of shader stages and their sources.
+		std::uint64_t make_key(const std::vector<GLenum>& stages, const std::vector<std::string>& sources) const;
+		// Retrieve the path of the entry with the given key.
+		std::filesystem::path make_path(std::uint64_t key) const;
+
+	private:
+		// The directory that entries are written to.
+		std::filesystem::path m_directory;
+		// The hash of the driver and context identification, which seeds the
+		// hash of every entry key.
+		std::uint64_t m_driver;
+
+		// The counters returned by `get_statistics()`.
+		statistics m_statistics;
+	};
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/program.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/enum.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * The type-erased part of `program_interface`; resolves and validates a
+	 * list of uniforms against a program. This is not intended to be used
+	 * directly.
+	 */
+	class program_interface_base {
+	protected:
+		// The expected type of a single uniform of the interface.
+		struct member {
+		public:
+			std::string name;
+			GLenum datatype;
+			std::size_t size;
+		};
+
+	protected:
+		// Resolve each member by name, and throw an exception if the program
+		// has no such uniform or if its type or array size does not match.
+		program_interface_base(const program&, const std::vector<member>&);
+
+	public:
+		/**
+		 * Retrieve the OpenGL name of the program this interface targets.
+		 */
+		GLuint get_program() const;
+
+	protected:
+		GLuint m_program;
+		// The locations of each member, in declaration order.
+		std::vector<GLint> m_locations;
+	};
+
+	/**
+	 * A C++ struct bound to the non-block uniforms of a program. The struct
+	 * members are listed as pointers-to-member, and each is matched to a
+	 * uniform by name when the interface is created; this is the only place
+	 * where types are checked or exceptions are thrown. `update()` then
+	 * uploads every member with the `glProgramUniform*()` call chosen at
+	 * compile time from its type.
+	 *
+	 * ```
+	 * struct material {
+	 *     glm::vec4 color;
+	 *     float roughness;
+	 *     glm::mat4 transforms[4];
+	 * };
+	 * using material_interface = program_interface<material,
+	 *     &material::color, &material::roughness, &material::transforms>;
+	 *
+	 * auto interface = material_interface(p, {"color", "roughness", "transforms"});
+	 * interface.update(m);
+	 * ```
+	 *
+	 * Members must be tensors (or builtin arrays of tensors, for array
+	 * uniforms) with a `make_enum_v` type. The interface must not outlive its
+	 * program.
+	 */
+	template<standard_layout Struct, auto... Members>
+	class program_interface : public program_interface_base {
+	public:
+		/**
+		 * The number of uniforms described by the interface.
+		 */
+		static constexpr std::size_t size = sizeof...(Members);
+
+	public:
+		/**
+		 * Bind the struct members to the uniforms of a (finished) program with
+		 * the given names, in the same order as the member list.
+		 */
+		program_interface(const program&, const std::array<std::string, size>& names);
+
+	public:
+		/**
+		 * Upload every member of the struct to its uniform. The program does
+		 * not need to be in use; without separate shader objects (OpenGL 4.1),
+		 * it is made the program in use.
+		 */
+		void update(const Struct&) const;
+		/**
+		 * Upload a single member of the struct, by its index in the member
+		 * list.
+		 */
+		template<std::size_t Index>
+		void update(const Struct&) const;
+	};
+}
+
+namespace heatsink::gl {
+	namespace detail {
+		// Retrieve the type of the member referenced by a pointer-to-member.
+		template<class T>
+		struct member_pointer;
+		template<class C, class T>
+		struct member_pointer<T C::*> {
+			using type = T;
+		};
+		template<auto Member>
+		using member_t = typename member_pointer<decltype(Member)>::type;
+
+		// The uniform value type of a member; builtin arrays are uniform
+		// arrays, so their element type is used.
+		template<class T>
+		using uniform_element_t = std::conditional_t<std::is_array_v<T>, std::remove_extent_t<T>, T>;
+		template<class T>
+		constexpr std::size_t uniform_count_v = std::is_array_v<T> ? std::extent_v<T> : 1;
+
+		template<class T>
+		constexpr GLenum uniform_enum_v = make_enum_v<tensor_decay_t<uniform_element_t<T>>>;
+
+		// Upload a member with the `glProgramUniform*()` variant matching its
+		// type, or (without separate shader objects) the `glUniform*()`
+		// variant after using the program. Each branch is selected at
+		// compile-time.
+		template<class T>
+		void program_uniform(GLuint p, GLint l, const T& value) {
+			constexpr auto datatype = uniform_enum_v<T>;
+			constexpr auto count    = (GLsizei)uniform_count_v<T>;
+
+			using component = std::remove_all_extents_t<tensor_decay_t<uniform_element_t<T>>>;
+			static_assert(datatype != GL_NONE);
+
+			auto separate = context_state::get_current().has_separate_shader_objects();
+			if (!separate)
+				glUseProgram(p);
+
+			auto call = [&](auto program_fn, auto fn, auto... args) {
+				if (separate)
+					program_fn(p, l, count, args...);
+				else
+					fn(l, count, args...);
+			};
+
+			const auto* data = reinterpret_cast<const component*>(std::addressof(value));
+			if constexpr (std::is_same_v<component, bool>) {
+				// Booleans must be uploaded as integers; see `uniform::update()`.
+				constexpr auto n = sizeof(T) / sizeof(bool);
+				std::array<GLint, n> is;
+				std::copy(data, data + n, is.begin());
+
+				if constexpr (datatype == GL_BOOL)      call(glProgramUniform1iv, glUniform1iv, is.data());
+				if constexpr (datatype == GL_BOOL_VEC2) call(glProgramUniform2iv, glUniform2iv, is.data());
+				if constexpr (datatype == GL_BOOL_VEC3) call(glProgramUniform3iv, glUniform3iv, is.data());
+				if constexpr (datatype == GL_BOOL_VEC4) call(glProgramUniform4iv, glUniform4iv, is.data());
+			}
+			else if constexpr (datatype == GL_INT)      call(glProgramUniform1iv, glUniform1iv, data);
+			else if constexpr (datatype == GL_INT_VEC2) call(glProgramUniform2iv, glUniform2iv, data);
+			else if constexpr (datatype == GL_INT_VEC3) call(glProgramUniform3iv, glUniform3iv, data);
+			else if constexpr (datatype == GL_INT_VEC4) call(glProgramUniform4iv, glUniform4iv, data);
+
+			else if constexpr (datatype == GL_UNSIGNED_INT)      call(glProgramUniform1uiv, glUniform1uiv, data);
+			else if constexpr (datatype == GL_UNSIGNED_INT_VEC2) call(glProgramUniform2uiv, glUniform2uiv, data);
+			else if constexpr (datatype == GL_UNSIGNED_INT_VEC3) call(glProgramUniform3uiv, glUniform3uiv, data);
+			else if constexpr (datatype == GL_UNSIGNED_INT_VEC4) call(glProgramUniform4uiv, glUniform4uiv, data);
+
+			else if constexpr (datatype == GL_FLOAT)      call(glProgramUniform1fv, glUniform1fv, data);
+			else if constexpr (datatype == GL_FLOAT_VEC2) call(glProgramUniform2fv, glUniform2fv, data);
+			else if constexpr (datatype == GL_FLOAT_VEC3) call(glProgramUniform3fv, glUniform3fv, data);
+			else if constexpr (datatype == GL_FLOAT_VEC4) call(glProgramUniform4fv, glUniform4fv, data);
+
+			else if constexpr (datatype == GL_FLOAT_MAT2)   call(glProgramUniformMatrix2fv, glUniformMatrix2fv, GL_FALSE, data);
+			else if constexpr (datatype == GL_FLOAT_MAT2x3) call(glProgramUniformMatrix2x3fv, glUniformMatrix2x3fv, GL_FALSE, data);
+			else if constexpr (datatype == GL_FLOAT_MAT2x4) call(glProgramUniformMatrix2x4fv, glUniformMatrix2x4fv, GL_FALSE, data);
+
+			else if constexpr (datatype == GL_FLOAT_MAT3x2) call(glProgramUniformMatrix3x2fv, glUniformMatrix3x2fv, GL_FALSE, data);
+			else if constexpr (datatype == GL_FLOAT_MAT3)   call(glProgramUniformMatrix3fv, glUniformMatrix3fv, GL_FALSE, data);
+			else if constexpr (datatype == GL_FLOAT_MAT3x4) call(glProgramUniformMatrix3x4fv, glUniformMatrix3x4fv, GL_FALSE, data);
+
+			else if constexpr (datatype == GL_FLOAT_MAT4x2) call(glProgramUniformMatrix4x2fv, glUniformMatrix4x2fv, GL_FALSE, data);
+			else if constexpr (datatype == GL_FLOAT_MAT4x3) call(glProgramUniformMatrix4x3fv, glUniformMatrix4x3fv, GL_FALSE, data);
+			else if constexpr (datatype == GL_FLOAT_MAT4)   call(glProgramUniformMatrix4fv, glUniformMatrix4fv, GL_FALSE, data);
+
+			else static_assert(datatype == GL_NONE, "unsupported uniform datatype.");
+		}
+	}
+
+	template<standard_layout Struct, auto... Members>
+	program_interface<Struct, Members...>::program_interface(const program& p, const std::array<std::string, size>& names)
+	: program_interface_base(p, [&] {
+		constexpr std::array<GLenum, size> datatypes   = {detail::uniform_enum_v<detail::member_t<Members>>...};
+		constexpr std::array<std::size_t, size> counts = {detail::uniform_count_v<detail::member_t<Members>>...};
+
+		std::vector<member> results;
+		for (std::size_t i = 0; i != size; ++i)
+			results.push_back(member{names[i], datatypes[i], counts[i]});
+
+		return results;
+	}()) {
+		static_assert(size > 0);
+		static_assert((std::is_member_object_pointer_v<decltype(Members)> && ...));
+	}
+
+	template<standard_layout Struct, auto... Members>
+	void program_interface<Struct, Members...>::update(const Struct& s) const {
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			(this->template update<Is>(s), ...);
+		}(std::make_index_sequence<size>());
+	}
+
+	template<standard_layout Struct, auto... Members>
+	template<std::size_t Index>
+	void program_interface<Struct, Members...>::update(const Struct& s) const {
+		static_assert(Index < size);
+		constexpr auto member = std::get<Index>(std::make_tuple(Members...));
+
+		detail::program_uniform(m_program, m_locations[Index], s.*member);
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+
+#include <heatsink/gl/object.hpp>
+#include <heatsink/gl/program.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL program pipeline object. A pipeline combines the stages of
+	 * several separable programs (see `program::separable()`), so that each
+	 * shader is linked once and mixed freely with others at draw time. The
+	 * programs are referenced, not owned; they must outlive their use in the
+	 * pipeline. See `pipeline_cache` for reusing pipelines by combination.
+	 */
+	class program_pipeline : public object<GL_PROGRAM_PIPELINE> {
+	public:
+		/**
+		 * Create an empty pipeline. Like `program`, a path or ID may be passed
+		 * to identify the pipeline in its validation log.
+		 */
+		program_pipeline(const std::string& from = "");
+
+	public:
+		/**
+		 * Use every stage of the given separable program in this pipeline,
+		 * replacing the programs previously set for those stages.
+		 */
+		void set_program(const program&);
+		/**
+		 * Use only the given stages (a bitfield like `GL_VERTEX_SHADER_BIT`)
+		 * of a separable program in this pipeline.
+		 */
+		void set_program(GLbitfield stages, const program&);
+		/**
+		 * Remove the programs of the given stages from this pipeline.
+		 */
+		void reset_stages(GLbitfield stages);
+
+		/**
+		 * Check that the stages of the pipeline can be used together, such as
+		 * that the outputs of each stage match the inputs of the next. An
+		 * exception is thrown (and the log written) if they cannot. This is
+		 * the pipeline equivalent of a link error.
+		 */
+		void validate() const;
+
+		/**
+		 * Bind the pipeline to the current context. Note that a program made
+		 * current with `program::use()` takes precedence over any pipeline, so
+		 * the current program is reset first.
+		 */
+		void use() const;
+
+	private:
+		// The path or ID used to identify the pipeline in its error log.
+		std::string m_from;
+	};
+}
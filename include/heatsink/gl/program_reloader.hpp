@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdlib>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <heatsink/gl/build_queue.hpp>
+#include <heatsink/gl/program.hpp>
+#include <heatsink/gl/shader.hpp>
+#include <heatsink/platform/file_watcher.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Reloads programs when their shader files change on disk. Programs are
+	 * loaded like `program::from_files()`, but are owned by the reloader, and
+	 * the returned references remain valid for as long as they are loaded.
+	 * When a file changes, only the stages read from it are recompiled; the
+	 * new program is built in the background (see `build_queue`), and moved
+	 * into the existing program once it links, which also introspects it
+	 * again. If a stage fails to compile or the program fails to link, the
+	 * errors are logged and the old program is kept.
+	 *
+	 * Note that anything derived from a program's name or introspection
+	 * (such as a `uniform`, `uniform_state` or `program_pipeline`) must be
+	 * recreated once the program has been reloaded; see `update()`.
+	 */
+	class program_reloader {
+	public:
+		/**
+		 * Create a reloader with no programs.
+		 */
+		program_reloader();
+
+	public:
+		/**
+		 * Load a program from a set of shader file paths, and start watching
+		 * them. The program is built immediately, and an exception is thrown
+		 * if it fails; the files are not watched in that case.
+		 */
+		program& load(const std::vector<std::filesystem::path>&);
+		/**
+		 * Stop watching the files of a loaded program, and destroy it. Any
+		 * pending rebuild is discarded.
+		 */
+		void unload(const program&);
+
+		/**
+		 * Start rebuilding the programs whose files have changed, and swap in
+		 * every rebuild that has finished. This should be called once per
+		 * frame, and does not block while parallel compilation is available.
+		 * Returns the programs that were replaced during this call.
+		 */
+		std::vector<program*> update();
+
+		/**
+		 * Check if a rebuild of the given program is in progress.
+		 */
+		bool is_pending(const program&) const;
+
+	private:
+		// A loaded program and the shaders it was last linked from.
+		struct entry {
+		public:
+			std::unique_ptr<program> target;
+			std::vector<std::filesystem::path> paths;
+			std::vector<GLenum> stages;
+			std::vector<shader> shaders;
+
+			// The stages recompiled for the build in progress, by index.
+			std::map<std::size_t, shader> replacements;
+			std::optional<build_queue::ticket> build;
+			// Stages that changed while a build was already in progress.
+			std::vector<std::size_t> changed;
+		};
+
+	private:
+		// Submit a rebuild of an entry with its changed stages recompiled.
+		void rebuild(entry&);
+		// Swap in (or discard) the finished build of an entry. Returns `true`
+		// if the program was replaced.
+		bool complete(entry&);
+
+	private:
+		file_watcher m_watcher;
+		build_queue m_queue;
+
+		// The loaded programs; a list, so that entries never move.
+		std::list<entry> m_entries;
+	};
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <heatsink/gl/object.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL query object. The target specifies what is measured between
+	 * `begin()` and `end()`: elapsed GPU time (`GL_TIME_ELAPSED`), samples
+	 * (`GL_SAMPLES_PASSED`, `GL_ANY_SAMPLES_PASSED`), or primitives. A
+	 * `GL_TIMESTAMP` query instead records the GPU time at a single point in
+	 * the command stream through `record()`. Results become available some
+	 * time after the commands complete; reading a result before
+	 * `is_available()` returns `true` stalls until the GPU catches up.
+	 */
+	class query : public object<GL_QUERY> {
+	public:
+		/**
+		 * Create a new query with the given target.
+		 */
+		query(GLenum);
+
+	public:
+		/**
+		 * Start measuring commands submitted from this point on. Only one
+		 * query of each target may be active at a time.
+		 */
+		void begin();
+		/**
+		 * Stop measuring commands; the result covers every command between the
+		 * `begin()` and this call.
+		 */
+		void end();
+		/**
+		 * Record the GPU time once all previous commands have completed. This
+		 * is only valid for `GL_TIMESTAMP` queries, which cannot begin/end.
+		 */
+		void record();
+
+		/**
+		 * Check if the result of the query can be read without blocking.
+		 */
+		bool is_available() const;
+		/**
+		 * Retrieve the result of the query; nanoseconds for timer queries, or
+		 * a count/boolean for the others. This blocks until `is_available()`.
+		 */
+		std::uint64_t get_result() const;
+	};
+
+	/**
+	 * A scope of conditional rendering (`glBeginConditionalRender()`). Draws
+	 * submitted while the scope is active are discarded by the GPU if the
+	 * occlusion query it was created with passed no samples; the CPU never
+	 * waits for the result. The query must be a `GL_SAMPLES_PASSED` or
+	 * `GL_ANY_SAMPLES_PASSED(_CONSERVATIVE)` query that has ended. See
+	 * `occlusion_cache`.
+	 */
+	class conditional_render {
+	public:
+		/**
+		 * Begin conditional rendering on the given query. With the default
+		 * `GL_QUERY_NO_WAIT` mode, draws are performed if the result is not
+		 * yet available when the GPU reaches them; `GL_QUERY_WAIT` waits on
+		 * the GPU instead. The `BY_REGION` variants are also accepted.
+		 */
+		conditional_render(const query&, GLenum mode = GL_QUERY_NO_WAIT);
+		/**
+		 * Create an inactive scope; draws are always performed. This allows
+		 * objects without any query yet to follow the same code path.
+		 */
+		conditional_render(std::nullptr_t);
+
+		// A scope must end exactly once, so it cannot be copied or moved.
+		conditional_render(const conditional_render&) = delete;
+		~conditional_render();
+
+		conditional_render& operator =(const conditional_render&) = delete;
+
+	public:
+		/**
+		 * Check if draws in the scope are conditional (the scope has a query).
+		 */
+		bool is_active() const;
+
+	private:
+		// Whether `glEndConditionalRender()` must be called on destruction.
+		bool m_active;
+	};
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdlib>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/fence.hpp>
+#include <heatsink/gl/pixel_format.hpp>
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/memory.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A pending copy of buffer or texture data back to client memory. The copy
+	 * is queued into a pixel pack buffer along with a fence, and returns
+	 * immediately; mapping the buffer once the fence is signaled then exposes
+	 * the data without stalling the pipeline or copying it a second time.
+	 * Readbacks are usually created with `buffer::read()` or `texture::read()`,
+	 * and checked with `is_ready()` a frame or two later.
+	 */
+	class readback {
+	public:
+		/**
+		 * Take ownership of a buffer that a copy has already been queued into,
+		 * and insert a fence after it. The buffer must be readable through
+		 * `buffer::mapping` (that is, created with `GL_MAP_READ_BIT` if it
+		 * is immutable).
+		 */
+		readback(buffer&&);
+
+	public:
+		/**
+		 * Check if the copy has completed, without blocking.
+		 */
+		bool is_ready() const;
+		/**
+		 * Block until the copy has completed.
+		 */
+		void wait() const;
+
+		/**
+		 * Wait for the copy to complete (if necessary), and map the data for
+		 * reading. The contents are interpreted as an array of `T`, whose size
+		 * must evenly divide the size of the readback. A buffer can only be
+		 * mapped once at a time, so an exception is thrown if a mapping of
+		 * this readback is still alive. The pack buffer binding is left at
+		 * `0`, as it is by `read()`.
+		 */
+		template<standard_layout T = GLubyte>
+		buffer::mapping<T> map() const;
+
+		/**
+		 * Retrieve the number of bytes read back.
+		 */
+		std::size_t get_size() const;
+		/**
+		 * Retrieve the buffer holding the data read back.
+		 */
+		const buffer& get_buffer() const;
+
+	private:
+		// The destination of the copy, targeted at `GL_PIXEL_PACK_BUFFER`.
+		buffer m_buffer;
+		// Signaled once the copy into `m_buffer` has completed.
+		fence m_fence;
+	};
+}
+
+namespace heatsink::gl {
+	template<standard_layout T>
+	buffer::mapping<T> readback::map() const {
+		this->wait();
+		return buffer::mapping<T>(buffer::const_view(m_buffer));
+	}
+}
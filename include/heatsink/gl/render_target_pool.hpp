@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Recycles the transient textures used as render targets within a frame
+	 * (such as for post-processing passes). Instead of allocating a texture
+	 * for each pass, one is acquired from the pool by its format, extents and
+	 * sample count, and released back once the pass that consumes it has been
+	 * issued. Released textures that are not reacquired within a number of
+	 * frames are destroyed, so changes in resolution do not leak memory.
+	 *
+	 * The contents of an acquired texture are undefined; it should be cleared
+	 * or entirely overwritten (and is a good candidate for
+	 * `framebuffer::discard()` once it has been consumed).
+	 */
+	class render_target_pool {
+	public:
+		/**
+		 * Create a pool that destroys free textures after they have gone
+		 * unused for the given number of calls to `advance()`.
+		 */
+		render_target_pool(std::size_t lifetime = 3);
+
+	public:
+		/**
+		 * Retrieve a 2D texture with the given internal format and extents,
+		 * reusing a free one if possible. If a sample count is given, the
+		 * texture is a `GL_TEXTURE_2D_MULTISAMPLE` with fixed sample
+		 * locations; otherwise, it is a `GL_TEXTURE_2D` with a single level.
+		 */
+		texture acquire(GLenum ifmt, glm::uvec2, std::size_t samples = 0);
+		/**
+		 * Return a texture to the pool, to be reused by a later `acquire()`.
+		 * An exception is thrown if it was not acquired from this pool.
+		 */
+		void release(texture&&);
+
+		/**
+		 * Finish the current frame, destroying any free textures that have
+		 * exceeded their lifetime. This should be called once per frame.
+		 */
+		void advance();
+		/**
+		 * Destroy every free texture immediately. Textures that are currently
+		 * acquired are unaffected, and may still be released.
+		 */
+		void clear();
+
+		/**
+		 * Retrieve the number of textures waiting to be reused.
+		 */
+		std::size_t get_free_count() const;
+		/**
+		 * Retrieve the number of textures acquired but not yet released.
+		 */
+		std::size_t get_acquired_count() const;
+
+	private:
+		// The internal format, width, height, and sample count of a texture.
+		using key = std::tuple<GLenum, GLuint, GLuint, std::size_t>;
+
+		// A free texture, with the frame during which it was released.
+		struct entry {
+		public:
+			texture target;
+			std::size_t frame;
+		};
+
+	private:
+		std::size_t m_lifetime;
+		std::size_t m_frame;
+
+		std::map<key, std::vector<entry>> m_free;
+		// The key of each acquired texture, by name.
+		std::unordered_map<GLuint, key> m_acquired;
+	};
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <tuple>
+
+#include <glm/glm.hpp>
+
+#include <heatsink/gl/texture.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Tracks which virtual pages of a sparse texture are committed, keeping
+	 * the total committed memory inside a budget. Pages are requested as they
+	 * are needed (for example, from a feedback pass), and the least recently
+	 * requested pages are decommitted to make room for new ones. Pages
+	 * requested during the current frame are never evicted. The mip tail is
+	 * committed for the lifetime of the tracker, and is not counted.
+	 */
+	class residency_tracker {
+	public:
+		/**
+		 * A single virtual page, identified by its mip level and its position
+		 * in pages (not texels) within that level. For array textures and
+		 * cubemaps, the last component is the layer or face.
+		 */
+		struct page {
+		public:
+			std::size_t mip;
+			glm::uvec3 index;
+		};
+
+		/**
+		 * The result of requesting a page. A newly committed page has undefined
+		 * contents, and should be updated before it is sampled; a rejected page
+		 * could not fit in the budget without evicting pages in use this frame.
+		 */
+		enum class status {
+			resident,
+			committed,
+			rejected
+		};
+
+	public:
+		/**
+		 * Create a tracker for the given sparse texture, which must outlive it,
+		 * with a budget in bytes. Every page is initially uncommitted.
+		 */
+		residency_tracker(texture&, std::size_t budget);
+
+		// Pages are owned by the tracker, so it should not be copied.
+		residency_tracker(const residency_tracker&) = delete;
+		residency_tracker(residency_tracker&&) = default;
+
+		residency_tracker& operator =(const residency_tracker&) = delete;
+		residency_tracker& operator =(residency_tracker&&) = default;
+
+	public:
+		/**
+		 * Mark a page as in use this frame, committing it if necessary.
+		 */
+		status request(const page&);
+		/**
+		 * Decommit a page immediately, if it is committed.
+		 */
+		void release(const page&);
+		/**
+		 * Start a new frame; pages requested before this become evictable.
+		 */
+		void advance();
+
+		/**
+		 * Check if a page is currently committed.
+		 */
+		bool is_resident(const page&) const;
+		/**
+		 * Create a view of the region of the texture covered by a page, for
+		 * updating its contents at the page's mip level.
+		 */
+		texture::view make_view(const page&) const;
+
+		/**
+		 * Retrieve the number of pages along each dimension of a mip level.
+		 */
+		glm::uvec3 get_page_count(std::size_t mip) const;
+		/**
+		 * Retrieve the size of a single page, in texels and in bytes.
+		 */
+		glm::uvec3 get_page_extents() const;
+		std::size_t get_page_size() const;
+
+		/**
+		 * Retrieve the committed size and the budget, in bytes.
+		 */
+		std::size_t get_resident_size() const;
+		std::size_t get_budget() const;
+
+	private:
+		// Pages are ordered by (mip, x, y, z) in the map.
+		using key = std::tuple<std::size_t, glm::uvec3::value_type, glm::uvec3::value_type, glm::uvec3::value_type>;
+
+		// The state of a committed page.
+		struct record {
+		public:
+			// Its position in `m_recent`.
+			std::list<key>::iterator position;
+			// The frame it was last requested.
+			std::size_t frame;
+		};
+
+	private:
+		// Validate a page and convert it to its map key.
+		key to_key(const page&) const;
+		// Change the commitment of a page. See `texture::commit()`.
+		void set_commitment(const key&, bool commit);
+
+	private:
+		texture* m_texture;
+		// The number of levels that are committed by page (not the tail).
+		std::size_t m_levels;
+
+		glm::uvec3 m_page;
+		std::size_t m_page_size;
+		std::size_t m_budget;
+		std::size_t m_frame;
+
+		// Every committed page, most recently requested first.
+		std::list<key> m_recent;
+		std::map<key, record> m_pages;
+	};
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/fence.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/memory.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A persistently mapped buffer used to stream per-frame data. The storage
+	 * is split into a number of equally sized frames; each frame is written by
+	 * the CPU while the GPU reads from the previous ones. Sub-allocations from
+	 * the current frame are handed out as `buffer::view`s. When advancing to
+	 * the next frame, the CPU only blocks if the GPU has not yet finished
+	 * with the commands that read from that frame the last time it was used.
+	 */
+	class ring_buffer {
+	public:
+		/**
+		 * Create a new ring buffer with the given target. The size specifies
+		 * the number of bytes available within a single frame; the total
+		 * storage allocated is `size * frames` (plus any alignment padding).
+		 * The buffer is created with `buffer::immutable()`, and is mapped for
+		 * its entire lifetime as persistent and coherent.
+		 */
+		ring_buffer(GLenum, std::size_t size, std::size_t frames = 3);
+
+		// Like `object`, ring buffers can only be moved.
+		ring_buffer(const ring_buffer&) = delete;
+		ring_buffer(ring_buffer&&) noexcept;
+		~ring_buffer();
+
+		ring_buffer& operator =(const ring_buffer&) = delete;
+		ring_buffer& operator =(ring_buffer&&) noexcept;
+
+	public:
+		/**
+		 * Reserve the given number of bytes from the current frame. The offset
+		 * of the result is a multiple of the alignment requested, as well as
+		 * any offset alignment required by the buffer target (for example,
+		 * `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT`). An exception is thrown if the
+		 * request does not fit in the remaining space of the frame.
+		 */
+		buffer::view allocate(std::size_t size, std::size_t align = 1);
+		/**
+		 * Reserve space from the current frame and copy the data pointed to by
+		 * the given iterator range into it. The view is aligned to the size of
+		 * the value type, so it may be used like any other `buffer::view`.
+		 */
+		template<std::contiguous_iterator Iterator>
+		buffer::view write(Iterator begin, Iterator end);
+
+		/**
+		 * Retrieve a pointer to the mapped memory backing the given view. The
+		 * view must have been allocated from this ring buffer during the
+		 * current frame; writing to it after `advance()` is undefined.
+		 */
+		template<standard_layout T = GLubyte>
+		T* get_data(const buffer::view&);
+
+		/**
+		 * Finish the current frame and move to the next one. A fence is placed
+		 * after all commands submitted so far, guarding the frame that was just
+		 * written. If the next frame is still guarded by a fence that has not
+		 * been signaled, this method blocks until the GPU releases it.
+		 */
+		void advance();
+		/**
+		 * Check if calling `advance()` now would block; that is, if the next
+		 * frame is still guarded by a fence the GPU has not yet signaled. This
+		 * never blocks itself, so a caller can decide to do other work first.
+		 */
+		bool would_block() const;
+
+		/**
+		 * Check if the ring buffer instance is valid. A ring buffer should be
+		 * valid unless it has thrown an exception or been moved from. Calling
+		 * any member functions on an invalid ring buffer is undefined behavior,
+		 * although it is likely to raise an assertion.
+		 */
+		bool is_valid() const;
+
+		/**
+		 * Retrieve the buffer backing all frames. This can be used to bind the
+		 * whole buffer once and address allocations by offset (for example,
+		 * with a base vertex or base instance).
+		 */
+		const buffer& get_buffer() const;
+
+		/**
+		 * Retrieve the number of frames the storage is split into.
+		 */
+		std::size_t get_frame_count() const;
+		/**
+		 * Retrieve the number of bytes available in a single frame.
+		 */
+		std::size_t get_frame_size() const;
+		/**
+		 * Retrieve the number of bytes that have not yet been allocated from
+		 * the current frame. Note that padding for alignment may make a request
+		 * of this size fail.
+		 */
+		std::size_t get_remaining() const;
+
+	private:
+		// The immutable storage for all frames.
+		buffer m_buffer;
+		// The persistent mapping of the entire range of `m_buffer`.
+		buffer::mapping<GLubyte> m_mapping;
+
+		// The fence guarding each frame (invalid if it is not in use).
+		std::vector<fence> m_fences;
+		// The minimum offset alignment required by the buffer target.
+		std::size_t m_alignment;
+		// The size of a single frame, rounded to `m_alignment`.
+		std::size_t m_frame_size;
+
+		// The index of the frame currently being written.
+		std::size_t m_frame;
+		// The number of bytes already allocated from the current frame.
+		std::size_t m_head;
+	};
+}
+
+namespace heatsink::gl {
+	template<std::contiguous_iterator Iterator>
+	buffer::view ring_buffer::write(Iterator begin, Iterator end) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_standard_layout_v<T>);
+
+		assert(this->is_valid());
+		auto size = std::distance(begin, end) * sizeof(T);
+		// Use the same alignment `buffer::update()` requires of its views.
+		auto result = this->allocate(size, sizeof(T));
+
+		if (size != 0)
+			std::memcpy(this->get_data(result), address_of(*begin), size);
+
+		return result;
+	}
+
+	template<standard_layout T>
+	T* ring_buffer::get_data(const buffer::view& v) {
+		assert(this->is_valid());
+		if (v.get_offset() + v.get_size() > m_buffer.get_size())
+			throw exception("gl::ring_buffer", "view does not belong to ring buffer.");
+
+		return reinterpret_cast<T*>(m_mapping.get_data() + v.get_offset());
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdlib>
+
+#include <heatsink/gl/object.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL sampler object; the filtering, wrapping, and comparison state
+	 * used to sample textures, separate from the textures themselves. A
+	 * sampler bound to a texture unit overrides the sampling parameters of
+	 * whatever texture is bound to the same unit, so a handful of samplers
+	 * can serve any number of textures. See `texture::bind()` and
+	 * `sampler_cache`.
+	 */
+	class sampler : public object<GL_SAMPLER> {
+	public:
+		/**
+		 * The complete state of a sampler. The defaults are the OpenGL
+		 * defaults. Parameters are compared as a whole, so that equal states
+		 * can share a sampler.
+		 */
+		struct parameters {
+		public:
+			auto operator <=>(const parameters&) const = default;
+
+		public:
+			GLenum min_filter = GL_NEAREST_MIPMAP_LINEAR;
+			GLenum mag_filter = GL_LINEAR;
+
+			GLenum wrap_s = GL_REPEAT;
+			GLenum wrap_t = GL_REPEAT;
+			GLenum wrap_r = GL_REPEAT;
+
+			GLfloat min_lod  = -1000.0f;
+			GLfloat max_lod  =  1000.0f;
+			GLfloat lod_bias =  0.0f;
+			// The maximum anisotropy; values above `1` are ignored if the
+			// context does not support anisotropic filtering, and are clamped
+			// to `GL_MAX_TEXTURE_MAX_ANISOTROPY` otherwise.
+			GLfloat anisotropy = 1.0f;
+
+			// Depth comparison, for shadow samplers (`GL_COMPARE_REF_TO_TEXTURE`).
+			GLenum compare_mode = GL_NONE;
+			GLenum compare_func = GL_LEQUAL;
+
+			std::array<GLfloat, 4> border_color = {0.0f, 0.0f, 0.0f, 0.0f};
+		};
+
+	public:
+		/**
+		 * Unbind any sampler from the given texture unit, so that the unit
+		 * samples with the parameters of its texture again.
+		 */
+		static void unbind(std::size_t unit);
+
+	public:
+		/**
+		 * Create a new sampler with the given state (pass `{}` for the OpenGL
+		 * defaults). The state of a sampler cannot be changed after creation;
+		 * create another sampler instead.
+		 */
+		explicit sampler(const parameters&);
+
+	public:
+		/**
+		 * Retrieve the state the sampler was created with.
+		 */
+		const parameters& get_parameters() const;
+
+	private:
+		// The state applied in the constructor.
+		parameters m_parameters;
+	};
+}
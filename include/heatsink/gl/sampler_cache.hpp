@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+
+#include <heatsink/gl/sampler.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Deduplicates samplers by their complete state. Materials describe how
+	 * their textures are sampled with `sampler::parameters`, and retrieve the
+	 * shared sampler for that state from the cache; thousands of materials
+	 * then use a few dozen samplers, and binding a sampler that is already
+	 * bound to a unit is skipped entirely (see `name_traits<>::bind()`).
+	 *
+	 * Samplers are never evicted; references returned by `get()` stay valid
+	 * until `clear()` is called or the cache is destroyed.
+	 */
+	class sampler_cache {
+	public:
+		/**
+		 * Create an empty cache.
+		 */
+		sampler_cache() = default;
+
+	public:
+		/**
+		 * Retrieve the sampler with the given state, creating it if no sampler
+		 * with an equal state exists yet.
+		 */
+		const sampler& get(const sampler::parameters&);
+		/**
+		 * Bind the sampler with the given state to a texture unit; shorthand
+		 * for `get(p).bind(unit)`.
+		 */
+		void bind(const sampler::parameters&, std::size_t unit);
+
+		/**
+		 * Destroy every sampler in the cache. Any sampler still bound to a
+		 * unit is unbound by OpenGL.
+		 */
+		void clear();
+		/**
+		 * Retrieve the number of distinct samplers in the cache.
+		 */
+		std::size_t get_size() const;
+
+	private:
+		std::map<sampler::parameters, sampler> m_samplers;
+	};
+}
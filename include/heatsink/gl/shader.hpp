@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <map>
 #include <string>
 
 #include <heatsink/platform/gl.hpp>
@@ -21,6 +22,37 @@ namespace heatsink::gl {
 		 */
 		static shader from_file(const std::filesystem::path&, GLenum stage = GL_NONE);
 
+		/**
+		 * Deduce the shader stage from the extension of a file path. The
+		 * extensions `.vert`, `.frag`, `.tesc`, `.tese`, `.geom`, and `.comp`
+		 * are recognized, and may be followed by a final `.glsl`. An exception
+		 * is thrown for any other extension.
+		 */
+		static GLenum to_stage(const std::filesystem::path&);
+		/**
+		 * Read the source code of a shader from the given file path, as done
+		 * by `from_file()`. An exception is thrown if the file cannot be read.
+		 */
+		static std::string read_source(const std::filesystem::path&);
+		/**
+		 * Inject a set of preprocessor definitions into shader source code.
+		 * Each name is defined (as `#define NAME VALUE`) on its own line right
+		 * after the `#version` directive, or at the start if there is none,
+		 * followed by a `#line` directive so that error logs still refer to
+		 * the lines of the original source. An empty value defines the name
+		 * without a value. See `shader_cache` for compiling the results.
+		 */
+		static std::string preprocess(const std::string&, const std::map<std::string, std::string>& defines);
+		/**
+		 * Create a shader from source code like the standard constructor, but
+		 * without waiting for compilation to finish. With
+		 * `GL_KHR_parallel_shader_compile`, the driver compiles in the
+		 * background; poll `is_complete()`, then call `finish()` to check for
+		 * errors. A deferred shader can be linked into a program before it is
+		 * finished, in which case compile errors are reported by the program.
+		 */
+		static shader deferred(const std::string&, GLenum stage, const std::string& from = "");
+
 	public:
 		/**
 		 * Create a shader directly from source code. The desired stage must be
@@ -39,7 +71,24 @@ namespace heatsink::gl {
 		shader& operator =(const shader&) = delete;
 		shader& operator =(shader&&) noexcept;
 
+	private:
+		// Create a shader, optionally deferring the compile status check. This
+		// constructor is used by the public variant and `deferred()`.
+		shader(const std::string&, GLenum stage, const std::string& from, bool deferred);
+
 	public:
+		/**
+		 * Check if compilation has finished, without blocking. This is always
+		 * `true` for shaders that were not deferred, or if the context does not
+		 * support parallel compilation (where `finish()` blocks instead).
+		 */
+		bool is_complete() const;
+		/**
+		 * Wait for a deferred compile to finish, and throw an exception if it
+		 * failed; this has no effect on a shader that is already finished.
+		 */
+		void finish();
+
 		/**
 		 * Check if the shader instance is valid. A shader should be valid
 		 * unless it has thrown an exception or been moved from. Calling any
@@ -62,13 +111,18 @@ namespace heatsink::gl {
 		GLenum get_stage() const;
 
 	private:
-		// Compile the given source into this shader.
-		void compile(const std::string&, const std::string& from);
+		// Submit the given source to be compiled into this shader.
+		void compile(const std::string&);
 
 	private:
 		// The OpenGL identifier for this shader.
 		GLuint m_name;
 		// The stage the shader was created with.
 		GLenum m_stage;
+
+		// The path or ID used to identify the shader in its error log.
+		std::string m_from;
+		// Whether the compile status has not yet been checked.
+		bool m_pending;
 	};
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <heatsink/gl/shader.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Compiles each unique shader variant once. A variant is a base source
+	 * with a set of definitions injected by `shader::preprocess()`; the
+	 * preprocessed source is hashed together with its stage, and requests for
+	 * an identical variant (even one built from a different set of defines)
+	 * return the shader that was already compiled. The cache owns its
+	 * shaders, so references to them remain valid until `clear()`.
+	 */
+	class shader_cache {
+	public:
+		/**
+		 * A set of preprocessor definitions, mapping names to their values.
+		 */
+		using defines = std::map<std::string, std::string>;
+
+		/**
+		 * The results of every `get()` since construction or the last reset.
+		 */
+		struct statistics {
+		public:
+			std::size_t hits;
+			std::size_t misses;
+		};
+
+	public:
+		/**
+		 * Create an empty cache.
+		 */
+		shader_cache();
+
+	public:
+		/**
+		 * Retrieve the shader compiled from the given source and stage, with
+		 * the definitions injected, compiling it first if this variant has not
+		 * been seen. Like `shader`, a path or ID may be passed to identify the
+		 * variant in its error log; it is only used when compiling.
+		 */
+		const shader& get(const std::string& source, GLenum stage, const defines& = {}, const std::string& from = "");
+		/**
+		 * Retrieve the shader compiled from an already preprocessed source;
+		 * see `shader::preprocess()`.
+		 */
+		const shader& get_preprocessed(const std::string& source, GLenum stage, const std::string& from = "");
+
+		/**
+		 * Destroy every cached shader. Programs already linked from them are
+		 * not affected.
+		 */
+		void clear();
+
+		/**
+		 * Retrieve the number of unique variants in the cache.
+		 */
+		std::size_t get_size() const;
+		/**
+		 * Retrieve the hit and miss counts since construction or the last
+		 * reset.
+		 */
+		statistics get_statistics() const;
+		/**
+		 * Reset the hit and miss counts to zero.
+		 */
+		void reset_statistics();
+
+	private:
+		// A compiled variant. The source is kept to resolve hash collisions.
+		struct entry {
+		public:
+			GLenum stage;
+			std::string source;
+			shader result;
+		};
+
+	private:
+		// The variants by the hash of their stage and preprocessed source.
+		// This is node-based, so references to the shaders are stable.
+		std::unordered_multimap<std::uint64_t, entry> m_entries;
+		statistics m_statistics;
+	};
+}
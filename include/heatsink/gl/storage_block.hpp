@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/platform/gl.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL active shader storage block. Like a `uniform_block`, a storage
+	 * block is sourced from a buffer range, but the range is bound to a
+	 * `GL_SHADER_STORAGE_BUFFER` index and may be written by the shader (and
+	 * may end in an unsized array). Introspection uses the program interface
+	 * queries, so storage blocks require OpenGL 4.3. The lifetime of a block
+	 * is tied to the program it was introspected from.
+	 */
+	class storage_block {
+	public:
+		/**
+		 * Retrieve information on all active storage blocks in a program. This
+		 * creates a map of block names to their indices and sizes. On contexts
+		 * older than OpenGL 4.3, the result is always empty.
+		 */
+		static std::map<std::string, storage_block> from_program(const class program&);
+
+	public:
+		/**
+		 * Construct a storage block from a program and the name of the block
+		 * (not the instance name, if one is declared in the shader).
+		 */
+		storage_block(const class program&, std::string name);
+
+	private:
+		// Create a storage block from its index within the given program. This
+		// constructor is used by the public variant and introspection.
+		storage_block(GLuint owner, GLuint index);
+
+	public:
+		/**
+		 * Assign the `GL_SHADER_STORAGE_BUFFER` binding index this block
+		 * sources its data from. Like `uniform_block::set_binding()`, this is
+		 * program state that only needs to be set once.
+		 */
+		void set_binding(std::size_t);
+		/**
+		 * Bind the given buffer range to the binding index of this block. The
+		 * view must be at least as large as the fixed portion of the block,
+		 * and its offset must be a multiple of
+		 * `GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT`.
+		 */
+		void bind(const buffer::const_view&) const;
+
+		/**
+		 * Check if the storage block instance is valid. A block should be valid
+		 * unless it has thrown an exception (probably during construction).
+		 * Calling any member functions on an invalid block is undefined and
+		 * will usually raise an assertion.
+		 */
+		bool is_valid() const;
+
+		/**
+		 * Retrieve the index of this block within its program object.
+		 */
+		GLuint get() const;
+		/**
+		 * Retrieve the name of this block, as declared in the shader.
+		 */
+		const std::string& get_name() const;
+
+		/**
+		 * Retrieve the minimum number of bytes of buffer storage needed to
+		 * back this block. If the block ends in an unsized array, this counts
+		 * a single element of that array.
+		 */
+		std::size_t get_size() const;
+		/**
+		 * Retrieve the binding index currently assigned to this block.
+		 */
+		std::size_t get_binding() const;
+
+	private:
+		// The OpenGL identifier of the owning program.
+		GLuint m_program;
+
+		// The index of this block within the owning program.
+		GLuint m_index;
+		// The string identifier of this block.
+		std::string m_name;
+
+		// The data size of the block, in bytes.
+		std::size_t m_size;
+		// The storage buffer binding index assigned to this block.
+		std::size_t m_binding;
+	};
+}
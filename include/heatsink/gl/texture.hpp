@@ -12,14 +12,21 @@
 
 #include <heatsink/error/debug.hpp>
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/memory_tracker.hpp>
 #include <heatsink/gl/object.hpp>
 #include <heatsink/gl/pixel_format.hpp>
+#include <heatsink/gl/sampler.hpp>
 #include <heatsink/platform/gl.hpp>
 #include <heatsink/traits/memory.hpp>
 #include <heatsink/traits/tensor.hpp>
 #include <heatsink/traits/texture.hpp>
 
 namespace heatsink::gl {
+	// The result of `texture::read()`; see `heatsink/gl/readback.hpp`.
+	class readback;
+
 	/**
 	 * A basic OpenGL texture type. This represents all dimensions/special types
 	 * of textures, where unique parameters are specified through the texture
@@ -64,9 +71,12 @@ namespace heatsink::gl {
 		 * size of the data cannot be changed after creation; only the
 		 * `glUpdate*()` methods can be used to modify the texture backing. The
 		 * format specifies the internal representation of the texture; OpenGL
-		 * will convert any data passed in `update()` to this format.
+		 * will convert any data passed in `update()` to this format. If sparse
+		 * is true, only virtual storage is reserved (`ARB_sparse_texture`);
+		 * memory must then be committed to regions before they are updated or
+		 * sampled, see `commit()`.
 		 */
-		static texture immutable(GLenum, GLenum ifmt, extents, std::size_t mips = 1);
+		static texture immutable(GLenum, GLenum ifmt, extents, std::size_t mips = 1, bool sparse = false);
 		/**
 		 * Create an immutable texture that can be multisampled. This texture is
 		 * also cannot be changed after creation, and additionally cannot be
@@ -94,6 +104,13 @@ namespace heatsink::gl {
 		 */
 		template<std::contiguous_iterator Iterator>
 		texture(GLenum, GLenum ifmt, extents, Iterator begin, Iterator end, pixel_format);
+		/**
+		 * Create a new texture with a compressed internal format, and fill it
+		 * with the compressed blocks pointed to by the given iterator range.
+		 * See `format_traits::compressed_size()` for the size required.
+		 */
+		template<std::contiguous_iterator Iterator>
+		texture(GLenum, GLenum ifmt, extents, Iterator begin, Iterator end);
 
 	protected:
 		// Copy a texture, but alter parameters appropriate for a `view` with
@@ -101,10 +118,11 @@ namespace heatsink::gl {
 		texture(const texture&, extents offset, extents size);
 	
 	private:
-		// Create an immutable texture with the given target and format.
-		texture(GLenum, GLenum ifmt, extents, std::size_t mips);
-		// Create a multisample texture with the given target and format.
-		texture(GLenum, GLenum ifmt, extents, std::size_t n, bool fix);
+		// Create an immutable texture with the given target and format. If the
+		// sample count is `0`, mipmapped storage is allocated; otherwise, the
+		// texture is multisampled (and `mips` must be `1`). Only mipmapped
+		// storage can be sparse.
+		texture(GLenum, GLenum ifmt, extents, std::size_t mips, std::size_t samples, bool fix, bool sparse);
 
 	public:
 		/**
@@ -124,6 +142,14 @@ namespace heatsink::gl {
 		 */
 		template<std::contiguous_iterator Iterator>
 		void set(GLenum ifmt, extents, Iterator begin, Iterator end, pixel_format);
+		/**
+		 * Reallocate the texture store with a compressed internal format, and
+		 * fill it with already compressed data (`glCompressedTexImage*()`).
+		 * The size of the data must be exactly the number of blocks needed to
+		 * cover the extents given. See the above overload.
+		 */
+		template<std::contiguous_iterator Iterator>
+		void set(GLenum ifmt, extents, Iterator begin, Iterator end);
 
 		/**
 		 * Update the backing store of this texture in-place. The
@@ -134,6 +160,29 @@ namespace heatsink::gl {
 		 */
 		template<std::contiguous_iterator Iterator>
 		void update(std::size_t mip, Iterator begin, Iterator end, pixel_format);
+		/**
+		 * Update the backing store of this texture from a pixel unpack buffer
+		 * (a `GL_PIXEL_UNPACK_BUFFER`). The size of the view must match the
+		 * texture format and size like the above overload. The copy is queued
+		 * on the GPU instead of reading client memory during the call, so the
+		 * data can be written into a mapping (such as a `ring_buffer`) while
+		 * earlier transfers are still in progress. See `texture_uploader`.
+		 */
+		void update(std::size_t mip, const buffer::const_view&, pixel_format);
+		/**
+		 * Update a texture with a compressed internal format from compressed
+		 * blocks in the same format (`glCompressedTexSubImage*()`). The offset
+		 * of the texture (or view) must be a multiple of the block size, and
+		 * so must its size, unless it extends to the edge of the mip level.
+		 * Compressed textures cannot be updated with pixel data.
+		 */
+		template<std::contiguous_iterator Iterator>
+		void update(std::size_t mip, Iterator begin, Iterator end);
+		/**
+		 * Update a compressed texture from a pixel unpack buffer. See the
+		 * above overload, and the pixel buffer overload of uncompressed data.
+		 */
+		void update(std::size_t mip, const buffer::const_view&);
 
 		/**
 		 * Clear the buffer store to the specified value, where the pixel is
@@ -149,6 +198,48 @@ namespace heatsink::gl {
 		 * need to wait for synchronization on the old memory.
 		 */
 		void invalidate(std::size_t mip);
+		/**
+		 * Generate every mip level below the base level from the base level
+		 * (`glGenerateMipmap()`). This must be called on an entire texture, not
+		 * a view, and is not supported for multisample or compressed textures.
+		 */
+		void generate_mipmaps();
+		/**
+		 * Restrict sampling to the given range of mip levels (inclusive), by
+		 * setting `GL_TEXTURE_BASE_LEVEL` and `GL_TEXTURE_MAX_LEVEL`. Levels
+		 * outside the range do not need to be defined for the texture to be
+		 * complete, which allows the detailed levels of an immutable texture to
+		 * be uploaded after it is first used. See `mip_streamer`.
+		 */
+		void set_level_range(std::size_t base, std::size_t max);
+
+		/**
+		 * Bind the texture to a texture unit, like `object::bind()`. The
+		 * second overload binds a sampler to the same unit, overriding the
+		 * sampling parameters of the texture; see `sampler_cache`.
+		 */
+		using object<GL_TEXTURE>::bind;
+		void bind(std::size_t unit, const sampler&) const;
+		/**
+		 * Commit physical memory to the region of this (sparse) texture or view
+		 * at the given mip level. The region must be aligned to the virtual
+		 * page size of the texture (see `get_page_size()`), except where it
+		 * reaches the edge of the level. Committed memory is undefined until
+		 * updated.
+		 */
+		void commit(std::size_t mip);
+		/**
+		 * Release the physical memory of the region of this texture or view at
+		 * the given mip level. See `commit()`.
+		 */
+		void decommit(std::size_t mip);
+		/**
+		 * Start an asynchronous copy of a mip level of this texture (or view)
+		 * into client-mappable memory, converted to the given pixel format;
+		 * see `readback` (`heatsink/gl/readback.hpp`). Reading a view smaller
+		 * than the whole level requires OpenGL 4.5.
+		 */
+		readback read(std::size_t mip, pixel_format) const;
 
 		/**
 		 * Create a view out of a subset of this texture. Any overload with a
@@ -168,6 +259,16 @@ namespace heatsink::gl {
 		 * can only be updated. A multisample texture is also immutable.
 		 */
 		bool is_immutable() const;
+		/**
+		 * Check if the internal format of this texture is a block-compressed
+		 * format. See `format_traits::is_compressed()`.
+		 */
+		bool is_compressed() const;
+		/**
+		 * Check if this texture was created with sparse (virtual) storage. See
+		 * `immutable()`.
+		 */
+		bool is_sparse() const;
 		/**
 		 * Check if this texture does not have any data set (that is, its size
 		 * is zero across all dimensions). Most operations cannot be performed
@@ -197,23 +298,92 @@ namespace heatsink::gl {
 		 * `set()` methods.
 		 */
 		std::size_t get_mipmap_count() const;
+		/**
+		 * Retrieve the number of mip levels of a sparse texture that can be
+		 * committed page by page (`GL_NUM_SPARSE_LEVELS_ARB`). The remaining
+		 * smaller levels form the "mip tail", which is committed as a whole by
+		 * committing any of it.
+		 */
+		std::size_t get_sparse_level_count() const;
+		/**
+		 * Retrieve the virtual page size of a sparse texture, or zero if the
+		 * texture is not sparse. See `texture_traits::page_size()`.
+		 */
+		glm::uvec3 get_page_size() const;
+
+		/**
+		 * Retrieve the bindless handle of this texture (`ARB_bindless_texture`),
+		 * sampled with the texture's own sampler state. Once a handle has been
+		 * retrieved, the texture's parameters can no longer be changed. The
+		 * handle refers to the entire texture, even when called on a view.
+		 */
+		GLuint64 get_handle() const;
+		/**
+		 * Make the bindless handle of this texture resident, so that shaders
+		 * may sample through it. The handle is made non-resident automatically
+		 * when the texture is destroyed.
+		 */
+		void make_resident();
+		/**
+		 * Make the bindless handle of this texture non-resident. Shaders must
+		 * not access a non-resident handle.
+		 */
+		void make_non_resident();
+		/**
+		 * Check if the bindless handle of this texture is resident in the
+		 * current context.
+		 */
+		bool is_resident() const;
 
 	protected:
 		// Allow subclass access to the base "offset" managed by this texture.
 		glm::uvec3 get_base(std::size_t mip = 0) const;
 
+	private:
+		// Validate an update of the given mip level and size (in bytes). The
+		// error message differs based on whether a pixel buffer is used.
+		void validate_update(std::size_t mip, std::size_t size, pixel_format) const;
+		// Copy pixel data into the given mip level. The data is either a client
+		// pointer, or an offset into the bound pixel unpack buffer.
+		void upload(std::size_t mip, const void* data, pixel_format);
+		// Copy the given mip level into the bound pixel pack buffer, starting
+		// at its beginning. The size is that of the entire (tightly packed) range.
+		void download(std::size_t mip, std::size_t size, pixel_format) const;
+		// Like `validate_update()` and `upload()`, for compressed blocks in the
+		// internal format of the texture.
+		void validate_compressed_update(std::size_t mip, std::size_t size) const;
+		void upload_compressed(std::size_t mip, const void* data, std::size_t size);
+		// Reallocate the base level from compressed blocks; see `set()`.
+		void set_compressed(GLenum ifmt, extents, const void* data, std::size_t size);
+		// Change the commitment of the region at the given mip level.
+		void set_commitment(std::size_t mip, bool commit);
+		// Record the size of the storage (of every mip level, and every sample
+		// if multisampled) in `memory_tracker`.
+		void track_storage(std::size_t samples) const;
+		// Cache the page size and sparse level count of sparse storage.
+		void query_sparse();
+
 	private:
 		// Whether the texture was created with `glTextureStorage()`.
 		bool m_immutable;
+		// Whether the storage is sparse (`GL_TEXTURE_SPARSE_ARB`).
+		bool m_sparse;
 		// The start of the data managed in this texture. Used by subclasses.
 		glm::uvec3 m_base;
 		// The dimensions of the texture (unused components are always `1`).
 		glm::uvec3 m_extents;
+		// The dimensions of the owning texture (the same as the above, unless
+		// this is a view). Compressed updates must know where a level ends.
+		glm::uvec3 m_bounds;
 
 		// The internal format of the texture
 		GLenum m_format;
 		// The number of mipmap levels (`1` if the texture type is unsupported).
 		std::size_t m_levels;
+		// The virtual page size and number of sparse levels, queried once the
+		// sparse storage is allocated (zero otherwise).
+		glm::uvec3 m_page;
+		std::size_t m_sparse_levels;
 	};
 
 	/**
@@ -234,6 +404,12 @@ namespace heatsink::gl {
 		extents(glm::uvec1);
 		extents(glm::uvec2);
 		extents(glm::uvec3);
+		/**
+		 * Create a new `extents` from the first `length` components of the
+		 * given vector. This is useful when the length is only known at
+		 * runtime, such as from the rank of a texture target.
+		 */
+		extents(glm::uvec3, std::size_t length);
 		
 	public:
 		/**
@@ -327,6 +503,12 @@ namespace heatsink::gl {
 		 * to the methods using it to only use the range specified by this view.
 		 */
 		using texture::bind;
+		/**
+		 * Retrieve the name of the parent texture. Like `bind()`, this refers
+		 * to the entire texture, not only the range of the view; it is needed
+		 * to attach a view to a `framebuffer`.
+		 */
+		using texture::get;
 
 		/**
 		 * A view implements a subset of the `texture` interface. All methods
@@ -335,12 +517,21 @@ namespace heatsink::gl {
 		 */
 		using texture::is_valid;
 		using texture::is_immutable;
+		using texture::is_compressed;
+		using texture::is_sparse;
 		using texture::is_empty;
 
 		using texture::get_target;
 		using texture::get_extents;
 		using texture::get_format;
 		using texture::get_mipmap_count;
+		using texture::get_sparse_level_count;
+		using texture::get_page_size;
+
+		/**
+		 * Read back the range represented by this view. See `texture::read()`.
+		 */
+		using texture::read;
 	};
 
 	/**
@@ -375,15 +566,28 @@ namespace heatsink::gl {
 		using texture::update;
 		using texture::clear;
 		using texture::invalidate;
+		using texture::commit;
+		using texture::decommit;
 
 		using texture::make_view;
+
+		/**
+		 * Allow a mutable view to be passed wherever a constant view of the
+		 * same range is accepted (such as `framebuffer::attach()`).
+		 */
+		operator const_view() const;
 	};
 
 	/**
 	 * Calculate the number of bytes needed to represent a texture of the given
 	 * size and format.
 	 */
-	constexpr std::size_t size_of(texture::extents, pixel_format);
+	std::size_t size_of(texture::extents, pixel_format);
+	/**
+	 * Calculate the number of bytes needed to represent a texture of the given
+	 * size in a compressed internal format. See `format_traits`.
+	 */
+	std::size_t compressed_size_of(texture::extents, GLenum ifmt);
 }
 
 namespace heatsink::gl {
@@ -394,6 +598,12 @@ namespace heatsink::gl {
 		this->set(ifmt, es, begin, end, format);
 	}
 
+	template<std::contiguous_iterator Iterator>
+	texture::texture(GLenum target, GLenum ifmt, extents es, Iterator begin, Iterator end)
+	: texture(target) {
+		this->set(ifmt, es, begin, end);
+	}
+
 	template<std::contiguous_iterator Iterator>
 	void texture::set(GLenum ifmt, extents es, Iterator begin, Iterator end, pixel_format format) {
 		using T = typename std::iterator_traits<Iterator>::value_type;
@@ -409,7 +619,7 @@ namespace heatsink::gl {
 				<< "cannot allocate data "
 				<< "(size=" << size << ") "
 				<< "for texture "
-				<< "(extents=" << glm::to_string(es) << ", format=" << to_string(ifmt) << ")." << std::endl;
+				<< "(extents=" << glm::to_string(es.get(1)) << ", format=" << to_string(ifmt) << ")." << std::endl;
 
 			throw exception("gl::texture", "data size mismatch.");
 		}
@@ -439,21 +649,30 @@ namespace heatsink::gl {
 			throw exception("gl::texture", "invalid texture extents.");
 
 		m_extents = es.get(1);
+		m_bounds  = m_extents;
 		m_format  = ifmt;
 		m_levels  = 1;
 
-		auto [x, y, z] = m_extents;
+		auto e     = m_extents;
 		auto pfmt  = format.get();
 		auto ptype = format.get_datatype();
 
+		// There is no direct state access variant of `glTexImage*()`, so the
+		// texture is always bound to allocate mutable storage. Client pointers
+		// are only interpreted as such while no pixel unpack buffer is bound,
+		// and the data is tightly packed, like that of `update()`.
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
+		auto alignment = pixel_store_scope(GL_UNPACK_ALIGNMENT, 1);
 		this->bind(0);
 		glTexParameteri(t, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
 
 		switch (rank) {
-			case 1: glTexImage1D(t, 0, m_format, x,       0, pfmt, ptype, address_of(*begin)); break;
-			case 2: glTexImage2D(t, 0, m_format, x, y,    0, pfmt, ptype, address_of(*begin)); break;
-			case 3: glTexImage3D(t, 0, m_format, x, y, z, 0, pfmt, ptype, address_of(*begin)); break;
+			case 1: glTexImage1D(t, 0, m_format, e.x,           0, pfmt, ptype, address_of(*begin)); break;
+			case 2: glTexImage2D(t, 0, m_format, e.x, e.y,      0, pfmt, ptype, address_of(*begin)); break;
+			case 3: glTexImage3D(t, 0, m_format, e.x, e.y, e.z, 0, pfmt, ptype, address_of(*begin)); break;
 		}
+
+		this->track_storage(1);
 	}
 
 	template<std::contiguous_iterator Iterator>
@@ -462,51 +681,38 @@ namespace heatsink::gl {
 		static_assert(is_tensor_v<T>);
 
 		assert(this->is_valid());
-		if (mip >= m_levels)
-			throw exception("gl::texture", "mipmap level out of bounds.");
+		this->validate_update(mip, std::distance(begin, end) * sizeof(T), format);
+		if (this->is_empty())
+			return;
 
-		auto es = this->get_extents(mip);
-		if (auto size = std::distance(begin, end) * sizeof(T); size != size_of(es, format)) {
-			make_error_stream("gl::texture")
-				<< "cannot assign data "
-				<< "(size=" << size << ") "
-				<< "to texture "
-				<< "(extents=" << glm::to_string(es) << ", format=" << to_string(ifmt) << ")." << std::endl;
+		// Client pointers are only interpreted as such while no pixel unpack
+		// buffer is bound.
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
+		this->upload(mip, address_of(*begin), format);
+	}
 
-			throw exception("gl::texture", "data size mismatch.");
-		}
+	template<std::contiguous_iterator Iterator>
+	void texture::set(GLenum ifmt, extents es, Iterator begin, Iterator end) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_standard_layout_v<T>);
 
-		auto t = this->get_target();
-		if (texture_traits::is_multisample(t))
-			throw exception("gl::texture", "cannot update multisample texture directly.");
-		// If this is a cubemap, only single-face views should be updated.
-		if (texture_traits::is_cubemap(t) && m_extents.z != 1)
-			throw exception("gl::texture", "cannot update multiple cubemap faces simultaneously.");
+		assert(this->is_valid() && m_base == glm::uvec3(0));
+		this->set_compressed(ifmt, es, address_of(*begin), std::distance(begin, end) * sizeof(T));
+	}
 
+	template<std::contiguous_iterator Iterator>
+	void texture::update(std::size_t mip, Iterator begin, Iterator end) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_standard_layout_v<T>);
+
+		assert(this->is_valid());
+		auto size = std::distance(begin, end) * sizeof(T);
+		this->validate_compressed_update(mip, size);
 		if (this->is_empty())
 			return;
 
-		auto rank = texture_traits::rank(t);
-		if (t == GL_TEXTURE_CUBE_MAP) {
-			// Normal cube maps must be treated as separate 2D textures, based
-			// on the current offset of this view. Note that while the 3D
-			// variant can be used in OpenGL 4.5, the old method is used to
-			// support all version, including 3.3 - 4.4.
-			t = GL_TEXTURE_CUBE_MAP_POSITIVE_X + m_base.z;
-			rank = 2;
-		}
-
-		auto [bx, by, bz] = this->get_base(mip);
-		auto [sx, sy, sz] = es.get(1);
-		auto pfmt  = format.get();
-		auto ptype = format.get_datatype();
-
-		this->bind(0);
-		switch (rank) {
-			case 1: glTexSubImage1D(t, mip, bx,         sx,         pfmt, ptype, address_of(*begin)); break;
-			case 2: glTexSubImage2D(t, mip, bx, by,     sx, sy,     pfmt, ptype, address_of(*begin)); break;
-			case 3: glTexSubImage3D(t, mip, bx, by, bz, sx, sy, sz, pfmt, ptype, address_of(*begin)); break;
-		}
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
+		this->upload_compressed(mip, address_of(*begin), size);
 	}
 
 	template<tensor T>
@@ -521,14 +727,14 @@ namespace heatsink::gl {
 		if (this->is_empty())
 			return;
 
-		auto [bx, by, bz] = this->get_base(mip);
-		auto [sx, sy, sz] = this->get_extents(mip).get(1);
+		auto base  = this->get_base(mip);
+		auto size  = this->get_extents(mip).get(1);
 		auto pfmt  = format.get();
 		auto ptype = format.get_datatype();
 
 		// FIXME: check T matches format.
 
-		glClearTexSubImage(this->get(), mip, bx, by, bz, sx, sy, sz, pfmt, ptype, address_of(&t));
+		glClearTexSubImage(this->get(), mip, base.x, base.y, base.z, size.x, size.y, size.z, pfmt, ptype, address_of(t));
 	}
 
 	template<bool Const>
@@ -549,8 +755,8 @@ namespace heatsink::gl {
 	}
 
 	template<bool Const>
-	texture::basic_view<Const>::extents texture::basic_view<Const>::get_offset(std::size_t mip) const {
+	typename texture::basic_view<Const>::extents texture::basic_view<Const>::get_offset(std::size_t mip) const {
 		assert(this->is_valid());
-		return this->get_base(mip);
+		return extents(this->get_base(mip), this->get_rank());
 	}
 }
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/platform/mapped_file.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A texture container file (KTX2 or DDS), memory mapped for loading. The
+	 * header is parsed on construction to find the target, format, and the
+	 * location of every mip level and layer within the file; the image data
+	 * itself is only read when it is uploaded, directly from the mapped pages.
+	 * No memory proportional to the size of the images is ever allocated.
+	 * Supercompressed (zstd/Basis) KTX2 files are not supported.
+	 */
+	class texture_file {
+	public:
+		/**
+		 * A contiguous run of image data in the file, covering a single mip
+		 * level of one or more layers (or cubemap faces).
+		 */
+		struct image {
+		public:
+			std::size_t mip;
+			std::size_t layer;
+			std::size_t layers;
+
+			const std::byte* data;
+			std::size_t size;
+		};
+
+	public:
+		/**
+		 * Map and parse the texture file at the given path. The container is
+		 * chosen by the file signature rather than the extension. An exception
+		 * is thrown if the file is not a valid container, uses an unsupported
+		 * format, or its images extend past the end of the file.
+		 */
+		texture_file(const std::filesystem::path&);
+
+	public:
+		/**
+		 * Create an immutable texture with the target, format, extents, and mip
+		 * levels of the file, and upload every image into it.
+		 */
+		texture create() const;
+		/**
+		 * Upload every image into an existing texture (or view), which must
+		 * have the same format and extents as the file. Images are uploaded
+		 * straight from the mapping, so the driver copies out of the mapped
+		 * pages without any intermediate client copy.
+		 */
+		void upload(texture::view) const;
+		/**
+		 * Upload a single image of the file (one of `get_images()`) into the
+		 * matching level and layers of a texture (or view). See `upload()`.
+		 */
+		void upload(texture::view, const image&) const;
+
+		/**
+		 * Retrieve the texture target described by the file, for example
+		 * `GL_TEXTURE_2D_ARRAY` or `GL_TEXTURE_CUBE_MAP`.
+		 */
+		GLenum get_target() const;
+		/**
+		 * Retrieve the internal format of the image data.
+		 */
+		GLenum get_format() const;
+		/**
+		 * Retrieve the extents of the base mip level. For arrays and cubemaps,
+		 * the last dimension is the number of layers (or faces).
+		 */
+		texture::extents get_extents() const;
+		/**
+		 * Retrieve the number of mip levels stored in the file.
+		 */
+		std::size_t get_mipmap_count() const;
+
+		/**
+		 * Retrieve the location of every image in the file, in file order.
+		 */
+		const std::vector<image>& get_images() const;
+
+	private:
+		// Parse the header of each supported container.
+		void parse_ktx2();
+		void parse_dds();
+		// Add an image at the given byte offset, checking it is within the
+		// file and has the size expected from the format and extents.
+		void add_image(std::size_t mip, std::size_t layer, std::size_t layers, std::size_t offset, std::size_t size);
+		// Calculate the size of an image of the given level and layer count.
+		std::size_t size_of_image(std::size_t mip, std::size_t layers) const;
+
+	private:
+		// The mapped file; images point into it.
+		mapped_file m_file;
+
+		GLenum m_target;
+		GLenum m_format;
+		// Whether the data is stored as BGR(A) rather than RGB(A).
+		bool m_reverse;
+		// The extents of the base level (unused components are `1`).
+		glm::uvec3 m_extents;
+		std::size_t m_levels;
+
+		std::vector<image> m_images;
+	};
+}
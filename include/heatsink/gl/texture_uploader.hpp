@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+#include <heatsink/gl/pixel_format.hpp>
+#include <heatsink/gl/ring_buffer.hpp>
+#include <heatsink/gl/texture.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * Streams texture updates through a persistently mapped pixel unpack
+	 * buffer. Each upload copies the data into the current frame of a
+	 * `ring_buffer` and queues a `texture::update()` from it, so the CPU copy
+	 * of one frame overlaps with the GPU transfers of the previous ones. With
+	 * the default of two frames, this is classic double-buffered PBO streaming
+	 * with the fencing handled by the ring buffer.
+	 */
+	class texture_uploader {
+	public:
+		/**
+		 * Create an uploader able to stage the given number of bytes per frame.
+		 * This should be at least the total size of every upload made between
+		 * two calls to `advance()`.
+		 */
+		texture_uploader(std::size_t size, std::size_t frames = 2);
+
+	public:
+		/**
+		 * Stage the pixel data pointed to by the given iterator range, and
+		 * update the given mip level of the texture (or view) from it. The
+		 * size requirements are the same as for `texture::update()`. An
+		 * exception is thrown if the current frame does not have enough space.
+		 */
+		template<std::contiguous_iterator Iterator>
+		void upload(texture::view, std::size_t mip, Iterator begin, Iterator end, pixel_format);
+
+		/**
+		 * Reserve staging space for a texture update that will be written
+		 * directly (for example, by a video decoder). Write the data through
+		 * `get_data()`, then pass the view to `texture::update()`.
+		 */
+		buffer::view allocate(std::size_t size);
+		/**
+		 * Retrieve a pointer to the mapped staging memory of the given view,
+		 * allocated during the current frame. See `ring_buffer::get_data()`.
+		 */
+		template<standard_layout T = GLubyte>
+		T* get_data(const buffer::view&);
+
+		/**
+		 * Finish the current frame of uploads; see `ring_buffer::advance()`.
+		 * This blocks only if the GPU is still reading the frame being reused.
+		 */
+		void advance();
+
+		/**
+		 * Retrieve the ring buffer backing the staging memory.
+		 */
+		const ring_buffer& get_ring_buffer() const;
+
+	private:
+		// The staging memory, targeted at `GL_PIXEL_UNPACK_BUFFER`.
+		ring_buffer m_ring;
+	};
+}
+
+namespace heatsink::gl {
+	template<std::contiguous_iterator Iterator>
+	void texture_uploader::upload(texture::view v, std::size_t mip, Iterator begin, Iterator end, pixel_format format) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(is_tensor_v<T>);
+
+		auto staging = m_ring.write(begin, end);
+		v.update(mip, staging, format);
+	}
+
+	template<standard_layout T>
+	T* texture_uploader::get_data(const buffer::view& v) {
+		return m_ring.get_data<T>(v);
+	}
+}
@@ -9,6 +9,7 @@
 #include <type_traits>
 
 #include <heatsink/error/debug.hpp>
+#include <heatsink/error/diagnostics.hpp>
 #include <heatsink/error/exception.hpp>
 #include <heatsink/platform/gl.hpp>
 #include <heatsink/traits/enum.hpp>
@@ -198,20 +199,22 @@ namespace heatsink::gl {
 	template<tensor T> requires (std::is_array_v<T> == false)
 	void uniform::update(const T& t) {
 		assert(this->is_valid());
-		if (this->is_array())
-			throw exception("gl::uniform", "cannot assign value to array uniform.");
-
 		constexpr auto datatype = make_enum_v<tensor_decay_t<T>>;
 		static_assert(datatype != GL_NONE);
 
-		if (!shader_traits::is_assignable(m_datatype, datatype)) {
-			make_error_stream("gl::uniform")
-				<< "cannot assign datatype "
-				<< to_string(datatype) << " "
-				<< "to uniform type "
-				<< to_string(m_datatype) << "." << std::endl;
+		if constexpr (has_validation) {
+			if (this->is_array())
+				throw exception("gl::uniform", "cannot assign value to array uniform.");
+
+			if (!shader_traits::is_assignable(m_datatype, datatype)) {
+				make_error_stream("gl::uniform")
+					<< "cannot assign datatype "
+					<< to_string(datatype) << " "
+					<< "to uniform type "
+					<< to_string(m_datatype) << "." << std::endl;
 
-			throw exception("gl::uniform", "type mismatch.");
+				throw exception("gl::uniform", "type mismatch.");
+			}
 		}
 
 		this->update_values(datatype, 1, address_of(t));
@@ -223,31 +226,33 @@ namespace heatsink::gl {
 		static_assert(is_tensor_v<T>);
 		
 		assert(this->is_valid());
-		// The iterators could represent a single value, but they still imply
-		// multiple values, so enforce the array here.
-		if (!this->is_array())
-			throw exception("gl::uniform", "cannot assign iterator range to uniform value.");
-
 		constexpr auto datatype = make_enum_v<tensor_decay_t<T>>;
 		static_assert(datatype != GL_NONE);
 
-		if (auto size = std::distance(begin, end); size != m_size) {
-			make_error_stream("gl::uniform")
-				<< "cannot assign array "
-				<< "(size=" << size << ") "
-				<< "to uniform view "
-				<< "(size=" << m_size << ")." << std::endl;
-
-			throw exception("gl::uniform", "array size mismatch.");
-		}
-		if (!shader_traits::is_assignable(m_datatype, datatype)) {
-			make_error_stream("gl::uniform")
-				<< "cannot assign datatype"
-				<< to_string(datatype) << " "
-				<< "to uniform array of type "
-				<< to_string(m_datatype) << "." << std::endl;
-
-			throw exception("gl::uniform", "type mismatch.");
+		if constexpr (has_validation) {
+			// The iterators could represent a single value, but they still
+			// imply multiple values, so enforce the array here.
+			if (!this->is_array())
+				throw exception("gl::uniform", "cannot assign iterator range to uniform value.");
+
+			if (auto size = std::distance(begin, end); size != m_size) {
+				make_error_stream("gl::uniform")
+					<< "cannot assign array "
+					<< "(size=" << size << ") "
+					<< "to uniform view "
+					<< "(size=" << m_size << ")." << std::endl;
+
+				throw exception("gl::uniform", "array size mismatch.");
+			}
+			if (!shader_traits::is_assignable(m_datatype, datatype)) {
+				make_error_stream("gl::uniform")
+					<< "cannot assign datatype"
+					<< to_string(datatype) << " "
+					<< "to uniform array of type "
+					<< to_string(m_datatype) << "." << std::endl;
+
+				throw exception("gl::uniform", "type mismatch.");
+			}
 		}
 
 		this->update_values(datatype, m_size, address_of(*begin));
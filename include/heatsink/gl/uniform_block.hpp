@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/layout.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * An OpenGL active uniform block. Instead of being set one value at a time
+	 * like a `uniform`, the contents of a block are sourced from a range of a
+	 * `GL_UNIFORM_BUFFER`; a whole block can then be updated with a single
+	 * buffer upload, and shared between programs. Like `uniform`, the lifetime
+	 * of a block is tied to the program it was introspected from.
+	 */
+	class uniform_block {
+	public:
+		/**
+		 * An active uniform declared within a block. All measurements are in
+		 * bytes, relative to the start of the block. The strides are zero if
+		 * the member is not an array or matrix, respectively.
+		 */
+		struct member {
+		public:
+			std::string name;
+			GLenum datatype;
+
+			std::size_t offset;
+			std::size_t size;
+			std::size_t array_stride;
+			std::size_t matrix_stride;
+		};
+
+	public:
+		/**
+		 * Retrieve information on all active uniform blocks in a program. This
+		 * creates a map of block names to their indices and layouts. Usually, a
+		 * program will call this function and track the results internally.
+		 */
+		static std::map<std::string, uniform_block> from_program(const class program&);
+
+	public:
+		/**
+		 * Construct a uniform block from a program and the name of the block
+		 * (not the instance name, if one is declared in the shader).
+		 */
+		uniform_block(const class program&, std::string name);
+
+	private:
+		// Create a uniform block from its index within the given program. This
+		// constructor is used by the public variant and introspection.
+		uniform_block(GLuint owner, GLuint index);
+
+	public:
+		/**
+		 * Assign the `GL_UNIFORM_BUFFER` binding index this block sources its
+		 * data from. This is program state; it only needs to be set once, and
+		 * several blocks (in different programs) may share a binding.
+		 */
+		void set_binding(std::size_t);
+		/**
+		 * Bind the given buffer range to the binding index of this block. The
+		 * view must be at least as large as the block, and its offset must be
+		 * a multiple of `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT`.
+		 */
+		void bind(const buffer::const_view&) const;
+
+		/**
+		 * Check that the members of this block, in order of their offsets, are
+		 * laid out the same as the given member types with the given layout
+		 * rules. This is the runtime counterpart of `is_block_compatible`; the
+		 * two together ensure a C++ struct can be copied into the block as-is.
+		 */
+		template<block_layout L, tensor... Members>
+		void validate() const;
+
+		/**
+		 * Check if the uniform block instance is valid. A block should be valid
+		 * unless it has thrown an exception (probably during construction).
+		 * Calling any member functions on an invalid block is undefined and
+		 * will usually raise an assertion.
+		 */
+		bool is_valid() const;
+
+		/**
+		 * Retrieve the index of this block within its program object.
+		 */
+		GLuint get() const;
+		/**
+		 * Retrieve the name of this block, as declared in the shader.
+		 */
+		const std::string& get_name() const;
+
+		/**
+		 * Retrieve the minimum number of bytes of buffer storage needed to
+		 * back this block (`GL_UNIFORM_BLOCK_DATA_SIZE`).
+		 */
+		std::size_t get_size() const;
+		/**
+		 * Retrieve the binding index currently assigned to this block.
+		 */
+		std::size_t get_binding() const;
+
+		/**
+		 * Retrieve the specified member, if it exists. Array members are named
+		 * without their `[0]` subscript, like individual uniforms.
+		 */
+		const member& get_member(const std::string&) const;
+		/**
+		 * Retrieve every active member of this block, sorted by offset.
+		 */
+		const std::vector<member>& get_members() const;
+
+	private:
+		// The OpenGL identifier of the owning program.
+		GLuint m_program;
+
+		// The index of this block within the owning program.
+		GLuint m_index;
+		// The string identifier of this block.
+		std::string m_name;
+
+		// The data size of the block, in bytes.
+		std::size_t m_size;
+		// The uniform buffer binding index assigned to this block.
+		std::size_t m_binding;
+		// The introspected members of this block, sorted by offset.
+		std::vector<member> m_members;
+	};
+}
+
+namespace heatsink::gl {
+	template<block_layout L, tensor... Members>
+	void uniform_block::validate() const {
+		assert(this->is_valid());
+		constexpr auto offsets = block_offsets_v<L, Members...>;
+
+		if (offsets.size() != m_members.size()) {
+			make_error_stream("gl::uniform_block")
+				<< "cannot match " << offsets.size() << " members "
+				<< "against uniform block "
+				<< "\"" << m_name << "\" "
+				<< "(members=" << m_members.size() << ")." << std::endl;
+
+			throw exception("gl::uniform_block", "block member count mismatch.");
+		}
+
+		for (std::size_t i = 0; i != offsets.size(); ++i) {
+			if (offsets[i] == m_members[i].offset)
+				continue;
+
+			make_error_stream("gl::uniform_block")
+				<< "member "
+				<< "\"" << m_members[i].name << "\" "
+				<< "of uniform block "
+				<< "\"" << m_name << "\" "
+				<< "is at offset " << m_members[i].offset << " "
+				<< "(expected=" << offsets[i] << ")." << std::endl;
+
+			throw exception("gl::uniform_block", "block layout mismatch.");
+		}
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <heatsink/gl/program.hpp>
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/enum.hpp>
+#include <heatsink/traits/memory.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * A CPU-side copy of the non-block uniforms of a program. Uniforms are
+	 * resolved by name once, to a `handle` that indexes directly into the
+	 * store; setting a value through a handle only writes to CPU memory, and
+	 * marks the uniform as dirty if the value changed. `flush()` then uploads
+	 * each dirty uniform with `glProgramUniform*()`, without needing the
+	 * program to be in use (without separate shader objects, the program is
+	 * used and `glUniform*()` is called instead). No strings are touched
+	 * after the handles have been resolved, so this is suitable for per-draw
+	 * material updates.
+	 *
+	 * The store must not outlive its program. Values set directly through a
+	 * `uniform` are not seen by the store, and may be overwritten by it.
+	 */
+	class uniform_state {
+	public:
+		/**
+		 * A resolved uniform of a `uniform_state`. Handles are only valid for
+		 * the store (or a store of the same program) they were created from.
+		 */
+		struct handle {
+		public:
+			std::size_t index;
+		};
+
+	public:
+		/**
+		 * Introspect the uniforms of a (finished) program. Every value starts
+		 * out unset; no uniform is flushed until it has been set once.
+		 */
+		uniform_state(const program&);
+
+	public:
+		/**
+		 * Resolve a uniform by name. An exception is thrown if the program has
+		 * no such active uniform. This should be called once, ahead of time.
+		 */
+		handle find(const std::string&) const;
+
+		/**
+		 * Set the shadowed value of a non-array uniform. The type is checked
+		 * like `uniform::update()`.
+		 */
+		template<tensor T> requires (std::is_array_v<T> == false)
+		void set(handle, const T&);
+		/**
+		 * Set the shadowed values of an array uniform; the size of the range
+		 * must match the uniform.
+		 */
+		template<std::contiguous_iterator Iterator>
+		void set(handle, Iterator begin, Iterator end);
+
+		/**
+		 * Upload every uniform that has changed since the last flush. This
+		 * should be called before drawing with the program.
+		 */
+		void flush();
+
+		/**
+		 * Check if any uniform is waiting to be flushed.
+		 */
+		bool is_dirty() const;
+		/**
+		 * Retrieve the OpenGL name of the program this store shadows.
+		 */
+		GLuint get_program() const;
+
+	private:
+		// The state of a single uniform. The value is stored as it was given
+		// (`assigned` is its type), at `offset` within the value storage.
+		struct slot {
+		public:
+			GLint location;
+			GLenum datatype;
+			std::size_t size;
+
+			GLenum assigned;
+			std::size_t offset;
+			std::size_t bytes;
+			bool dirty;
+		};
+
+	private:
+		// Type and size check a value, then copy it into the slot of a handle
+		// (marking it dirty) if it differs from the current value.
+		void set_values(handle, GLenum datatype, std::size_t count, const void* data, std::size_t bytes);
+		// Upload the current value of a slot with `glProgramUniform*()`, or
+		// with `glUniform*()` to the program in use if not `separate`.
+		void upload(const slot&, bool separate);
+
+	private:
+		GLuint m_program;
+
+		std::vector<slot> m_slots;
+		// The shadowed values of every slot, packed together.
+		std::vector<std::byte> m_values;
+		// The indices of the slots to upload on the next flush.
+		std::vector<std::size_t> m_dirty;
+		// Scratch space for converting boolean values to integers.
+		std::vector<GLint> m_scratch;
+
+		// The uniform names mapped to their slot, used by `find()`.
+		std::map<std::string, std::size_t> m_names;
+	};
+}
+
+namespace heatsink::gl {
+	template<tensor T> requires (std::is_array_v<T> == false)
+	void uniform_state::set(handle h, const T& t) {
+		constexpr auto datatype = make_enum_v<tensor_decay_t<T>>;
+		static_assert(datatype != GL_NONE);
+
+		this->set_values(h, datatype, 1, address_of(t), sizeof(T));
+	}
+
+	template<std::contiguous_iterator Iterator>
+	void uniform_state::set(handle h, Iterator begin, Iterator end) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(is_tensor_v<T>);
+
+		constexpr auto datatype = make_enum_v<tensor_decay_t<T>>;
+		static_assert(datatype != GL_NONE);
+
+		auto count = (std::size_t)std::distance(begin, end);
+		this->set_values(h, datatype, count, address_of(*begin), count * sizeof(T));
+	}
+}
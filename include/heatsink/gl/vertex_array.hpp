@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdlib>
+#include <vector>
+
 #include <heatsink/gl/attribute.hpp>
 #include <heatsink/gl/buffer.hpp>
 #include <heatsink/gl/object.hpp>
@@ -28,6 +31,18 @@ namespace heatsink::gl {
 			double_precision
 		};
 
+		/**
+		 * A buffer range attached to a vertex buffer binding point, used with
+		 * the separated format/binding API (see `set_attribute_format()`). The
+		 * stride is the distance between consecutive elements in the view;
+		 * usually `vertex_format::packing::stride`.
+		 */
+		struct binding {
+		public:
+			buffer::const_view view;
+			std::size_t stride;
+		};
+
 	public:
 		/**
 		 * Create a vertex array object. Note that no parameters are needed as
@@ -56,6 +71,47 @@ namespace heatsink::gl {
 		 */
 		void set_attribute(const attribute&, std::nullptr_t);
 
+		/**
+		 * Set the format of the specified attribute, and the vertex buffer
+		 * binding point it reads from, without attaching any buffer data. The
+		 * packing offset of the format is used as the offset relative to the
+		 * start of each element; the stride is given with the buffer in
+		 * `set_binding()`. The buffer data is always normalized to a floating
+		 * point range. This requires OpenGL 4.3 (`glVertexAttribFormat()`).
+		 * Note that `set_attribute()` uses the binding point with the same
+		 * index as each attribute location, so the two should not be mixed
+		 * on the same binding points.
+		 */
+		void set_attribute_format(const attribute&, vertex_format, std::size_t binding);
+		/**
+		 * Set the format of an attribute, specifying the conversion type. See
+		 * the above overload and `set_attribute()`.
+		 */
+		void set_attribute_format(const attribute&, vertex_format, std::size_t binding, conversion);
+
+		/**
+		 * Attach a buffer view to a vertex buffer binding point. Every
+		 * attribute whose format refers to the binding point reads from this
+		 * view; switching meshes with the same layout only needs this call.
+		 */
+		void set_binding(std::size_t index, buffer::const_view, std::size_t stride);
+		/**
+		 * Detach any buffer from the given vertex buffer binding point.
+		 */
+		void set_binding(std::size_t index, std::nullptr_t);
+		/**
+		 * Attach a set of buffer views to consecutive binding points, starting
+		 * at the first index given. On OpenGL 4.4 and above, this is done in a
+		 * single call (`glBindVertexBuffers()`).
+		 */
+		void set_bindings(std::size_t first, const std::vector<binding>&);
+		/**
+		 * Set the instance divisor of a vertex buffer binding point. With a
+		 * divisor of `0`, attributes advance once per vertex; otherwise, they
+		 * advance once every `divisor` instances.
+		 */
+		void set_binding_divisor(std::size_t index, std::size_t divisor);
+
 		/**
 		 * Set the `GL_ELEMENT_ARRAY_BUFFER` bind point to the given index
 		 * buffer. The buffer must already have been bound to this target.
@@ -69,5 +125,7 @@ namespace heatsink::gl {
 	private:
 		// Combined attribute setter for the normalized and conversion variants.
 		void set_attribute(const attribute&, vertex_format, buffer::const_view, conversion*);
+		// Combined format setter for the normalized and conversion variants.
+		void set_attribute_format(const attribute&, vertex_format, std::size_t binding, conversion*);
 	};
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include <heatsink/platform/gl.hpp>
 #include <heatsink/traits/enum.hpp>
+#include <heatsink/traits/memory.hpp>
 #include <heatsink/traits/tensor.hpp>
 
 namespace heatsink::gl {
@@ -107,6 +108,14 @@ namespace heatsink::gl {
 		static_assert(datatype != GL_NONE);
 
 		m_datatype = datatype;
+		if constexpr (is_packed(datatype)) {
+			// A packed value always holds four components, so any array
+			// dimension is the number of attribute indices.
+			static_assert(value_rank <= 1);
+			m_extents = extents(4, (value_rank == 1) ? std::extent_v<value_type, 0> : 1);
+			return;
+		}
+
 		switch (value_rank) {
 			case 2: {
 				// The "vector" dimension is the higher one. Assign to a
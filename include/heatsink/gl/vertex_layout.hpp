@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <heatsink/gl/attribute.hpp>
+#include <heatsink/gl/buffer.hpp>
+#include <heatsink/gl/vertex_array.hpp>
+#include <heatsink/gl/vertex_format.hpp>
+#include <heatsink/traits/memory.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * The arrangement of vertex data within a buffer.
+	 * - `interleaved`: each vertex is stored whole, one after another, as
+	 *   in an array of the vertex structure.
+	 * - `split`: each member is stored as its own contiguous array (a
+	 *   "structure of arrays"), one after another in the same buffer. A pass
+	 *   that only reads some attributes (like a depth-only or culling pass
+	 *   reading positions) then only fetches the memory of those attributes.
+	 */
+	enum class vertex_arrangement {
+		interleaved,
+		split
+	};
+
+	/**
+	 * The buffer layout of a vertex structure, with its attributes listed as
+	 * pointers-to-member (see `vertex_format`). The arrangement is chosen at
+	 * compile time; the same vertex type may be used with either, and the
+	 * layout converts an array of vertices to the matching buffer contents
+	 * and sets up the vertex array attributes that read from it.
+	 *
+	 * ```
+	 * using layout = vertex_layout<vertex_arrangement::split, vertex,
+	 *     &vertex::position, &vertex::normal, &vertex::uv>;
+	 *
+	 * auto data = layout::pack(vertices.begin(), vertices.end());
+	 * auto vbo  = buffer(GL_ARRAY_BUFFER, data.begin(), data.end());
+	 * layout::bind(vao, {position, normal, uv}, vbo, vertices.size());
+	 * // A position-only pass:
+	 * layout::bind_attribute<0>(depth_vao, position, vbo, vertices.size());
+	 * ```
+	 *
+	 * Attributes are bound through the separated format/binding API, so this
+	 * requires OpenGL 4.3. An interleaved layout uses a single vertex buffer
+	 * binding point, and a split layout uses one per member, starting at the
+	 * first binding given.
+	 */
+	template<vertex_arrangement Arrangement, standard_layout Vertex, auto... Members>
+	class vertex_layout {
+	public:
+		/**
+		 * The number of attributes described by the layout.
+		 */
+		static constexpr std::size_t size = sizeof...(Members);
+
+		/**
+		 * The arrangement of the layout.
+		 */
+		static constexpr vertex_arrangement arrangement = Arrangement;
+
+	public:
+		/**
+		 * Retrieve the number of bytes needed to store the given number of
+		 * vertices. A split layout pads each array to the alignment of the
+		 * next member.
+		 */
+		static constexpr std::size_t get_size(std::size_t count);
+		/**
+		 * Retrieve the byte offset of the first element of a member, and the
+		 * distance between consecutive elements of it, for a buffer of the
+		 * given number of vertices.
+		 */
+		template<std::size_t Index>
+		static constexpr vertex_format::packing get_packing(std::size_t count);
+
+		/**
+		 * Convert a range of vertices to the contents of a buffer with this
+		 * layout.
+		 */
+		template<std::contiguous_iterator Iterator>
+		static std::vector<std::byte> pack(Iterator begin, Iterator end);
+
+		/**
+		 * Set the format of every attribute of a vertex array, and attach the
+		 * regions of a buffer (with this layout, holding the given number of
+		 * vertices) that each one reads from. The attributes are given in the
+		 * same order as the member list.
+		 */
+		static void bind(vertex_array&, const std::array<attribute, size>&, const buffer::const_view&, std::size_t count, std::size_t first_binding = 0);
+		/**
+		 * Set the format of a single attribute, by its index in the member
+		 * list, and attach the region of the buffer it reads from. In a split
+		 * layout, no other member is fetched by the vertex array.
+		 */
+		template<std::size_t Index>
+		static void bind_attribute(vertex_array&, const attribute&, const buffer::const_view&, std::size_t count, std::size_t first_binding = 0);
+	};
+}
+
+namespace heatsink::gl {
+	namespace detail {
+		// Retrieve the type of a member of the vertex structure.
+		template<standard_layout Vertex, auto Member>
+		using vertex_member_t = std::remove_cvref_t<decltype(std::declval<Vertex&>().*Member)>;
+
+		// Retrieve the type of the member at an index of the member list.
+		template<standard_layout Vertex, std::size_t Index, auto... Members>
+		using vertex_member_at_t = vertex_member_t<Vertex, std::get<Index>(std::make_tuple(Members...))>;
+
+		// The alignment of each array of a split layout; attribute offsets
+		// must at least be aligned to four bytes.
+		template<class T>
+		constexpr std::size_t split_alignment_v = std::max<std::size_t>(alignof(T), 4);
+
+		constexpr std::size_t align_up(std::size_t value, std::size_t alignment) {
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	template<vertex_arrangement Arrangement, standard_layout Vertex, auto... Members>
+	constexpr std::size_t vertex_layout<Arrangement, Vertex, Members...>::get_size(std::size_t count) {
+		static_assert(size > 0);
+		static_assert((std::is_member_object_pointer_v<decltype(Members)> && ...));
+
+		if constexpr (Arrangement == vertex_arrangement::interleaved) {
+			return count * sizeof(Vertex);
+		} else {
+			std::size_t result = 0;
+			((result = detail::align_up(result, detail::split_alignment_v<detail::vertex_member_t<Vertex, Members>>)
+				+ count * sizeof(detail::vertex_member_t<Vertex, Members>)), ...);
+
+			return result;
+		}
+	}
+
+	template<vertex_arrangement Arrangement, standard_layout Vertex, auto... Members>
+	template<std::size_t Index>
+	constexpr vertex_format::packing vertex_layout<Arrangement, Vertex, Members...>::get_packing(std::size_t count) {
+		static_assert(Index < size);
+		constexpr auto member = std::get<Index>(std::make_tuple(Members...));
+
+		if constexpr (Arrangement == vertex_arrangement::interleaved) {
+			return {.stride = sizeof(Vertex), .offset = offset_of(member)};
+		} else {
+			// Sum the (aligned) sizes of every array before this one.
+			std::size_t offset = 0;
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				((offset = detail::align_up(offset, detail::split_alignment_v<detail::vertex_member_at_t<Vertex, Is, Members...>>)
+					+ count * sizeof(detail::vertex_member_at_t<Vertex, Is, Members...>)), ...);
+			}(std::make_index_sequence<Index>());
+
+			using T = detail::vertex_member_at_t<Vertex, Index, Members...>;
+			return {.stride = sizeof(T), .offset = detail::align_up(offset, detail::split_alignment_v<T>)};
+		}
+	}
+
+	template<vertex_arrangement Arrangement, standard_layout Vertex, auto... Members>
+	template<std::contiguous_iterator Iterator>
+	std::vector<std::byte> vertex_layout<Arrangement, Vertex, Members...>::pack(Iterator begin, Iterator end) {
+		using T = typename std::iterator_traits<Iterator>::value_type;
+		static_assert(std::is_same_v<std::remove_cv_t<T>, Vertex>);
+
+		auto count = (std::size_t)std::distance(begin, end);
+		std::vector<std::byte> result(get_size(count));
+		if (count == 0)
+			return result;
+
+		if constexpr (Arrangement == vertex_arrangement::interleaved) {
+			std::memcpy(result.data(), std::to_address(begin), result.size());
+		} else {
+			// Scatter each member into its own array.
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				([&] {
+					constexpr auto member = std::get<Is>(std::make_tuple(Members...));
+					using M = detail::vertex_member_at_t<Vertex, Is, Members...>;
+
+					auto* out = result.data() + get_packing<Is>(count).offset;
+					for (auto it = begin; it != end; ++it, out += sizeof(M))
+						std::memcpy(out, std::addressof((*it).*member), sizeof(M));
+				}(), ...);
+			}(std::make_index_sequence<size>());
+		}
+
+		return result;
+	}
+
+	template<vertex_arrangement Arrangement, standard_layout Vertex, auto... Members>
+	void vertex_layout<Arrangement, Vertex, Members...>::bind(vertex_array& vao, const std::array<attribute, size>& attributes,
+		const buffer::const_view& v, std::size_t count, std::size_t first_binding) {
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			(bind_attribute<Is>(vao, attributes[Is], v, count, first_binding), ...);
+		}(std::make_index_sequence<size>());
+	}
+
+	template<vertex_arrangement Arrangement, standard_layout Vertex, auto... Members>
+	template<std::size_t Index>
+	void vertex_layout<Arrangement, Vertex, Members...>::bind_attribute(vertex_array& vao, const attribute& a,
+		const buffer::const_view& v, std::size_t count, std::size_t first_binding) {
+		constexpr auto member = std::get<Index>(std::make_tuple(Members...));
+		auto inferred = vertex_format(member);
+		auto packing  = get_packing<Index>(count);
+
+		if constexpr (Arrangement == vertex_arrangement::interleaved) {
+			// Every member reads from the same binding, at its own offset.
+			vao.set_attribute_format(a, inferred, first_binding);
+			vao.set_binding(first_binding, v, packing.stride);
+		} else {
+			// Each member reads from the start of its own array, so the
+			// offset is applied to the binding instead of the format.
+			auto binding = first_binding + Index;
+			auto format  = vertex_format(inferred.get_datatype(), inferred.get_extents(), {.stride = packing.stride, .offset = 0});
+
+			vao.set_attribute_format(a, format, binding);
+			vao.set_binding(binding, buffer::const_view(v, packing.offset, count * packing.stride), packing.stride);
+		}
+	}
+}
@@ -2,11 +2,14 @@
 
 #include <compare>
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace heatsink {
 	/**
 	 * An initialized OpenGL context. Set up the OpenGL version and profile,
-	 * and load function pointers and extensions through GLEW.
+	 * and load function pointers and extensions through GLEW. Contexts are
+	 * created by GLFW, or optionally by EGL for headless rendering.
 	 */
 	class context {
 	public:
@@ -60,6 +63,23 @@ namespace heatsink {
 		 */
 		context(const class window&);
 
+		/**
+		 * Specify a headless context on the given GPU device (an index into
+		 * `get_devices()`). Headless contexts are created with EGL instead of
+		 * GLFW, and need neither a display server nor a window system; only
+		 * `window::offscreen()` may be created from them, and they render
+		 * through framebuffer objects. This requires a build with
+		 * `HEATSINK_EGL`; otherwise, an exception is thrown.
+		 */
+		static context headless(std::size_t device = 0, version = {.major = 3, .minor = 3}, profile = profile::any, bool debug = true);
+		/**
+		 * Enumerate the GPU devices available to headless contexts
+		 * (`EGL_EXT_device_enumeration`). Each entry names the device, with
+		 * its DRM device file where known (such as `/dev/dri/renderD128`).
+		 * This is empty in builds without `HEATSINK_EGL`.
+		 */
+		static std::vector<std::string> get_devices();
+
 		// A context is non-copyable; it may manage platform-specific resources.
 		context(const context&) = delete;
 		context(context&&) noexcept;
@@ -68,6 +88,10 @@ namespace heatsink {
 		context& operator =(const context&) = delete;
 		context& operator =(context&&);
 
+	private:
+		// Create a context without initializing GLFW; used by `headless()`.
+		context(std::nullptr_t);
+
 	public:
 		/**
 		 * Retrieve the platform-specific context handle, if one exists. This
@@ -94,6 +118,24 @@ namespace heatsink {
 		 * checks and messages within the OpenGL API.
 		 */
 		bool is_debug() const;
+		/**
+		 * Choose how debug messages are delivered to windows created from
+		 * this context. By default, debug output is asynchronous: messages
+		 * are queued by the driver and reported by `window::flush_buffers()`
+		 * (see `gl::debug_queue`). Synchronous output reports (or throws)
+		 * from inside the offending call, which makes errors easy to locate,
+		 * but serializes the driver (`GL_DEBUG_OUTPUT_SYNCHRONOUS`).
+		 */
+		void set_synchronous_debug(bool);
+		bool is_synchronous_debug() const;
+		/**
+		 * Check if this is a headless (EGL) context. See `headless()`.
+		 */
+		bool is_headless() const;
+		/**
+		 * Retrieve the GPU device index of a headless context.
+		 */
+		std::size_t get_device() const;
 
 	private:
 		// The platform backend may not always respect const-correctness; allow
@@ -104,5 +146,11 @@ namespace heatsink {
 		version m_version;
 		profile m_profile;
 		bool m_debug;
+		bool m_synchronous_debug;
+
+		// Whether the context is created by the EGL backend, and on which of
+		// its enumerated devices.
+		bool m_headless;
+		std::size_t m_device;
 	};
 }
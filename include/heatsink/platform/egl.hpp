@@ -0,0 +1,57 @@
+#pragma once
+
+// The EGL backend is optional; see `context::headless()`. Nothing is declared
+// here unless the library is built with `HEATSINK_EGL`.
+#if defined(HEATSINK_EGL)
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <epoxy/egl.h>
+
+#include <heatsink/platform/context.hpp>
+#include <heatsink/platform/window.hpp>
+
+namespace heatsink::egl {
+	/**
+	 * Enumerate the GPU devices known to EGL (`EGL_EXT_device_enumeration`).
+	 * The order is stable for the lifetime of the process. An exception is
+	 * thrown if the required client extensions are missing.
+	 */
+	const std::vector<EGLDeviceEXT>& get_devices();
+	/**
+	 * Retrieve a readable name for a device; its DRM device file if
+	 * `EGL_EXT_device_drm` is available, or its index otherwise.
+	 */
+	std::string get_device_name(std::size_t device);
+	/**
+	 * Retrieve the display of a device, initializing it on first use. Every
+	 * context on the same device shares the display, which is kept until the
+	 * process exits.
+	 */
+	EGLDisplay get_display(std::size_t device);
+}
+
+namespace heatsink {
+	/**
+	 * The EGL objects of a headless window, in place of its GLFW window. The
+	 * context parameters are kept so that shared contexts can be created
+	 * from the window (see `context(const window&)`).
+	 */
+	struct window::headless {
+	public:
+		EGLDisplay display;
+		EGLConfig config;
+		EGLContext context;
+		// A 1x1 pbuffer, if the surfaceless extension is not available.
+		EGLSurface surface;
+
+		std::size_t device;
+		context::version version;
+		context::profile profile;
+		bool debug;
+	};
+}
+
+#endif
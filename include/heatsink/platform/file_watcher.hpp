@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+namespace heatsink {
+	/**
+	 * Reports changes to a set of files, without blocking. The directory of
+	 * each file is watched rather than the file itself, so that files saved by
+	 * replacing them (as most editors do) are still reported. Changes are
+	 * detected with inotify on Linux and directory change notifications on
+	 * Windows; on other platforms, `poll()` compares modification times.
+	 */
+	class file_watcher {
+	public:
+		/**
+		 * Create a watcher with no files. An exception is thrown if the
+		 * platform notification mechanism cannot be initialized.
+		 */
+		file_watcher();
+
+		// A watcher releases its notification handles, so it can only be moved.
+		file_watcher(const file_watcher&) = delete;
+		file_watcher(file_watcher&&) noexcept;
+		~file_watcher();
+
+		file_watcher& operator =(const file_watcher&) = delete;
+		file_watcher& operator =(file_watcher&&) noexcept;
+
+	public:
+		/**
+		 * Start watching the given file. Watching a file more than once has
+		 * no effect. An exception is thrown if its directory cannot be watched.
+		 */
+		void watch(const std::filesystem::path&);
+		/**
+		 * Stop watching the given file.
+		 */
+		void unwatch(const std::filesystem::path&);
+
+		/**
+		 * Retrieve the (canonical) paths of every watched file that has
+		 * changed since the last call. Each file is reported at most once per
+		 * call, however many times it was written.
+		 */
+		std::vector<std::filesystem::path> poll();
+
+	private:
+		// A watched directory, with the modification time of each watched
+		// file within it (by filename). The handle is platform-specific.
+		struct directory {
+		public:
+			std::intptr_t handle;
+			std::map<std::filesystem::path, std::filesystem::file_time_type> files;
+		};
+
+	private:
+		// Release every platform handle and forget every file.
+		void reset();
+		// Check the modification times of the files in a directory, adding
+		// those that changed to the results.
+		static void compare_times(const std::filesystem::path&, directory&, std::vector<std::filesystem::path>&);
+
+	private:
+		// The watched directories, by canonical path.
+		std::map<std::filesystem::path, directory> m_directories;
+		// The inotify instance on Linux; unused elsewhere.
+		int m_inotify;
+	};
+}
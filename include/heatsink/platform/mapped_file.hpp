@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace heatsink {
+	/**
+	 * A read-only memory mapping of an entire file. The contents are paged in
+	 * by the operating system as they are accessed, so reading a file this way
+	 * does not allocate (or copy into) any memory proportional to its size.
+	 */
+	class mapped_file {
+	public:
+		/**
+		 * Create an invalid instance of a mapped file. `is_valid()` is
+		 * guaranteed to be `false` for an instance returned from this function.
+		 */
+		static mapped_file null();
+
+	public:
+		/**
+		 * Map the file at the given path. An exception is thrown if the file
+		 * cannot be opened or mapped. Empty files are valid, but have no data.
+		 */
+		mapped_file(const std::filesystem::path&);
+
+		// A mapping is released on destruction, so it can only be moved.
+		mapped_file(const mapped_file&) = delete;
+		mapped_file(mapped_file&&) noexcept;
+		~mapped_file();
+
+		mapped_file& operator =(const mapped_file&) = delete;
+		mapped_file& operator =(mapped_file&&) noexcept;
+
+	private:
+		// Create an invalid instance of a mapped file (a proxy for `null()`).
+		mapped_file(std::nullptr_t);
+
+	public:
+		/**
+		 * Check if the mapping instance is valid. A mapping should be valid
+		 * unless it was created with `null()` or has been moved from.
+		 */
+		bool is_valid() const;
+
+		/**
+		 * Retrieve a pointer to the first byte of the mapped file. This is
+		 * `nullptr` for an empty file.
+		 */
+		const std::byte* get_data() const;
+		/**
+		 * Retrieve the size of the mapped file, in bytes.
+		 */
+		std::size_t get_size() const;
+
+	private:
+		// Release the mapping (if any), and reset to an invalid instance.
+		void reset();
+
+	private:
+		// The mapped view of the file, and its size.
+		const std::byte* m_data;
+		std::size_t m_size;
+		// Whether this instance owns a mapping (empty files have no data).
+		bool m_valid;
+	};
+}
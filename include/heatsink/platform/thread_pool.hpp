@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace heatsink {
+	/**
+	 * A fixed set of worker threads that load-balance by work stealing. Each
+	 * worker has its own queue; jobs submitted from a worker are pushed onto
+	 * its own queue (and run newest first, while their data is still in
+	 * cache), and an idle worker steals the oldest job from another worker's
+	 * queue. Jobs receive the index of the worker running them, which can be
+	 * used to select per-thread state without locking, such as one
+	 * `gl::command_buffer` per worker.
+	 */
+	class thread_pool {
+	public:
+		/**
+		 * A unit of work, called with the index of the worker running it.
+		 */
+		using job = std::function<void(std::size_t worker)>;
+
+	public:
+		/**
+		 * Start the given number of worker threads; by default, one for each
+		 * hardware thread.
+		 */
+		thread_pool(std::size_t threads = std::thread::hardware_concurrency());
+
+		// The workers refer to the pool, so it can be neither copied nor moved.
+		thread_pool(const thread_pool&) = delete;
+		~thread_pool();
+
+		thread_pool& operator =(const thread_pool&) = delete;
+
+	public:
+		/**
+		 * Queue a job to be run by any worker.
+		 */
+		void submit(job);
+		/**
+		 * Queue a job for each index in `[0, count)`, and wait for all of them
+		 * (and any other submitted jobs) to finish. See `wait()`.
+		 */
+		void parallel_for(std::size_t count, const std::function<void(std::size_t index, std::size_t worker)>&);
+
+		/**
+		 * Block until every submitted job has finished. If any job threw an
+		 * exception, the first one is rethrown here. This must not be called
+		 * from within a job.
+		 */
+		void wait();
+
+		/**
+		 * Retrieve the number of worker threads.
+		 */
+		std::size_t get_thread_count() const;
+
+	private:
+		// The queue owned by a single worker.
+		struct queue {
+		public:
+			std::mutex mutex;
+			std::deque<job> jobs;
+		};
+
+	private:
+		// Run jobs on a worker thread until the pool is destroyed.
+		void run(std::size_t worker);
+		// Take a job from the worker's own queue, or steal one from another.
+		bool take(std::size_t worker, job&);
+
+	private:
+		std::vector<std::unique_ptr<queue>> m_queues;
+
+		// Guards the counters below, which the condition variables wait on.
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+		// The number of jobs queued but not yet taken, and the number of jobs
+		// submitted but not yet finished.
+		std::size_t m_queued;
+		std::size_t m_pending;
+		bool m_stopping;
+		std::exception_ptr m_error;
+
+		// The queue to push the next job from a non-worker thread into.
+		std::atomic<std::size_t> m_next;
+		std::vector<std::thread> m_threads;
+	};
+}
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <cstdlib>
+#include <memory>
 #include <string>
 
 #include <glm/glm.hpp>
 
 #include <heatsink/platform/context.hpp>
 
+namespace heatsink::gl {
+	// The state is only held by pointer; see `gl/context_state.hpp`.
+	class context_state;
+	// Asynchronous debug messages are queued; see `gl/debug_queue.hpp`.
+	class debug_queue;
+	// Frames can be paced when swapped; see `gl/frame_pacer.hpp`.
+	class frame_pacer;
+}
+
 namespace heatsink {
 	/**
 	 * A wrapper for a native window handle. The actual backend used may depend
@@ -21,6 +32,11 @@ namespace heatsink {
 	private:
 		// Allow callbacks to access internal member variables.
 		struct callbacks;
+		// The EGL state of a headless window; see `platform/egl.hpp`.
+		struct headless;
+
+		// Contexts created from a headless window read its EGL state.
+		friend class context;
 
 	public:
 		/**
@@ -35,6 +51,8 @@ namespace heatsink {
 		 * the user, but the window must still interact with the message loop as
 		 * normal. Note that no size may be passed, as the window buffer may be
 		 * unusable depending on the window manager; use framebuffers instead.
+		 * If the context is headless, no native window is created at all; see
+		 * `context::headless()`.
 		 */
 		static window offscreen(const context&);
 
@@ -59,14 +77,33 @@ namespace heatsink {
 	private:
 		// Create an invalid instance of a window (a proxy for `null()`).
 		window(std::nullptr_t);
+		// Create a headless window with EGL; used by `offscreen()`.
+		static window make_headless(const context&);
+
+		// Create the context state of a new window, and install the debug
+		// message handler. The context must already be current.
+		void initialize(const context&);
+		// Release the native window or EGL objects, if any.
+		void reset();
+		// Swap buffers and process events; see `flush_buffers()`.
+		bool present(gl::frame_pacer*) const;
 
 	public:
 		/**
 		 * Set the OpenGL state machine to use this window for drawing. This is
 		 * always called during construction, so it only needs to be called when
-		 * handling multiple windows.
+		 * handling multiple windows. The `gl::context_state` of the window is
+		 * made current on the calling thread as well.
 		 */
 		void use() const;
+		/**
+		 * Detach the context of this window from the calling thread, if it is
+		 * current there. A context must not be current on any thread when its
+		 * window is destroyed, or the windowing system defers (and in practice
+		 * leaks) its destruction; this matters when a window is used by one
+		 * thread and destroyed by another.
+		 */
+		void release() const;
 
 		/**
 		 * Swap window buffers and handle any pending messages for this window.
@@ -74,13 +111,40 @@ namespace heatsink {
 		 * is returned, for example, when a close/quit signal is received.
 		 */
 		bool flush_buffers() const;
+		/**
+		 * Swap window buffers like the above overload, pacing the frame with
+		 * the given pacer: the frame is ended before the swap, and the next
+		 * frame begun after it (which may block until the GPU catches up),
+		 * before any events are processed so that input is as recent as
+		 * possible. The same pacer should be used for every frame.
+		 */
+		bool flush_buffers(gl::frame_pacer&) const;
+		/**
+		 * Set the number of vertical blanks to wait for before each swap (`0`
+		 * disables vsync). With `adaptive`, a swap that misses a vertical
+		 * blank happens immediately instead of waiting for the next one,
+		 * trading tearing for less stutter (`EXT_swap_control_tear`). Returns
+		 * `false` if adaptive vsync was requested but is not supported, in
+		 * which case the interval is used as is. The window is made current;
+		 * this has no effect on headless windows.
+		 */
+		bool set_swap_interval(std::size_t interval, bool adaptive = false);
 		/**
 		 * Output any errors that have accumlated since the last time this
 		 * method was invoked. This uses the old-fashioned `glGetError()` to
 		 * pop all errors from the OpenGL stack; note that the callback variant
-		 * (refer to `message_callback`) supercedes this.
+		 * (refer to `message_callback`) supercedes this. Queued debug messages
+		 * are reported first, as with `flush_messages()`.
 		 */
 		void flush_errors() const;
+		/**
+		 * Report the debug messages queued by the driver since the last call,
+		 * if the context uses asynchronous debug output (the default; see
+		 * `context::set_synchronous_debug()`). This is called once per frame
+		 * by `flush_buffers()`. Every message is written to the error stream,
+		 * then an exception is thrown if any of them were errors.
+		 */
+		void flush_messages() const;
 
 		/**
 		 * Check if the window instance is valid. A window should be valid
@@ -89,6 +153,11 @@ namespace heatsink {
 		 * it is likely to raise an assertion.
 		 */
 		bool is_valid() const;
+		/**
+		 * Check if the window was created from a headless context, and has no
+		 * native window (or default framebuffer).
+		 */
+		bool is_headless() const;
 		/**
 		 * Retrieve a pointer to the raw window handle. Use with caution; the
 		 * pointer is still managed by the instance, and changes made directly
@@ -112,6 +181,14 @@ namespace heatsink {
 		// The platform backend may not always respect const-correctness; allow
 		// the handle to be passed as a mutable pointer regardless of constness.
 		mutable void* m_handle;
+		// The state of the window context. This is held by pointer so that it
+		// keeps the same address when the window is moved.
+		std::unique_ptr<gl::context_state> m_state;
+		// The EGL objects used in place of the handle by headless windows.
+		std::unique_ptr<headless> m_headless;
+		// The queue filled by the debug callback, if debug output is
+		// asynchronous. The driver refers to it by address.
+		std::unique_ptr<gl::debug_queue> m_messages;
 
 		// The apparent and actual window sizes.
 		extents m_extents;
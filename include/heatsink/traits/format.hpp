@@ -13,8 +13,6 @@ namespace heatsink::gl {
 	 * because they work on enums instead of types, they do not take a template
 	 * parameter and instead take an argument directly. This allows them to work
 	 * during runtime as well (which is more common in this library).
-	 *
-	 * FIXME: provide compressed texture support.
 	 */
 	class format_traits {
 	public:
@@ -54,6 +52,32 @@ namespace heatsink::gl {
 		 */
 		static constexpr std::pair<GLenum, GLenum> reverse(GLenum);
 
+		/**
+		 * Check if the given image format is a block-compressed format (S3TC/
+		 * BCn, RGTC, BPTC, ETC2/EAC, or ASTC). Compressed formats have no pixel
+		 * format; their data is uploaded in whole blocks instead.
+		 */
+		static constexpr bool is_compressed(GLenum);
+		/**
+		 * Calculate the width and height of a single block of a compressed
+		 * image format (for example, `4x4` for every BCn format). Uncompressed
+		 * formats are treated as having `1x1` blocks.
+		 */
+		static constexpr std::pair<std::size_t, std::size_t> block_extents(GLenum);
+		/**
+		 * Calculate the number of bytes a single block of a compressed image
+		 * format consumes; this is either `8` or `16` for every supported
+		 * format. Returns `0` for uncompressed formats.
+		 */
+		static constexpr std::size_t block_size(GLenum);
+		/**
+		 * Calculate the number of bytes an image of the given size consumes
+		 * in a compressed format. Partial blocks (at the edges of an image, or
+		 * at small mip levels) are rounded up to a whole block. Each layer
+		 * (depth) is compressed separately.
+		 */
+		static constexpr std::size_t compressed_size(GLenum, std::size_t width, std::size_t height, std::size_t depth = 1);
+
 	private:
 		// Prevent a `format_traits` object from being constructed.
 		format_traits() = default;
@@ -295,7 +319,33 @@ namespace heatsink::gl {
 			case GL_SRGB_ALPHA:      return GL_RGBA;
 			case GL_SRGB8_ALPHA8:    return GL_RGBA;
 
-			default: return GL_NONE;
+			default: break;
+		}
+
+		// Compressed formats are reduced to their base internal format.
+		switch (e) {
+			case GL_COMPRESSED_RED_RGTC1:
+			case GL_COMPRESSED_SIGNED_RED_RGTC1:
+			case GL_COMPRESSED_R11_EAC:
+			case GL_COMPRESSED_SIGNED_R11_EAC:
+				return GL_RED;
+
+			case GL_COMPRESSED_RG_RGTC2:
+			case GL_COMPRESSED_SIGNED_RG_RGTC2:
+			case GL_COMPRESSED_RG11_EAC:
+			case GL_COMPRESSED_SIGNED_RG11_EAC:
+				return GL_RG;
+
+			case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+			case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+			case GL_COMPRESSED_RGB8_ETC2:
+			case GL_COMPRESSED_SRGB8_ETC2:
+				return GL_RGB;
+
+			default:
+				return is_compressed(e) ? GL_RGBA : GL_NONE;
 		}
 	}
 
@@ -341,4 +391,138 @@ namespace heatsink::gl {
 		else
 			return std::pair<GLenum, GLenum>(GL_NONE, GL_NONE);
 	}
+	constexpr bool format_traits::is_compressed(GLenum e) {
+		return (block_size(e) != 0);
+	}
+
+	constexpr std::pair<std::size_t, std::size_t> format_traits::block_extents(GLenum e) {
+		using result = std::pair<std::size_t, std::size_t>;
+		switch (e) {
+			case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR:
+				return result(4, 4);
+			case GL_COMPRESSED_RGBA_ASTC_5x4_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR:
+				return result(5, 4);
+			case GL_COMPRESSED_RGBA_ASTC_5x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR:
+				return result(5, 5);
+			case GL_COMPRESSED_RGBA_ASTC_6x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR:
+				return result(6, 5);
+			case GL_COMPRESSED_RGBA_ASTC_6x6_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR:
+				return result(6, 6);
+			case GL_COMPRESSED_RGBA_ASTC_8x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR:
+				return result(8, 5);
+			case GL_COMPRESSED_RGBA_ASTC_8x6_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR:
+				return result(8, 6);
+			case GL_COMPRESSED_RGBA_ASTC_8x8_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR:
+				return result(8, 8);
+			case GL_COMPRESSED_RGBA_ASTC_10x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR:
+				return result(10, 5);
+			case GL_COMPRESSED_RGBA_ASTC_10x6_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR:
+				return result(10, 6);
+			case GL_COMPRESSED_RGBA_ASTC_10x8_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR:
+				return result(10, 8);
+			case GL_COMPRESSED_RGBA_ASTC_10x10_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR:
+				return result(10, 10);
+			case GL_COMPRESSED_RGBA_ASTC_12x10_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR:
+				return result(12, 10);
+			case GL_COMPRESSED_RGBA_ASTC_12x12_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR:
+				return result(12, 12);
+
+			default:
+				// Every other compressed format (BCn and ETC2/EAC) uses 4x4 blocks.
+				return is_compressed(e) ? result(4, 4) : result(1, 1);
+		}
+	}
+
+	constexpr std::size_t format_traits::block_size(GLenum e) {
+		switch (e) {
+			// BC1 (DXT1) and BC4.
+			case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_RED_RGTC1:
+			case GL_COMPRESSED_SIGNED_RED_RGTC1:
+				return 8;
+			// BC2 (DXT3), BC3 (DXT5), BC5, BC6H, and BC7.
+			case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+			case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+			case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+			case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+			case GL_COMPRESSED_RG_RGTC2:
+			case GL_COMPRESSED_SIGNED_RG_RGTC2:
+			case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+			case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+			case GL_COMPRESSED_RGBA_BPTC_UNORM:
+			case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+				return 16;
+
+			case GL_COMPRESSED_RGB8_ETC2:
+			case GL_COMPRESSED_SRGB8_ETC2:
+			case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+			case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+			case GL_COMPRESSED_R11_EAC:
+			case GL_COMPRESSED_SIGNED_R11_EAC:
+				return 8;
+			case GL_COMPRESSED_RGBA8_ETC2_EAC:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+			case GL_COMPRESSED_RG11_EAC:
+			case GL_COMPRESSED_SIGNED_RG11_EAC:
+				return 16;
+
+			// Every ASTC block is 128 bits, regardless of its footprint.
+			case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_5x4_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_5x5_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_6x5_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_6x6_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_8x5_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_8x6_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_8x8_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_10x5_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_10x6_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_10x8_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_10x10_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_12x10_KHR:
+			case GL_COMPRESSED_RGBA_ASTC_12x12_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR:
+			case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR:
+				return 16;
+
+			default: return 0;
+		}
+	}
+
+	constexpr std::size_t format_traits::compressed_size(GLenum e, std::size_t width, std::size_t height, std::size_t depth) {
+		auto [bw, bh] = block_extents(e);
+		auto columns  = (width  + bw - 1) / bw;
+		auto rows     = (height + bh - 1) / bh;
+
+		return columns * rows * depth * block_size(e);
+	}
 }
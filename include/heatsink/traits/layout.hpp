@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <type_traits>
+
+#include <heatsink/platform/gl.hpp>
+#include <heatsink/traits/memory.hpp>
+#include <heatsink/traits/tensor.hpp>
+
+namespace heatsink::gl {
+	/**
+	 * The memory layout rules of an interface block, as declared in a shader
+	 * with `layout(std140)` or `layout(std430)`. Both are fixed layouts, so
+	 * they can be matched by a C++ struct; they differ in that `std140` rounds
+	 * the alignment of arrays (and of matrix columns) up to that of a `vec4`.
+	 * Note that `std430` is only available for shader storage blocks.
+	 */
+	enum class block_layout {
+		std140,
+		std430
+	};
+
+	/**
+	 * The base alignment of a tensor type when used as a member of a block
+	 * with the given layout. The shader type is deduced from the tensor:
+	 * - Arithmetic types are scalars (note that a shader `bool` is 4 bytes).
+	 * - Class tensors of rank 1 (like `glm::vec3`) are vectors.
+	 * - Class tensors of rank 2 (like `glm::mat4`) are column-major matrices.
+	 * - Builtin arrays (like `glm::vec4[8]`) are shader arrays.
+	 */
+	template<block_layout L, tensor T>
+	struct block_alignment;
+	template<block_layout L, tensor T>
+	constexpr auto block_alignment_v = block_alignment<L, T>::value;
+
+	/**
+	 * The number of bytes a tensor type occupies as a block member with the
+	 * given layout. For arrays and matrices, this includes the padding of each
+	 * element/column up to the array stride. See `block_alignment`.
+	 */
+	template<block_layout L, tensor T>
+	struct block_size;
+	template<block_layout L, tensor T>
+	constexpr auto block_size_v = block_size<L, T>::value;
+
+	/**
+	 * The byte offsets of each member in a block with the given layout, where
+	 * the members are declared in the order of the type parameters.
+	 */
+	template<block_layout L, tensor... Members>
+	struct block_offsets;
+	template<block_layout L, tensor... Members>
+	constexpr auto block_offsets_v = block_offsets<L, Members...>::value;
+
+	/**
+	 * Determine whether a C++ struct, declared with the given member types (in
+	 * order, without `alignas`), has the same member offsets as a block with
+	 * the given layout. The size of the struct is also checked against the
+	 * member list, to catch lists that do not describe the struct. A struct
+	 * that does not match can usually be fixed with explicit padding members.
+	 *
+	 * ```
+	 * struct material {
+	 *     glm::vec3 color;
+	 *     float roughness;
+	 *     glm::mat4 transform;
+	 * };
+	 * static_assert(is_block_compatible_v<block_layout::std140, material, glm::vec3, float, glm::mat4>);
+	 * ```
+	 */
+	template<block_layout L, standard_layout Struct, tensor... Members>
+	struct is_block_compatible;
+	template<block_layout L, standard_layout Struct, tensor... Members>
+	constexpr auto is_block_compatible_v = is_block_compatible<L, Struct, Members...>::value;
+}
+
+namespace heatsink::gl {
+	namespace detail {
+		// Round the value up to the nearest multiple of the alignment.
+		constexpr std::size_t block_align_up(std::size_t value, std::size_t align) {
+			return ((value + align - 1) / align) * align;
+		}
+
+		// The layout of an array with the given element alignment and size.
+		// Matrices are laid out as arrays of their column vectors.
+		template<block_layout L, std::size_t Align, std::size_t Size, std::size_t Count>
+		struct block_array {
+		public:
+			// Arrays in `std140` are always aligned to (at least) a `vec4`.
+			static constexpr std::size_t alignment = (L == block_layout::std140)
+				? block_align_up(Align, 16)
+				: Align;
+			static constexpr std::size_t stride = block_align_up(Size, alignment);
+			static constexpr std::size_t size   = stride * Count;
+		};
+
+		// Compute the layout of a single block member. This is specialized
+		// based on the kind of tensor; see `block_alignment`.
+		template<block_layout L, class T>
+		struct block_member;
+
+		// A scalar is aligned to its own size in both layouts.
+		template<block_layout L, class T> requires (std::is_arithmetic_v<T>)
+		struct block_member<L, T> {
+		public:
+			// Shader booleans are stored as 32-bit values.
+			static constexpr std::size_t size      = std::is_same_v<T, bool> ? 4 : sizeof(T);
+			static constexpr std::size_t alignment = size;
+		};
+
+		// A builtin array is a shader array of its element type.
+		template<block_layout L, class T> requires (std::is_array_v<T>)
+		struct block_member<L, T> {
+		private:
+			using element = block_member<L, std::remove_extent_t<T>>;
+			using array   = block_array<L, element::alignment, element::size, std::extent_v<T>>;
+
+		public:
+			static constexpr std::size_t size      = array::size;
+			static constexpr std::size_t alignment = array::alignment;
+		};
+
+		// A class tensor is either a vector or a matrix, based on its rank.
+		template<block_layout L, class T> requires (std::is_class_v<T>)
+		struct block_member<L, T> {
+		private:
+			using decay = tensor_decay_t<T>;
+			static_assert(std::rank_v<decay> == 1 || std::rank_v<decay> == 2);
+
+			using component = std::remove_all_extents_t<decay>;
+			// Vectors use the scalar rules for their components.
+			static constexpr std::size_t scalar = block_member<L, component>::size;
+			static constexpr std::size_t rows   = std::extent_v<decay, std::rank_v<decay> - 1>;
+
+			// A two- or four-component vector is aligned to its size, while a
+			// three-component vector is aligned as if it had four components.
+			static constexpr std::size_t vector_size      = scalar * rows;
+			static constexpr std::size_t vector_alignment = scalar * ((rows == 2) ? 2 : 4);
+
+			// A matrix is an array of its columns (the outermost dimension).
+			using columns = block_array<L, vector_alignment, vector_size, std::extent_v<decay, 0>>;
+			static constexpr bool is_matrix = (std::rank_v<decay> == 2);
+
+		public:
+			static constexpr std::size_t size      = is_matrix ? columns::size      : vector_size;
+			static constexpr std::size_t alignment = is_matrix ? columns::alignment : vector_alignment;
+		};
+
+		// Compute the offsets of each member type, given the size/alignment of
+		// each; used for both the block layout and the C++ struct layout.
+		template<std::size_t N>
+		constexpr std::array<std::size_t, N> block_layout_offsets(
+			const std::array<std::size_t, N>& sizes, const std::array<std::size_t, N>& aligns) {
+			std::array<std::size_t, N> results = {};
+			std::size_t end = 0;
+
+			for (std::size_t i = 0; i != N; ++i) {
+				results[i] = block_align_up(end, aligns[i]);
+				end = results[i] + sizes[i];
+			}
+
+			return results;
+		}
+
+		// Compute the size of a C++ struct with the given members (in order).
+		template<class... Members>
+		constexpr std::size_t struct_size() {
+			constexpr std::size_t N = sizeof...(Members);
+			constexpr std::array<std::size_t, N> sizes  = {sizeof(Members)...};
+			constexpr std::array<std::size_t, N> aligns = {alignof(Members)...};
+
+			auto offsets = block_layout_offsets(sizes, aligns);
+			auto align   = std::max({std::size_t{1}, alignof(Members)...});
+			return block_align_up(offsets[N - 1] + sizes[N - 1], align);
+		}
+	}
+
+	template<block_layout L, tensor T>
+	struct block_alignment : std::integral_constant<std::size_t,
+		detail::block_member<L, std::remove_cvref_t<T>>::alignment
+	> {};
+
+	template<block_layout L, tensor T>
+	struct block_size : std::integral_constant<std::size_t,
+		detail::block_member<L, std::remove_cvref_t<T>>::size
+	> {};
+
+	template<block_layout L, tensor... Members>
+	struct block_offsets {
+	public:
+		static constexpr std::array<std::size_t, sizeof...(Members)> value = detail::block_layout_offsets(
+			std::array<std::size_t, sizeof...(Members)>{block_size_v<L, Members>...},
+			std::array<std::size_t, sizeof...(Members)>{block_alignment_v<L, Members>...}
+		);
+	};
+
+	template<block_layout L, standard_layout Struct, tensor... Members>
+	struct is_block_compatible : std::bool_constant<
+		(sizeof...(Members) > 0) &&
+		(sizeof(Struct) == detail::struct_size<Members...>()) &&
+		(block_offsets_v<L, Members...> == detail::block_layout_offsets(
+			std::array<std::size_t, sizeof...(Members)>{sizeof(Members)...},
+			std::array<std::size_t, sizeof...(Members)>{alignof(Members)...}
+		))
+	> {};
+}
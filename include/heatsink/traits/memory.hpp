@@ -46,7 +46,7 @@ namespace heatsink {
 	template<standard_layout T>
 	constexpr const auto* address_of(T& t) {
 		if constexpr (is_tensor_v<T>) {
-			using element_type = std::remove_all_extents<tensor_decay_t<T>>;
+			using element_type = std::remove_all_extents_t<tensor_decay_t<T>>;
 			return reinterpret_cast<const element_type*>(std::addressof(t));
 		} else {
 			return std::addressof(t);
@@ -74,6 +74,7 @@ namespace heatsink {
 			case GL_UNSIGNED_BYTE:                  return sizeof(GLubyte);
 			case GL_UNSIGNED_SHORT:                 return sizeof(GLushort);
 			case GL_UNSIGNED_INT:                   return sizeof(GLuint);
+			case GL_HALF_FLOAT:                     return sizeof(GLhalf);
 			case GL_FLOAT:                          return sizeof(GLfloat);
 			case GL_DOUBLE:                         return sizeof(GLdouble);
 
@@ -91,6 +92,7 @@ namespace heatsink {
 			case GL_UNSIGNED_INT_8_8_8_8_REV:       return sizeof(GLuint);
 			case GL_UNSIGNED_INT_10_10_10_2:        return sizeof(GLuint);
 			case GL_UNSIGNED_INT_2_10_10_10_REV:    return sizeof(GLuint);
+			case GL_INT_2_10_10_10_REV:             return sizeof(GLuint);
 			case GL_UNSIGNED_INT_5_9_9_9_REV:       return sizeof(GLuint);
 
 			case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: return sizeof(GLfloat) + sizeof(GLint);
@@ -115,6 +117,7 @@ namespace heatsink {
 			case GL_UNSIGNED_INT_8_8_8_8_REV:
 			case GL_UNSIGNED_INT_10_10_10_2:
 			case GL_UNSIGNED_INT_2_10_10_10_REV:
+			case GL_INT_2_10_10_10_REV:
 			case GL_UNSIGNED_INT_5_9_9_9_REV:
 			case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
 				return true;
@@ -39,13 +39,16 @@ namespace heatsink::gl {
 	public:
 		/**
 		 * Create a new instance of an OpenGL object state, as specified by the
-		 * type template parameter.
+		 * type template parameter. Objects that have a bind target take it as
+		 * an argument, as `glCreate*()` (used with direct state access) may
+		 * need it to create the object with the correct type.
 		 */
-		static GLuint create();
+		static GLuint create(...);
 		/**
 		 * Destroy an existing instance of an OpenGL object state. The object
 		 * passed here must have been created with the same object enumeration
-		 * that is being used to destroy it.
+		 * that is being used to destroy it. Any bindings of the object are
+		 * reset in the binding shadow of the current `context_state`.
 		 */
 		static void destroy(GLuint);
 
@@ -54,6 +57,8 @@ namespace heatsink::gl {
 		 * in the type. This will require a mixture of object name, bind target,
 		 * and bind unit, depending on the `variable` and `image` parameters of
 		 * this target. Note that the order is always `name, target, unit`.
+		 * The call is skipped if the current `context_state` shows the name is
+		 * already bound (queries are never skipped, as binding begins them).
 		 */
 		static void bind(GLuint name, ...);
 
@@ -73,7 +78,7 @@ namespace heatsink::gl {
 		static constexpr bool has_image_unit = false;
 
 	public:
-		static GLuint create();
+		static GLuint create(GLenum target);
 		static void destroy(GLuint);
 
 		static void bind(GLuint name, GLenum target);
@@ -88,7 +93,7 @@ namespace heatsink::gl {
 		static constexpr bool has_image_unit = false;
 
 	public:
-		static GLuint create();
+		static GLuint create(GLenum target);
 		static void destroy(GLuint);
 
 		static void bind(GLuint name, GLenum target);
@@ -118,7 +123,7 @@ namespace heatsink::gl {
 		static constexpr bool has_image_unit = false;
 
 	public:
-		static GLuint create();
+		static GLuint create(GLenum target);
 		static void destroy(GLuint);
 
 		static void bind(GLuint name, GLenum target);
@@ -163,7 +168,7 @@ namespace heatsink::gl {
 		static constexpr bool has_image_unit = true;
 
 	public:
-		static GLuint create();
+		static GLuint create(GLenum target);
 		static void destroy(GLuint);
 
 		static void bind(GLuint name, GLenum target, std::size_t unit);
@@ -178,7 +183,7 @@ namespace heatsink::gl {
 		static constexpr bool has_image_unit = false;
 
 	public:
-		static GLuint create();
+		static GLuint create(GLenum target);
 		static void destroy(GLuint);
 
 		static void bind(GLuint name, GLenum target);
@@ -2,6 +2,8 @@
 
 #include <cstdlib>
 
+#include <glm/glm.hpp>
+
 #include <heatsink/platform/gl.hpp>
 
 namespace heatsink::gl {
@@ -41,10 +43,18 @@ namespace heatsink::gl {
 		 */
 		static constexpr std::size_t rank(GLenum);
 
+		/**
+		 * Query the virtual page size of a sparse texture with the given
+		 * target and internal format (`GL_VIRTUAL_PAGE_SIZE_*_ARB`). Unlike the
+		 * other traits, this depends on the implementation, so a context must
+		 * be current. Returns zero if the format cannot be sparse.
+		 */
+		static glm::uvec3 page_size(GLenum, GLenum ifmt);
+
 	private:
 		// Prevent a `texture_traits` object from being constructed.
 		texture_traits() = default;
-	}
+	};
 }
 
 namespace heatsink::gl {
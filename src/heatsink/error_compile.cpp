@@ -85,4 +85,11 @@ namespace heatsink::gl {
 		auto msg = read_log(name, glGetProgramiv, glGetProgramInfoLog);
 		write_log(os, msg, from);
 	}
+
+	void write_pipeline_log(std::ostream& os, GLuint name, const std::string& from) {
+		assert(name);
+
+		auto msg = read_log(name, glGetProgramPipelineiv, glGetProgramPipelineInfoLog);
+		write_log(os, msg, from);
+	}
 }
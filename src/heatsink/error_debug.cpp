@@ -1,12 +1,24 @@
 #include <heatsink/error/debug.hpp>
 
+#include <heatsink/error/diagnostics.hpp>
+
+#if HEATSINK_DIAGNOSTICS > 0
 #include <iostream>
+#endif
 
 using namespace std::string_literals;
 
 namespace heatsink {
 	std::ostream& make_error_stream(const std::string& where) {
+#if HEATSINK_DIAGNOSTICS > 0
 		return (std::cerr << "[heatsink::" << where << "] ");
+#else
+		// A stream without a buffer is always in a failed state, so that any
+		// output is discarded without being formatted.
+		(void)where;
+		static std::ostream g_discard(nullptr);
+		return g_discard;
+#endif
 	}
 }
 
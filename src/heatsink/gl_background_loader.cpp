@@ -0,0 +1,87 @@
+#include <heatsink/gl/background_loader.hpp>
+
+#include <heatsink/gl/texture_file.hpp>
+#include <heatsink/platform/context.hpp>
+
+namespace {
+	// Create a context sharing objects with the given window. Debug output is
+	// synchronous, as nothing drains the message queue of the hidden window;
+	// errors are thrown from within the job, and reach its future.
+	heatsink::context make_shared_context(const heatsink::window& shared) {
+		heatsink::context result(shared);
+		result.set_synchronous_debug(true);
+
+		return result;
+	}
+}
+
+namespace heatsink::gl {
+	background_loader::background_loader(const window& shared)
+	: m_window{window::offscreen(make_shared_context(shared))}, m_stopping{false} {
+		// Creating the hidden window made its context current on this thread.
+		shared.use();
+		m_thread = std::thread([this] { this->run(); });
+	}
+
+	background_loader::~background_loader() {
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopping = true;
+		}
+
+		m_condition.notify_one();
+		m_thread.join();
+	}
+
+	std::future<texture> background_loader::load_texture(const std::filesystem::path& path) {
+		return this->submit([path] {
+			// Creating the texture also uploads every image of the file.
+			return texture_file(path).create();
+		});
+	}
+
+	std::future<shader> background_loader::load_shader(std::string source, GLenum stage, std::string from) {
+		return this->submit([source = std::move(source), stage, from = std::move(from)] {
+			return shader(source, stage, from);
+		});
+	}
+
+	std::size_t background_loader::get_pending_count() const {
+		std::lock_guard lock(m_mutex);
+		return m_jobs.size();
+	}
+
+	void background_loader::run() {
+		m_window.use();
+
+		while (true) {
+			std::function<void()> job;
+			{
+				std::unique_lock lock(m_mutex);
+				m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+
+				// Jobs still queued on destruction are abandoned; their futures
+				// report a broken promise. The context is released so that it
+				// can be destroyed by the thread destroying the loader.
+				if (m_stopping) {
+					m_window.release();
+					return;
+				}
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+
+	void background_loader::enqueue(std::function<void()> job) {
+		{
+			std::lock_guard lock(m_mutex);
+			m_jobs.push_back(std::move(job));
+		}
+
+		m_condition.notify_one();
+	}
+}
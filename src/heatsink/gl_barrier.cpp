@@ -0,0 +1,11 @@
+#include <heatsink/gl/barrier.hpp>
+
+namespace heatsink::gl {
+	void memory_barrier(barrier bits) {
+		glMemoryBarrier(static_cast<GLbitfield>(bits));
+	}
+
+	void memory_barrier_by_region(barrier bits) {
+		glMemoryBarrierByRegion(static_cast<GLbitfield>(bits));
+	}
+}
@@ -1,5 +1,7 @@
 #include <heatsink/gl/buffer.hpp>
 
+#include <heatsink/gl/context_state.hpp>
+
 namespace heatsink::gl {
 	buffer buffer::immutable(GLenum target, std::size_t size, GLbitfield access) {
 		if (size == 0)
@@ -35,8 +37,14 @@ namespace heatsink::gl {
 
 	buffer::buffer(GLenum target, std::size_t size, const void* data, GLbitfield access)
 	: object<GL_BUFFER>(target), m_immutable{true}, m_base{}, m_size{size} {
-		this->bind();
-		glBufferStorage(this->get_target(), (GLsizeiptr)m_size, data, access);
+		if (has_direct_state_access()) {
+			glNamedBufferStorage(this->get(), (GLsizeiptr)m_size, data, access);
+		} else {
+			this->bind();
+			glBufferStorage(this->get_target(), (GLsizeiptr)m_size, data, access);
+		}
+
+		memory_tracker::allocate(GL_BUFFER, this->get(), m_size);
 	}
 
 	void buffer::set(std::size_t size, GLenum usage) {
@@ -45,10 +53,44 @@ namespace heatsink::gl {
 			throw exception("gl::buffer", "cannot reallocate immutable buffer.");
 
 		m_size = size;
+		if (m_size == 0)
+			return;
 
-		this->bind();
-		if (m_size != 0)
+		if (has_direct_state_access()) {
+			glNamedBufferData(this->get(), (GLsizeiptr)m_size, nullptr, usage);
+		} else {
+			this->bind();
 			glBufferData(this->get_target(), (GLsizeiptr)m_size, nullptr, usage);
+		}
+
+		memory_tracker::allocate(GL_BUFFER, this->get(), m_size);
+	}
+
+	void buffer::copy(const const_view& src) {
+		assert(this->is_valid());
+		if (src.get_size() != m_size) {
+			make_error_stream("gl::buffer")
+				<< "cannot copy buffer view "
+				<< "(size=" << src.get_size() << ") "
+				<< "to buffer "
+				<< "(size=" << m_size << ")." << std::endl;
+
+			throw exception("gl::buffer", "buffer copy size mismatch.");
+		}
+
+		if (m_size == 0)
+			return;
+
+		auto read  = (GLintptr)src.get_offset();
+		auto write = (GLintptr)m_base;
+		if (has_direct_state_access()) {
+			glCopyNamedBufferSubData(src.get(), this->get(), read, write, (GLsizeiptr)m_size);
+		} else {
+			// The copy targets exist so that no other binding is disturbed.
+			name_traits<GL_BUFFER>::bind(src.get(), GL_COPY_READ_BUFFER);
+			name_traits<GL_BUFFER>::bind(this->get(), GL_COPY_WRITE_BUFFER);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, read, write, (GLsizeiptr)m_size);
+		}
 	}
 
 	void buffer::invalidate() {
@@ -57,8 +99,13 @@ namespace heatsink::gl {
 		if (this->is_empty())
 			return;
 
-		this->bind();
-		glInvalidateBufferSubData(this->get_target(), (GLintptr)m_base, (GLsizeiptr)m_size);
+		// Unlike most buffer commands, this takes the buffer name directly.
+		glInvalidateBufferSubData(this->get(), (GLintptr)m_base, (GLsizeiptr)m_size);
+	}
+
+	buffer::const_view buffer::make_view(std::size_t offset, std::size_t size) const {
+		assert(this->is_valid());
+		return const_view(*this, offset, size);
 	}
 
 	buffer::view buffer::make_view(std::size_t offset, std::size_t size) {
@@ -66,6 +113,17 @@ namespace heatsink::gl {
 		return view(*this, offset, size);
 	}
 
+	void buffer::bind_range(std::size_t index) const {
+		assert(this->is_valid());
+		if (this->is_empty())
+			throw exception("gl::buffer", "cannot bind empty buffer range.");
+
+		auto target = this->get_target();
+		glBindBufferRange(target, (GLuint)index, this->get(), (GLintptr)m_base, (GLsizeiptr)m_size);
+		// An indexed bind also replaces the generic binding of the target.
+		context_state::get_current().invalidate_binding(GL_BUFFER, target);
+	}
+
 	bool buffer::is_immutable() const {
 		assert(this->is_valid());
 		return m_immutable;
@@ -88,4 +146,9 @@ namespace heatsink::gl {
 	buffer::const_view buffer::const_view::make_view(std::size_t offset, std::size_t size) const {
 		return buffer::make_view(offset, size);
 	}
+
+	buffer::view::operator const_view() const {
+		// The buffer base already represents the range of this view.
+		return const_view(static_cast<const buffer&>(*this));
+	}
 }
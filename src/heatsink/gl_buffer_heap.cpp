@@ -0,0 +1,233 @@
+#include <heatsink/gl/buffer_heap.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+#include <utility>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Round up to a multiple of the alignment, which need not be a power of
+	// two (such as a vertex stride of 12 bytes).
+	std::size_t align_up(std::size_t value, std::size_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+namespace heatsink::gl {
+	buffer_heap::buffer_heap(GLenum target, std::size_t pool_size)
+	: m_target{target}, m_pool_size{pool_size}, m_next{0} {}
+
+	buffer_heap::handle buffer_heap::allocate(std::size_t size, std::size_t alignment) {
+		if (alignment == 0)
+			throw exception("gl::buffer_heap", "allocation alignment must be non-zero.");
+
+		size = align_up(std::max<std::size_t>(size, 1), alignment);
+		if (size > m_pool_size) {
+			make_error_stream("gl::buffer_heap")
+				<< "cannot allocate range "
+				<< "(size=" << size << ") "
+				<< "larger than heap pools "
+				<< "(size=" << m_pool_size << ")." << std::endl;
+
+			throw exception("gl::buffer_heap", "allocation too large.");
+		}
+
+		auto h = m_next++;
+		for (std::size_t i = 0; i != m_pools.size(); ++i) {
+			if (this->allocate(i, h, size, alignment))
+				return h;
+		}
+
+		auto& p = m_pools.emplace_back(pool{
+			.storage     = buffer::immutable(m_target, m_pool_size, GL_DYNAMIC_STORAGE_BIT),
+			.ranges      = {},
+			.sizes       = {},
+			.allocations = {}
+		});
+		this->insert_range(p, 0, m_pool_size);
+
+		// A new pool always fits, as the size was checked against it.
+		[[maybe_unused]] auto success = this->allocate(m_pools.size() - 1, h, size, alignment);
+		assert(success);
+		return h;
+	}
+
+	void buffer_heap::free(handle h) {
+		auto it = m_allocations.find(h);
+		if (it == m_allocations.end())
+			throw exception("gl::buffer_heap", "unknown allocation handle.");
+
+		auto& a = it->second;
+		auto& p = m_pools[a.pool];
+		p.allocations.erase(a.offset);
+		this->insert_range(p, a.offset, a.size);
+
+		m_allocations.erase(it);
+	}
+
+	std::size_t buffer_heap::defragment(std::size_t budget) {
+		std::size_t moved = 0;
+		for (auto& p : m_pools) {
+			std::size_t cursor = 0;
+			auto changed = false;
+
+			// Slide each allocation down to the end of the previous one. The
+			// offsets only decrease, so the order of allocations is unchanged.
+			std::map<std::size_t, handle> compacted;
+			for (auto [offset, h] : p.allocations) {
+				auto& a = m_allocations.at(h);
+				auto target = align_up(cursor, a.alignment);
+
+				if (target < offset && moved + a.size <= budget) {
+					this->move(p, a, target);
+					moved += a.size;
+					changed = true;
+				}
+
+				compacted.emplace(a.offset, h);
+				cursor = a.offset + a.size;
+			}
+
+			if (changed) {
+				p.allocations = std::move(compacted);
+				this->rebuild_ranges(p);
+			}
+		}
+
+		return moved;
+	}
+
+	buffer::view buffer_heap::make_view(handle h) {
+		const auto& a = m_allocations.at(h);
+		return m_pools[a.pool].storage.make_view(a.offset, a.size);
+	}
+
+	buffer::const_view buffer_heap::make_view(handle h) const {
+		const auto& a = m_allocations.at(h);
+		return m_pools[a.pool].storage.make_view(a.offset, a.size);
+	}
+
+	const buffer& buffer_heap::get_buffer(handle h) const {
+		return m_pools[m_allocations.at(h).pool].storage;
+	}
+
+	std::size_t buffer_heap::get_offset(handle h) const {
+		return m_allocations.at(h).offset;
+	}
+
+	std::size_t buffer_heap::get_size(handle h) const {
+		return m_allocations.at(h).size;
+	}
+
+	buffer_heap::statistics buffer_heap::get_statistics() const {
+		statistics s{};
+		s.pool_count       = m_pools.size();
+		s.allocation_count = m_allocations.size();
+		s.capacity         = m_pools.size() * m_pool_size;
+
+		std::size_t free = 0;
+		for (const auto& p : m_pools) {
+			for (const auto& [offset, size] : p.ranges) {
+				free += size;
+				s.largest_free_size = std::max(s.largest_free_size, size);
+			}
+		}
+
+		s.used_size     = s.capacity - free;
+		s.occupancy     = s.capacity ? (float)s.used_size / (float)s.capacity : 0.0f;
+		s.fragmentation = free ? 1.0f - (float)s.largest_free_size / (float)free : 0.0f;
+		return s;
+	}
+
+	bool buffer_heap::allocate(std::size_t index, handle h, std::size_t size, std::size_t alignment) {
+		auto& p = m_pools[index];
+
+		// Search from the smallest range that could fit; alignment padding
+		// means that the first one is not always large enough.
+		for (auto it = p.sizes.lower_bound(size); it != p.sizes.end(); ++it) {
+			auto [range_size, range_offset] = *it;
+			auto offset = align_up(range_offset, alignment);
+			if (offset + size > range_offset + range_size)
+				continue;
+
+			this->erase_range(p, range_offset);
+			if (offset != range_offset)
+				this->insert_range(p, range_offset, offset - range_offset);
+			if (auto end = offset + size; end != range_offset + range_size)
+				this->insert_range(p, end, range_offset + range_size - end);
+
+			p.allocations.emplace(offset, h);
+			m_allocations.emplace(h, allocation{index, offset, size, alignment});
+			return true;
+		}
+
+		return false;
+	}
+
+	void buffer_heap::insert_range(pool& p, std::size_t offset, std::size_t size) {
+		auto next = p.ranges.lower_bound(offset);
+		if (next != p.ranges.end() && offset + size == next->first) {
+			size += next->second;
+			this->erase_range(p, next->first);
+		}
+
+		auto prev = p.ranges.lower_bound(offset);
+		if (prev != p.ranges.begin()) {
+			--prev;
+			if (prev->first + prev->second == offset) {
+				offset = prev->first;
+				size  += prev->second;
+				this->erase_range(p, offset);
+			}
+		}
+
+		p.ranges.emplace(offset, size);
+		p.sizes.emplace(size, offset);
+	}
+
+	void buffer_heap::erase_range(pool& p, std::size_t offset) {
+		auto it = p.ranges.find(offset);
+		assert(it != p.ranges.end());
+
+		auto [first, last] = p.sizes.equal_range(it->second);
+		p.sizes.erase(std::find_if(first, last, [&](const auto& entry) {
+			return entry.second == offset;
+		}));
+		p.ranges.erase(it);
+	}
+
+	void buffer_heap::rebuild_ranges(pool& p) {
+		p.ranges.clear();
+		p.sizes.clear();
+
+		std::size_t cursor = 0;
+		for (auto [offset, h] : p.allocations) {
+			if (offset != cursor)
+				this->insert_range(p, cursor, offset - cursor);
+
+			cursor = offset + m_allocations.at(h).size;
+		}
+
+		if (cursor != m_pool_size)
+			this->insert_range(p, cursor, m_pool_size - cursor);
+	}
+
+	void buffer_heap::move(pool& p, allocation& a, std::size_t offset) {
+		assert(offset < a.offset);
+
+		// Copies within the same buffer must not overlap, so the data is moved
+		// in pieces no larger than the distance it travels. Each piece is only
+		// written over data that has already been copied.
+		auto distance = a.offset - offset;
+		for (std::size_t i = 0; i < a.size; i += distance) {
+			auto size = std::min(distance, a.size - i);
+			auto dst  = p.storage.make_view(offset + i, size);
+			dst.copy(std::as_const(p.storage).make_view(a.offset + i, size));
+		}
+
+		a.offset = offset;
+	}
+}
@@ -0,0 +1,107 @@
+#include <heatsink/gl/build_queue.hpp>
+
+#include <cassert>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/shader.hpp>
+
+namespace heatsink::gl {
+	build_queue::build_queue(std::size_t threads)
+	: m_next{0} {
+		if (!context_state::get_current().has_parallel_shader_compile())
+			return;
+
+		// `0xFFFFFFFF` is the initial value, letting the driver decide.
+		glMaxShaderCompilerThreadsKHR(threads ? (GLuint)threads : 0xFFFFFFFF);
+	}
+
+	build_queue::ticket build_queue::submit_files(const std::vector<std::filesystem::path>& paths) {
+		assert(!paths.empty());
+
+		// The deferred shaders are only flagged for deletion here; OpenGL
+		// keeps them alive until the program detaches them in `finish()`.
+		std::vector<shader> shaders;
+		for (const auto& p : paths)
+			shaders.push_back(shader::deferred(shader::read_source(p), shader::to_stage(p), p.filename().string()));
+
+		// Use the same base name as `program::from_files()`.
+		auto from = paths.front();
+		while (!from.extension().empty())
+			from = from.stem();
+
+		return this->submit({shaders.begin(), shaders.end()}, from.string());
+	}
+
+	build_queue::ticket build_queue::submit(const std::vector<program::shader_name>& shaders, const std::string& from) {
+		auto t = m_next++;
+		m_entries.emplace(t, entry{program::deferred(shaders, from), false, nullptr});
+
+		return t;
+	}
+
+	std::size_t build_queue::poll() {
+		std::size_t pending = 0;
+		for (auto& [t, e] : m_entries) {
+			if (e.finished)
+				continue;
+
+			if (e.result.is_complete())
+				finish(e);
+			else
+				++pending;
+		}
+
+		return pending;
+	}
+
+	void build_queue::wait() {
+		for (auto& [t, e] : m_entries) {
+			if (!e.finished)
+				finish(e);
+		}
+	}
+
+	bool build_queue::is_ready(ticket t) const {
+		auto it = m_entries.find(t);
+		if (it == m_entries.end())
+			throw exception("gl::build_queue", "unknown build ticket.");
+
+		return it->second.finished || it->second.result.is_complete();
+	}
+
+	program build_queue::take(ticket t) {
+		auto it = m_entries.find(t);
+		if (it == m_entries.end())
+			throw exception("gl::build_queue", "unknown build ticket.");
+
+		auto e = std::move(it->second);
+		m_entries.erase(it);
+
+		if (!e.finished)
+			finish(e);
+		if (e.error)
+			std::rethrow_exception(e.error);
+
+		return std::move(e.result);
+	}
+
+	std::size_t build_queue::get_pending_count() const {
+		std::size_t pending = 0;
+		for (const auto& [t, e] : m_entries) {
+			if (!e.finished)
+				++pending;
+		}
+
+		return pending;
+	}
+
+	void build_queue::finish(entry& e) {
+		e.finished = true;
+		try {
+			e.result.finish();
+		} catch (const exception&) {
+			e.error = std::current_exception();
+		}
+	}
+}
@@ -0,0 +1,161 @@
+#include <heatsink/gl/command_buffer.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Commands are padded so that each header starts on this boundary.
+	constexpr std::size_t g_alignment = 8;
+
+	// Round a size up to the command alignment.
+	std::size_t align(std::size_t size) {
+		return (size + g_alignment - 1) / g_alignment * g_alignment;
+	}
+
+	// Retrieve the size of an index of the given type.
+	std::size_t get_index_size(GLenum type) {
+		switch (type) {
+			case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+			case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+			case GL_UNSIGNED_INT:   return sizeof(GLuint);
+			default:
+				heatsink::make_error_stream("gl::command_buffer")
+					<< "invalid index type " << type << "." << std::endl;
+
+				throw heatsink::exception("gl::command_buffer", "invalid index type.");
+		}
+	}
+
+	// Copy a trivially copyable payload out of the arena.
+	template<typename T>
+	T read(const std::byte* data) {
+		T result;
+		std::memcpy(&result, data, sizeof(T));
+		return result;
+	}
+}
+
+namespace heatsink::gl {
+	command_buffer::command_buffer(std::uint64_t key)
+	: m_key{key}, m_commands{0} {}
+
+	void command_buffer::use_program(const program& p) {
+		this->push(opcode::use_program, &p);
+	}
+
+	void command_buffer::bind_vertex_array(const vertex_array& vao) {
+		this->push(opcode::bind_vertex_array, &vao);
+	}
+
+	void command_buffer::draw_arrays(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+		this->push(opcode::draw_arrays, draw_command{mode, 0, count, instances, first, 0, 0});
+	}
+
+	void command_buffer::draw_elements(GLenum mode, GLenum type, GLsizei count, std::size_t first, GLint base_vertex, GLsizei instances) {
+		auto offset = first * get_index_size(type);
+		this->push(opcode::draw_elements, draw_command{mode, type, count, instances, 0, base_vertex, offset});
+	}
+
+	void command_buffer::reset() {
+		m_arena.clear();
+		m_views.clear();
+		m_commands = 0;
+	}
+
+	void command_buffer::execute() const {
+		// The stores set since the last draw, which must be flushed before
+		// the next one. This is usually one or two, so a vector suffices.
+		std::vector<uniform_state*> dirty;
+
+		const auto* data = m_arena.data();
+		const auto* end  = data + m_arena.size();
+		while (data != end) {
+			auto h = read<header>(data);
+			const auto* payload = data + sizeof(header);
+
+			switch (h.op) {
+				case opcode::use_program:
+					read<const program*>(payload)->use();
+					break;
+				case opcode::bind_vertex_array:
+					read<const vertex_array*>(payload)->bind();
+					break;
+				case opcode::set_uniform: {
+					auto cmd = read<uniform_command>(payload);
+					cmd.setter(*cmd.state, cmd.handle, payload + sizeof(cmd));
+					if (std::find(dirty.begin(), dirty.end(), cmd.state) == dirty.end())
+						dirty.push_back(cmd.state);
+					break;
+				}
+				case opcode::update_buffer: {
+					auto cmd = read<update_command>(payload);
+					const auto* bytes = payload + sizeof(cmd);
+
+					// The view is only borrowed; `update()` is not const.
+					auto v = m_views[cmd.view];
+					v.update(bytes, bytes + cmd.size);
+					break;
+				}
+				case opcode::draw_arrays:
+				case opcode::draw_elements: {
+					for (auto* s : dirty)
+						s->flush();
+					dirty.clear();
+
+					auto cmd = read<draw_command>(payload);
+					if (h.op == opcode::draw_arrays)
+						glDrawArraysInstanced(cmd.mode, cmd.first, cmd.count, cmd.instances);
+					else
+						glDrawElementsInstancedBaseVertex(cmd.mode, cmd.count, cmd.type, reinterpret_cast<const void*>(cmd.offset), cmd.instances, cmd.base_vertex);
+					break;
+				}
+			}
+
+			data = payload + h.size;
+		}
+	}
+
+	std::uint64_t command_buffer::get_key() const {
+		return m_key;
+	}
+
+	void command_buffer::set_key(std::uint64_t key) {
+		m_key = key;
+	}
+
+	std::size_t command_buffer::get_command_count() const {
+		return m_commands;
+	}
+
+	std::size_t command_buffer::get_size() const {
+		return m_arena.size();
+	}
+
+	void command_buffer::execute(const std::vector<const command_buffer*>& buffers) {
+		auto sorted = buffers;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) {
+			return a->m_key < b->m_key;
+		});
+
+		for (const auto* b : sorted)
+			b->execute();
+	}
+
+	std::byte* command_buffer::push(opcode op, std::size_t size) {
+		auto padded = align(size);
+		assert(padded <= UINT32_MAX);
+
+		auto offset = m_arena.size();
+		m_arena.resize(offset + sizeof(header) + padded);
+
+		header h = {op, (std::uint32_t)padded};
+		std::memcpy(m_arena.data() + offset, &h, sizeof(h));
+
+		++m_commands;
+		return m_arena.data() + offset + sizeof(header);
+	}
+}
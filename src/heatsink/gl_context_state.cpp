@@ -0,0 +1,181 @@
+#include <heatsink/gl/context_state.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace {
+	using context_state = heatsink::gl::context_state;
+
+	// The state made current through `set_current()` (usually by a window).
+	thread_local context_state* g_current = nullptr;
+	// The state used for contexts that were not made current by heatsink.
+	thread_local std::unique_ptr<context_state> g_fallback;
+
+	// Pack an object type, target, and unit into a binding key. Object types
+	// and targets are all 16-bit enumerations, which leaves 32 bits for units.
+	std::uint64_t make_key(GLenum type, GLenum target, std::size_t unit) {
+		return ((std::uint64_t)type << 48) | ((std::uint64_t)target << 32) | (std::uint32_t)unit;
+	}
+
+	// Retrieve the object type portion of a binding key.
+	GLenum key_type(std::uint64_t key) {
+		return (GLenum)(key >> 48);
+	}
+}
+
+namespace heatsink::gl {
+	context_state& context_state::get_current() {
+		if (g_current)
+			return *g_current;
+
+		if (!g_fallback)
+			g_fallback = std::make_unique<context_state>();
+
+		return *g_fallback;
+	}
+
+	void context_state::set_current(context_state* state) {
+		g_current = state;
+	}
+
+	context_state::context_state()
+	: m_statistics{} {
+		GLint major, minor;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+		m_version.major = (std::size_t)major;
+		m_version.minor = (std::size_t)minor;
+
+		m_parallel_compile = epoxy_has_gl_extension("GL_KHR_parallel_shader_compile")
+			|| epoxy_has_gl_extension("GL_ARB_parallel_shader_compile");
+		m_bindless = epoxy_has_gl_extension("GL_ARB_bindless_texture");
+		m_indirect_parameters = m_version >= context::version{4,6}
+			|| epoxy_has_gl_extension("GL_ARB_indirect_parameters");
+		m_separate_shader_objects = m_version >= context::version{4,1}
+			|| epoxy_has_gl_extension("GL_ARB_separate_shader_objects");
+
+		m_max_work_group_count = glm::uvec3(0);
+		if (m_version >= context::version{4,3} || epoxy_has_gl_extension("GL_ARB_compute_shader")) {
+			for (GLuint i = 0; i != 3; ++i) {
+				GLint count = 0;
+				glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, i, &count);
+				m_max_work_group_count[i] = (unsigned)count;
+			}
+		}
+	}
+
+	context_state::~context_state() {
+		// Never leave a dangling reference to this state.
+		if (g_current == this)
+			g_current = nullptr;
+	}
+
+	context::version context_state::get_version() const {
+		return m_version;
+	}
+
+	bool context_state::has_direct_state_access() const {
+		return (m_version >= context::version{4,5});
+	}
+
+	bool context_state::has_parallel_shader_compile() const {
+		return m_parallel_compile;
+	}
+
+	bool context_state::has_bindless_texture() const {
+		return m_bindless;
+	}
+
+	bool context_state::has_indirect_parameters() const {
+		return m_indirect_parameters;
+	}
+
+	bool context_state::has_separate_shader_objects() const {
+		return m_separate_shader_objects;
+	}
+
+	glm::uvec3 context_state::get_max_work_group_count() const {
+		return m_max_work_group_count;
+	}
+
+	bool context_state::set_binding(GLenum type, GLenum target, std::size_t unit, GLuint name) {
+		auto [it, inserted] = m_bindings.try_emplace(make_key(type, target, unit), name);
+		if (!inserted && it->second == name) {
+			++m_statistics.hits;
+			return false;
+		}
+
+		it->second = name;
+		++m_statistics.misses;
+		return true;
+	}
+
+	void context_state::invalidate_binding(GLenum type, GLenum target, std::size_t unit) {
+		m_bindings.erase(make_key(type, target, unit));
+	}
+
+	void context_state::invalidate_bindings() {
+		m_bindings.clear();
+		m_pixel_store.clear();
+	}
+
+	void context_state::release_name(GLenum type, GLuint name) {
+		for (auto& [key, bound] : m_bindings) {
+			if (bound == name && key_type(key) == type)
+				bound = 0;
+		}
+	}
+
+	GLint context_state::set_pixel_store(GLenum pname, GLint value) {
+		auto it = m_pixel_store.find(pname);
+		if (it == m_pixel_store.end()) {
+			GLint current = 0;
+			glGetIntegerv(pname, &current);
+			it = m_pixel_store.emplace(pname, current).first;
+		}
+
+		auto previous = std::exchange(it->second, value);
+		if (previous != value)
+			glPixelStorei(pname, value);
+
+		return previous;
+	}
+
+	bool context_state::set_resident(GLuint name, GLuint64 handle) {
+		return m_resident.try_emplace(name, handle).second;
+	}
+
+	GLuint64 context_state::clear_resident(GLuint name) {
+		auto it = m_resident.find(name);
+		if (it == m_resident.end())
+			return 0;
+
+		auto handle = it->second;
+		m_resident.erase(it);
+		return handle;
+	}
+
+	bool context_state::is_resident(GLuint name) const {
+		return m_resident.contains(name);
+	}
+
+	context_state::binding_statistics context_state::get_binding_statistics() const {
+		return m_statistics;
+	}
+
+	void context_state::reset_binding_statistics() {
+		m_statistics = {};
+	}
+
+	pixel_store_scope::pixel_store_scope(GLenum pname, GLint value)
+	: m_pname{pname}, m_previous{context_state::get_current().set_pixel_store(pname, value)} {}
+
+	pixel_store_scope::~pixel_store_scope() {
+		context_state::get_current().set_pixel_store(m_pname, m_previous);
+	}
+
+	bool has_direct_state_access() {
+		return context_state::get_current().has_direct_state_access();
+	}
+}
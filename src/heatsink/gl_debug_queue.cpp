@@ -0,0 +1,94 @@
+#include <heatsink/gl/debug_queue.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace heatsink::gl {
+	debug_queue::debug_queue(std::size_t capacity)
+	: m_slots{}, m_mask{}, m_head{0}, m_tail{0}, m_dropped{0} {
+		assert(capacity > 0);
+		capacity = std::bit_ceil(capacity);
+
+		m_slots = std::make_unique<slot[]>(capacity);
+		m_mask  = capacity - 1;
+		// Each slot starts free for the first producer to reach it.
+		for (std::size_t i = 0; i != capacity; ++i)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	void GLAPIENTRY debug_queue::callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* text, const void* queue) {
+		auto* q = static_cast<debug_queue*>(const_cast<void*>(queue));
+		q->push(source, type, id, severity, length, text);
+	}
+
+	void debug_queue::install() {
+		glEnable(GL_DEBUG_OUTPUT);
+		glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		glDebugMessageCallback((GLDEBUGPROC)callback, this);
+	}
+
+	bool debug_queue::push(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* text) {
+		// Claim a position; this is a bounded multi-producer queue, where a
+		// producer only proceeds once the slot has been freed for its lap.
+		auto position = m_head.load(std::memory_order_relaxed);
+		slot* s;
+		for (;;) {
+			s = &m_slots[position & m_mask];
+			auto sequence = s->sequence.load(std::memory_order_acquire);
+			auto diff     = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+
+			if (diff == 0) {
+				if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				// The consumer has not freed this slot yet; the queue is full.
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			} else {
+				position = m_head.load(std::memory_order_relaxed);
+			}
+		}
+
+		// A negative length means the text is null-terminated.
+		auto n = (length < 0) ? std::strlen(text) : (std::size_t)length;
+		n = std::min(n, max_length);
+
+		s->source   = source;
+		s->type     = type;
+		s->id       = id;
+		s->severity = severity;
+		s->length   = n;
+		std::memcpy(s->text, text, n);
+
+		s->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::size_t debug_queue::drain(const std::function<void(const message&)>& f) {
+		std::size_t count = 0;
+		for (;; ++count) {
+			auto& s = m_slots[m_tail & m_mask];
+			if (s.sequence.load(std::memory_order_acquire) != m_tail + 1)
+				break;
+
+			auto m = message{s.source, s.type, s.id, s.severity, std::string(s.text, s.length)};
+			// Free the slot before `f` is called, in case it throws.
+			s.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+			++m_tail;
+
+			f(m);
+		}
+
+		return count;
+	}
+
+	std::size_t debug_queue::take_dropped() {
+		return m_dropped.exchange(0, std::memory_order_relaxed);
+	}
+
+	std::size_t debug_queue::get_capacity() const {
+		return m_mask + 1;
+	}
+}
@@ -0,0 +1,112 @@
+#include <heatsink/gl/draw_batch.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+
+namespace {
+	// Indirect draws (and `glMultiDrawElementsIndirect()`) were added in
+	// OpenGL 4.3.
+	void validate_multi_draw() {
+		auto version = heatsink::gl::context_state::get_current().get_version();
+		if (version < heatsink::context::version{4,3})
+			throw heatsink::exception("gl::draw_batch", "multi-draw indirect requires OpenGL 4.3.");
+	}
+
+	template<typename Record>
+	auto sort_key(const Record& r) {
+		return std::make_tuple(r.shader->get(), r.vao->get(), r.state, r.mode, r.type);
+	}
+}
+
+namespace heatsink::gl {
+	draw_batch::draw_batch()
+	: m_buffer(GL_DRAW_INDIRECT_BUFFER), m_submits{0} {}
+
+	void draw_batch::draw(const program& p, const vertex_array& vao, GLenum mode, GLenum type, const command& cmd, std::uint64_t state) {
+		assert(vao.is_valid());
+		m_records.push_back(record{&p, &vao, state, mode, type, cmd});
+	}
+
+	void draw_batch::submit(const std::function<void(std::uint64_t)>& apply) {
+		m_submits = 0;
+		if (m_records.empty())
+			return;
+
+		validate_multi_draw();
+
+		// Keep the recorded order within a run, so that blending still works
+		// as expected for draws with identical state.
+		std::stable_sort(m_records.begin(), m_records.end(), [](const record& a, const record& b) {
+			return sort_key(a) < sort_key(b);
+		});
+
+		m_commands.clear();
+		m_commands.reserve(m_records.size());
+		for (const auto& r : m_records)
+			m_commands.push_back(r.cmd);
+
+		// Respecify the whole buffer every submission; this orphans the data
+		// still in use by the previous frame instead of waiting for it.
+		m_buffer.set(m_commands.begin(), m_commands.end(), GL_STREAM_DRAW);
+		m_buffer.bind();
+
+		const record* last = nullptr;
+		for (std::size_t begin = 0, end; begin != m_records.size(); begin = end) {
+			const auto& r = m_records[begin];
+			for (end = begin + 1; end != m_records.size(); ++end) {
+				if (sort_key(m_records[end]) != sort_key(r))
+					break;
+			}
+
+			if (!last || last->shader->get() != r.shader->get())
+				r.shader->use();
+			if (!last || last->vao->get() != r.vao->get())
+				r.vao->bind();
+			if (apply && (!last || last->state != r.state))
+				apply(r.state);
+
+			auto offset = reinterpret_cast<const void*>(begin * sizeof(command));
+			glMultiDrawElementsIndirect(r.mode, r.type, offset, (GLsizei)(end - begin), sizeof(command));
+
+			last = &r;
+			++m_submits;
+		}
+
+		m_records.clear();
+	}
+
+	void draw_batch::clear() {
+		m_records.clear();
+	}
+
+	std::size_t draw_batch::get_draw_count() const {
+		return m_records.size();
+	}
+
+	std::size_t draw_batch::get_submit_count() const {
+		return m_submits;
+	}
+
+	const buffer& draw_batch::get_buffer() const {
+		return m_buffer;
+	}
+
+	void draw_batch::draw_indirect(GLenum mode, GLenum type, const buffer::const_view& commands, const buffer::const_view& count, std::size_t max) {
+		if (!context_state::get_current().has_indirect_parameters())
+			throw exception("gl::draw_batch", "indirect draw counts require OpenGL 4.6.");
+		if (commands.get_target() != GL_DRAW_INDIRECT_BUFFER)
+			throw exception("gl::draw_batch", "indirect commands must be GL_DRAW_INDIRECT_BUFFER.");
+		if (count.get_target() != GL_PARAMETER_BUFFER)
+			throw exception("gl::draw_batch", "indirect draw count must be GL_PARAMETER_BUFFER.");
+
+		commands.bind();
+		count.bind();
+
+		auto offset = reinterpret_cast<const void*>(commands.get_offset());
+		glMultiDrawElementsIndirectCount(mode, type, offset, (GLintptr)count.get_offset(), (GLsizei)max, sizeof(command));
+	}
+}
@@ -0,0 +1,115 @@
+#include <heatsink/gl/fence.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	using clock    = std::chrono::steady_clock;
+	using duration = heatsink::gl::fence::duration;
+
+	// How long a timed wait polls the fence before letting the driver sleep.
+	// Most fences waited on by a frame loop are signaled within this window,
+	// and waking from a driver sleep often costs much longer than this.
+	constexpr duration g_spin_duration = std::chrono::microseconds(50);
+
+	// Check the result of `glClientWaitSync()`, throwing for failures.
+	bool is_satisfied(GLenum result) {
+		switch (result) {
+			case GL_ALREADY_SIGNALED:
+			case GL_CONDITION_SATISFIED:
+				return true;
+			case GL_WAIT_FAILED:
+				throw heatsink::exception("gl::fence", "could not wait on fence.");
+
+			default: return false;
+		}
+	}
+}
+
+namespace heatsink::gl {
+	fence fence::null() {
+		return fence(nullptr);
+	}
+
+	fence::fence()
+	: m_sync{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)} {
+		if (!m_sync)
+			throw exception("gl::fence", "could not create fence.");
+	}
+
+	fence::fence(fence&& other) noexcept
+	: m_sync{other.m_sync} {
+		other.m_sync = nullptr;
+	}
+
+	fence::~fence() {
+		if (m_sync)
+			glDeleteSync(m_sync);
+	}
+
+	fence& fence::operator =(fence&& other) noexcept {
+		if (m_sync)
+			glDeleteSync(m_sync);
+
+		m_sync = other.m_sync;
+
+		other.m_sync = nullptr;
+		return *this;
+	}
+
+	fence::fence(std::nullptr_t)
+	: m_sync{nullptr} {}
+
+	bool fence::is_signaled() const {
+		assert(this->is_valid());
+
+		GLint status;
+		glGetSynciv(m_sync, GL_SYNC_STATUS, 1, nullptr, &status);
+		return (status == GL_SIGNALED);
+	}
+
+	bool fence::wait(duration timeout) const {
+		assert(this->is_valid());
+
+		// Only flush on the first attempt; this guarantees that the fence will
+		// eventually be signaled without flushing on every poll.
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		auto start = clock::now();
+		auto spin  = std::min(timeout, g_spin_duration);
+
+		do {
+			if (is_satisfied(glClientWaitSync(m_sync, flags, 0)))
+				return true;
+
+			flags = 0;
+		} while (clock::now() - start < spin);
+
+		auto elapsed = std::chrono::duration_cast<duration>(clock::now() - start);
+		if (elapsed >= timeout)
+			return false;
+
+		// An unbounded wait is passed as the largest timeout OpenGL can take,
+		// rather than converting `duration::max()` with the time elapsed.
+		auto remaining = (timeout == duration::max())
+			? GL_TIMEOUT_IGNORED
+			: (GLuint64)(timeout - elapsed).count();
+
+		return is_satisfied(glClientWaitSync(m_sync, flags, remaining));
+	}
+
+	void fence::wait_gpu() const {
+		assert(this->is_valid());
+		glWaitSync(m_sync, 0, GL_TIMEOUT_IGNORED);
+	}
+
+	bool fence::is_valid() const {
+		return (m_sync != nullptr);
+	}
+
+	GLsync fence::get() const {
+		assert(this->is_valid());
+		return m_sync;
+	}
+}
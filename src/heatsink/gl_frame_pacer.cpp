@@ -0,0 +1,125 @@
+#include <heatsink/gl/frame_pacer.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace {
+	using duration     = heatsink::gl::frame_pacer::duration;
+	using steady_clock = std::chrono::steady_clock;
+
+	// Add a measurement, dropping the oldest beyond the window size.
+	void push(std::deque<duration>& ds, duration d, std::size_t window) {
+		ds.push_back(d);
+		while (ds.size() > window)
+			ds.pop_front();
+	}
+
+	duration average(const std::deque<duration>& ds) {
+		if (ds.empty())
+			return duration::zero();
+
+		return std::accumulate(ds.begin(), ds.end(), duration::zero()) / (duration::rep)ds.size();
+	}
+}
+
+namespace heatsink::gl {
+	frame_pacer::frame_pacer(std::size_t max_frames_in_flight, std::size_t window)
+	: m_max_in_flight{max_frames_in_flight}, m_window{std::max<std::size_t>(window, 1)},
+	  m_current{fence::null(), query(GL_TIMESTAMP), query(GL_TIMESTAMP)}, m_begun{false}, m_ended{false},
+	  m_start{}, m_swap{}, m_statistics{} {}
+
+	void frame_pacer::begin_frame() {
+		auto now = steady_clock::now();
+		// Everything submitted up to the swap belongs to the ended frame, so
+		// the fence is only inserted now.
+		if (m_ended) {
+			m_current.sync = fence();
+			m_frames.push_back(std::move(m_current));
+			m_current = frame{fence::null(), this->acquire(), this->acquire()};
+
+			if (m_swap != steady_clock::time_point{}) {
+				m_statistics.frame_time = now - m_swap;
+				push(m_frame_times, m_statistics.frame_time, m_window);
+			}
+
+			m_swap = now;
+			++m_statistics.frames;
+		}
+
+		// The frame being begun counts as in flight, so with a limit of `1`,
+		// the previous frame must be complete before this one starts.
+		this->collect();
+		while (m_max_in_flight != 0 && m_frames.size() >= m_max_in_flight) {
+			m_frames.front().sync.wait();
+			this->collect();
+		}
+
+		m_start = steady_clock::now();
+		m_statistics.wait_time = m_start - now;
+		m_statistics.in_flight = m_frames.size();
+
+		m_current.begin.record();
+		m_begun = true;
+		m_ended = false;
+	}
+
+	void frame_pacer::end_frame() {
+		// The first swap may happen before any frame was begun.
+		if (!m_begun)
+			return;
+
+		m_current.end.record();
+		m_statistics.cpu_time = steady_clock::now() - m_start;
+
+		m_begun = false;
+		m_ended = true;
+	}
+
+	void frame_pacer::set_max_frames_in_flight(std::size_t max) {
+		m_max_in_flight = max;
+	}
+
+	std::size_t frame_pacer::get_max_frames_in_flight() const {
+		return m_max_in_flight;
+	}
+
+	frame_pacer::statistics frame_pacer::get_statistics() const {
+		auto result = m_statistics;
+		result.average_frame_time = average(m_frame_times);
+		result.average_gpu_time   = average(m_gpu_times);
+
+		auto max = std::max_element(m_frame_times.begin(), m_frame_times.end());
+		result.max_frame_time = (max != m_frame_times.end()) ? *max : duration::zero();
+
+		return result;
+	}
+
+	void frame_pacer::collect() {
+		while (!m_frames.empty() && m_frames.front().sync.is_signaled()) {
+			auto& f = m_frames.front();
+			// The timestamps precede the fence, so they should be available;
+			// a result that is not is dropped rather than waited on.
+			if (f.begin.is_available() && f.end.is_available()) {
+				auto begin = f.begin.get_result();
+				auto end   = f.end.get_result();
+
+				m_statistics.gpu_time = duration((end > begin) ? (duration::rep)(end - begin) : 0);
+				push(m_gpu_times, m_statistics.gpu_time, m_window);
+			}
+
+			m_free.push_back(std::move(f.begin));
+			m_free.push_back(std::move(f.end));
+			m_frames.pop_front();
+		}
+	}
+
+	query frame_pacer::acquire() {
+		if (m_free.empty())
+			return query(GL_TIMESTAMP);
+
+		auto q = std::move(m_free.back());
+		m_free.pop_back();
+		return q;
+	}
+}
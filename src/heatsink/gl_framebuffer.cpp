@@ -0,0 +1,196 @@
+#include <heatsink/gl/framebuffer.hpp>
+
+#include <ostream>
+
+#include <glm/gtx/string_cast.hpp>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/traits/texture.hpp>
+
+namespace {
+	using texture_traits = heatsink::gl::texture_traits;
+
+	// Retrieve which component of a texture extents selects a layer (or
+	// face, or 3D slice) for the given target, or `3` if it has none.
+	std::size_t layer_component(GLenum target) {
+		if (texture_traits::is_array(target) || texture_traits::is_cubemap(target) || target == GL_TEXTURE_3D)
+			return texture_traits::rank(target) - 1;
+		else
+			return 3;
+	}
+}
+
+namespace heatsink::gl {
+	framebuffer framebuffer::default_framebuffer(glm::uvec2 extents) {
+		return framebuffer(nullptr, extents);
+	}
+
+	framebuffer::framebuffer(GLenum target)
+	: object<GL_FRAMEBUFFER>(target), m_extents{0} {}
+
+	framebuffer::framebuffer(std::nullptr_t, glm::uvec2 extents)
+	: object<GL_FRAMEBUFFER>(nullptr, GL_FRAMEBUFFER), m_extents{extents} {}
+
+	void framebuffer::attach(GLenum attachment, const texture::const_view& v, std::size_t mip) {
+		assert(this->is_valid() && this->get() != 0);
+		if (mip >= v.get_mipmap_count())
+			throw exception("gl::framebuffer", "mipmap level out of bounds.");
+
+		auto t      = v.get_target();
+		auto layer  = layer_component(t);
+		auto offset = v.get_offset(mip).get(0);
+		auto size   = v.get_extents(mip).get(1);
+
+		// Only layers can be selected; the rest of the level is always used.
+		for (std::size_t i = 0; i != std::min<std::size_t>(layer, 3); ++i) {
+			if (offset[i] == 0)
+				continue;
+
+			make_error_stream("gl::framebuffer")
+				<< "cannot attach texture view "
+				<< "(offset=" << glm::to_string(offset) << ") "
+				<< "that does not start at the origin of its level." << std::endl;
+
+			throw exception("gl::framebuffer", "framebuffer attachment must cover entire level.");
+		}
+
+		auto single = (layer != 3 && size[layer] == 1);
+		if (layer != 3 && !single && offset[layer] != 0)
+			throw exception("gl::framebuffer", "layered framebuffer attachment must include every layer.");
+
+		auto name = this->get();
+		if (has_direct_state_access()) {
+			if (single)
+				glNamedFramebufferTextureLayer(name, attachment, v.get(), mip, offset[layer]);
+			else
+				glNamedFramebufferTexture(name, attachment, v.get(), mip);
+		} else {
+			this->bind();
+			// Before OpenGL 4.5, cubemap faces cannot be attached as layers;
+			// they are attached as 2D images of their face target instead.
+			if (single && t == GL_TEXTURE_CUBE_MAP)
+				glFramebufferTexture2D(this->get_target(), attachment, GL_TEXTURE_CUBE_MAP_POSITIVE_X + offset[layer], v.get(), mip);
+			else if (single)
+				glFramebufferTextureLayer(this->get_target(), attachment, v.get(), mip, offset[layer]);
+			else
+				glFramebufferTexture(this->get_target(), attachment, v.get(), mip);
+		}
+
+		m_attachments[attachment] = glm::uvec2(size);
+		this->update_extents();
+	}
+
+	void framebuffer::detach(GLenum attachment) {
+		assert(this->is_valid() && this->get() != 0);
+		if (has_direct_state_access()) {
+			glNamedFramebufferTexture(this->get(), attachment, 0, 0);
+		} else {
+			this->bind();
+			glFramebufferTexture(this->get_target(), attachment, 0, 0);
+		}
+
+		m_attachments.erase(attachment);
+		this->update_extents();
+	}
+
+	void framebuffer::set_draw_buffers(const std::vector<GLenum>& buffers) {
+		assert(this->is_valid());
+		if (has_direct_state_access()) {
+			glNamedFramebufferDrawBuffers(this->get(), (GLsizei)buffers.size(), buffers.data());
+		} else {
+			name_traits<GL_FRAMEBUFFER>::bind(this->get(), GL_DRAW_FRAMEBUFFER);
+			glDrawBuffers((GLsizei)buffers.size(), buffers.data());
+		}
+	}
+
+	void framebuffer::validate() const {
+		assert(this->is_valid());
+		GLenum status;
+		if (has_direct_state_access()) {
+			status = glCheckNamedFramebufferStatus(this->get(), GL_FRAMEBUFFER);
+		} else {
+			this->bind();
+			status = glCheckFramebufferStatus(this->get_target());
+		}
+
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+			make_error_stream("gl::framebuffer")
+				<< "framebuffer is incomplete "
+				<< "(status=" << to_string(status) << ")." << std::endl;
+
+			throw exception("gl::framebuffer", "incomplete framebuffer.");
+		}
+	}
+
+	void framebuffer::resolve(framebuffer& dst, GLbitfield mask, GLenum filter) const {
+		assert(this->is_valid() && dst.is_valid());
+		auto s = m_extents;
+		auto d = dst.m_extents;
+
+		if (has_direct_state_access()) {
+			glBlitNamedFramebuffer(this->get(), dst.get(), 0, 0, s.x, s.y, 0, 0, d.x, d.y, mask, filter);
+		} else {
+			name_traits<GL_FRAMEBUFFER>::bind(this->get(), GL_READ_FRAMEBUFFER);
+			name_traits<GL_FRAMEBUFFER>::bind(dst.get(), GL_DRAW_FRAMEBUFFER);
+			glBlitFramebuffer(0, 0, s.x, s.y, 0, 0, d.x, d.y, mask, filter);
+		}
+	}
+
+	void framebuffer::discard(const std::vector<GLenum>& attachments) {
+		assert(this->is_valid());
+		if (attachments.empty())
+			return;
+
+		if (has_direct_state_access()) {
+			glInvalidateNamedFramebufferData(this->get(), (GLsizei)attachments.size(), attachments.data());
+		} else {
+			this->bind();
+			glInvalidateFramebuffer(this->get_target(), (GLsizei)attachments.size(), attachments.data());
+		}
+	}
+
+	void framebuffer::clear(std::size_t drawbuffer, const glm::vec4& color) {
+		assert(this->is_valid());
+		if (has_direct_state_access()) {
+			glClearNamedFramebufferfv(this->get(), GL_COLOR, (GLint)drawbuffer, &color[0]);
+		} else {
+			name_traits<GL_FRAMEBUFFER>::bind(this->get(), GL_DRAW_FRAMEBUFFER);
+			glClearBufferfv(GL_COLOR, (GLint)drawbuffer, &color[0]);
+		}
+	}
+
+	void framebuffer::clear(float depth, GLint stencil) {
+		assert(this->is_valid());
+		if (has_direct_state_access()) {
+			glClearNamedFramebufferfi(this->get(), GL_DEPTH_STENCIL, 0, depth, stencil);
+		} else {
+			name_traits<GL_FRAMEBUFFER>::bind(this->get(), GL_DRAW_FRAMEBUFFER);
+			glClearBufferfi(GL_DEPTH_STENCIL, 0, depth, stencil);
+		}
+	}
+
+	void framebuffer::use() const {
+		assert(this->is_valid());
+		this->bind();
+		glViewport(0, 0, (GLsizei)m_extents.x, (GLsizei)m_extents.y);
+	}
+
+	glm::uvec2 framebuffer::get_extents() const {
+		assert(this->is_valid());
+		return m_extents;
+	}
+
+	void framebuffer::update_extents() {
+		if (m_attachments.empty()) {
+			m_extents = glm::uvec2(0);
+			return;
+		}
+
+		// OpenGL renders to the intersection of every attachment.
+		m_extents = m_attachments.begin()->second;
+		for (const auto& [attachment, size] : m_attachments)
+			m_extents = glm::min(m_extents, size);
+	}
+}
@@ -0,0 +1,97 @@
+#include <heatsink/gl/handle_table.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include <heatsink/error/exception.hpp>
+
+namespace heatsink::gl {
+	handle_table::handle_table(GLenum target, std::size_t capacity)
+	: m_stride{(target == GL_UNIFORM_BUFFER) ? 2u : 1u}, m_size{0},
+	  m_dirty_begin{std::numeric_limits<std::size_t>::max()}, m_dirty_end{0},
+	  m_buffer(target) {
+		assert(capacity > 0);
+		if (target != GL_SHADER_STORAGE_BUFFER && target != GL_UNIFORM_BUFFER)
+			throw exception("gl::handle_table", "handle table must be a storage or uniform buffer.");
+
+		m_data.resize(capacity * m_stride);
+		m_buffer.set(m_data.begin(), m_data.end(), GL_DYNAMIC_DRAW);
+	}
+
+	std::size_t handle_table::insert(texture& t) {
+		std::size_t index;
+		if (!m_free.empty()) {
+			index = m_free.back();
+			m_free.pop_back();
+		} else {
+			index = m_size++;
+		}
+
+		this->assign(index, t);
+		return index;
+	}
+
+	void handle_table::assign(std::size_t index, texture& t) {
+		assert(index < m_size);
+		t.make_resident();
+		this->write(index, t.get_handle());
+	}
+
+	void handle_table::erase(std::size_t index) {
+		assert(index < m_size);
+		// Valid handles are never zero, so a zero entry is already free; it
+		// must not be reused by two later inserts.
+		if (m_data[index * m_stride] == 0)
+			return;
+
+		this->write(index, 0);
+		m_free.push_back(index);
+	}
+
+	void handle_table::flush() {
+		if (m_dirty_begin >= m_dirty_end)
+			return;
+
+		auto bytes = sizeof(GLuint64) * m_stride;
+		if (m_buffer.get_size() != m_data.size() * sizeof(GLuint64)) {
+			m_buffer.set(m_data.begin(), m_data.end(), GL_DYNAMIC_DRAW);
+		} else {
+			auto begin = m_data.data() + m_dirty_begin * m_stride;
+			auto end   = m_data.data() + m_dirty_end   * m_stride;
+
+			auto v = m_buffer.make_view(m_dirty_begin * bytes, (m_dirty_end - m_dirty_begin) * bytes);
+			v.update(begin, end);
+		}
+
+		m_dirty_begin = std::numeric_limits<std::size_t>::max();
+		m_dirty_end   = 0;
+	}
+
+	void handle_table::bind(std::size_t index) const {
+		m_buffer.bind_range(index);
+	}
+
+	GLuint64 handle_table::get_handle(std::size_t index) const {
+		assert(index < m_size);
+		return m_data[index * m_stride];
+	}
+
+	std::size_t handle_table::get_size() const {
+		return m_size;
+	}
+
+	const buffer& handle_table::get_buffer() const {
+		return m_buffer;
+	}
+
+	void handle_table::write(std::size_t index, GLuint64 handle) {
+		// Grow geometrically; the whole buffer is reallocated on the next flush.
+		if ((index + 1) * m_stride > m_data.size())
+			m_data.resize(std::max(m_data.size() * 2, (index + 1) * m_stride));
+
+		m_data[index * m_stride] = handle;
+		m_dirty_begin = std::min(m_dirty_begin, index);
+		m_dirty_end   = std::max(m_dirty_end, index + 1);
+	}
+}
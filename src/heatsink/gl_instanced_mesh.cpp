@@ -0,0 +1,99 @@
+#include <heatsink/gl/instanced_mesh.hpp>
+
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Retrieve the size of an index of the given type.
+	std::size_t get_index_size(GLenum type) {
+		switch (type) {
+			case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+			case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+			case GL_UNSIGNED_INT:   return sizeof(GLuint);
+			default:
+				heatsink::make_error_stream("gl::instanced_mesh")
+					<< "invalid index type " << type << "." << std::endl;
+
+				throw heatsink::exception("gl::instanced_mesh", "invalid index type.");
+		}
+	}
+}
+
+namespace heatsink::gl {
+	instanced_mesh::instanced_mesh(std::size_t instance_stride)
+	: m_instance_stride{instance_stride}, m_index_type{GL_UNSIGNED_INT}, m_index_count{0},
+	  m_instances{0}, m_instances_offset{0} {
+		assert(instance_stride != 0);
+		m_vao.set_binding_divisor(instance_binding, 1);
+	}
+
+	void instanced_mesh::set_vertex_attribute(const attribute& a, vertex_format f) {
+		m_vao.set_attribute_format(a, f, vertex_binding);
+	}
+
+	void instanced_mesh::set_vertex_attribute(const attribute& a, vertex_format f, vertex_array::conversion c) {
+		m_vao.set_attribute_format(a, f, vertex_binding, c);
+	}
+
+	void instanced_mesh::set_instance_attribute(const attribute& a, vertex_format f) {
+		this->validate_instance_format(f);
+		m_vao.set_attribute_format(a, f, instance_binding);
+	}
+
+	void instanced_mesh::set_instance_attribute(const attribute& a, vertex_format f, vertex_array::conversion c) {
+		this->validate_instance_format(f);
+		m_vao.set_attribute_format(a, f, instance_binding, c);
+	}
+
+	void instanced_mesh::set_vertices(buffer::const_view v, std::size_t stride) {
+		m_vao.set_binding(vertex_binding, v, stride);
+	}
+
+	void instanced_mesh::set_elements(const buffer& b, GLenum type) {
+		m_index_count = b.get_size() / get_index_size(type);
+		m_index_type  = type;
+		m_vao.set_elements(b);
+	}
+
+	void instanced_mesh::draw(const buffer::const_view& instances, std::size_t count, GLenum mode) {
+		if (instances.get_offset() % m_instance_stride != 0)
+			throw exception("gl::instanced_mesh", "instance view must be aligned to the instance stride.");
+		if (instances.get_size() < count * m_instance_stride)
+			throw exception("gl::instanced_mesh", "instance view is too small.");
+
+		this->draw(instances, 0, count, mode);
+	}
+
+	std::size_t instanced_mesh::get_instance_stride() const {
+		return m_instance_stride;
+	}
+
+	const vertex_array& instanced_mesh::get_vertex_array() const {
+		return m_vao;
+	}
+
+	void instanced_mesh::draw(const buffer::const_view& instances, std::size_t base, std::size_t count, GLenum mode) {
+		if (instances.get() != m_instances || instances.get_offset() != m_instances_offset) {
+			m_vao.set_binding(instance_binding, instances, m_instance_stride);
+			m_instances        = instances.get();
+			m_instances_offset = instances.get_offset();
+		}
+
+		m_vao.bind();
+		glDrawElementsInstancedBaseInstance(mode, (GLsizei)m_index_count, m_index_type, nullptr, (GLsizei)count, (GLuint)base);
+	}
+
+	void instanced_mesh::validate_instance_format(const vertex_format& f) const {
+		if (auto stride = f.get_packing().stride; stride != 0 && stride != m_instance_stride) {
+			make_error_stream("gl::instanced_mesh")
+				<< "instance attribute stride "
+				<< "(stride=" << stride << ") "
+				<< "does not match instance size "
+				<< "(size=" << m_instance_stride << ")." << std::endl;
+
+			throw exception("gl::instanced_mesh", "instance stride mismatch.");
+		}
+	}
+}
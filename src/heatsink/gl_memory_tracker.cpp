@@ -0,0 +1,230 @@
+#include <heatsink/gl/memory_tracker.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <ostream>
+#include <utility>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/gl/context_state.hpp>
+
+namespace {
+	using usage = heatsink::gl::memory_tracker::usage;
+
+	// The recorded allocation and label of a single object.
+	struct entry {
+	public:
+		std::size_t bytes;
+		std::string label;
+	};
+
+	// Every allocation recorded by the tracker, shared by all threads.
+	struct tracker_state {
+	public:
+		std::mutex mutex;
+		std::map<std::pair<GLenum, GLuint>, entry> entries;
+
+		usage buffers;
+		usage textures;
+		usage total;
+		std::map<std::string, usage> labels;
+
+		std::size_t budget;
+		// Whether the budget was already exceeded when last checked, so that
+		// the error is only logged once per crossing.
+		bool over_budget;
+	};
+
+	tracker_state& get_state() {
+		static tracker_state g_state = {};
+		return g_state;
+	}
+
+	// Check if the tracker accounts memory for the given object type.
+	bool is_tracked(GLenum type) {
+		return type == GL_BUFFER || type == GL_TEXTURE;
+	}
+
+	// Add or remove a single allocation from a category.
+	void add(usage& u, std::size_t bytes) {
+		u.bytes += bytes;
+		u.count += 1;
+		u.peak   = std::max(u.peak, u.bytes);
+	}
+
+	void remove(usage& u, std::size_t bytes) {
+		assert(u.bytes >= bytes && u.count > 0);
+		u.bytes -= bytes;
+		u.count -= 1;
+	}
+
+	// Add or remove an entry from every category it belongs to. Empty
+	// entries (labeled objects without storage) are not counted.
+	void insert(tracker_state& s, GLenum type, const entry& e) {
+		if (e.bytes == 0)
+			return;
+
+		add(type == GL_BUFFER ? s.buffers : s.textures, e.bytes);
+		add(s.total, e.bytes);
+		add(s.labels[e.label], e.bytes);
+	}
+
+	void erase(tracker_state& s, GLenum type, const entry& e) {
+		if (e.bytes == 0)
+			return;
+
+		remove(type == GL_BUFFER ? s.buffers : s.textures, e.bytes);
+		remove(s.total, e.bytes);
+		remove(s.labels[e.label], e.bytes);
+	}
+
+	// Log an error the first time the total crosses the budget.
+	void check_budget(tracker_state& s) {
+		auto over = s.budget != 0 && s.total.bytes > s.budget;
+		if (over && !s.over_budget) {
+			heatsink::make_error_stream("gl::memory_tracker")
+				<< "allocated memory "
+				<< "(bytes=" << s.total.bytes << ") "
+				<< "exceeds budget "
+				<< "(bytes=" << s.budget << ")." << std::endl;
+		}
+
+		s.over_budget = over;
+	}
+
+	// Retrieve a memory query of the current context, in bytes (the driver
+	// reports kilobytes).
+	std::size_t get_kilobytes(GLenum e) {
+		GLint value = 0;
+		glGetIntegerv(e, &value);
+		return (std::size_t)std::max(value, 0) * 1024;
+	}
+}
+
+namespace heatsink::gl {
+	void memory_tracker::allocate(GLenum type, GLuint name, std::size_t bytes) {
+		assert(is_tracked(type) && name);
+
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		auto& e = s.entries[{type, name}];
+		erase(s, type, e);
+		e.bytes = bytes;
+		insert(s, type, e);
+
+		check_budget(s);
+	}
+
+	void memory_tracker::release(GLenum type, GLuint name) {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		auto it = s.entries.find({type, name});
+		if (it == s.entries.end())
+			return;
+
+		erase(s, type, it->second);
+		s.entries.erase(it);
+
+		check_budget(s);
+	}
+
+	void memory_tracker::set_label(GLenum type, GLuint name, const std::string& label) {
+		assert(name);
+		auto debug = context_state::get_current().get_version() >= context::version{4,3}
+			|| epoxy_has_gl_extension("GL_KHR_debug");
+		if (debug)
+			glObjectLabel(type, name, (GLsizei)label.size(), label.c_str());
+
+		// Labels of other object types are only given to the driver, since
+		// they are never released by the tracker.
+		if (!is_tracked(type))
+			return;
+
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		auto& e = s.entries[{type, name}];
+		erase(s, type, e);
+		e.label = label;
+		insert(s, type, e);
+	}
+
+	std::string memory_tracker::get_label(GLenum type, GLuint name) {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		auto it = s.entries.find({type, name});
+		return it != s.entries.end() ? it->second.label : "";
+	}
+
+	memory_tracker::snapshot memory_tracker::get_snapshot() {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		return snapshot{s.buffers, s.textures, s.total, s.labels, s.budget};
+	}
+
+	std::size_t memory_tracker::get_total() {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+		return s.total.bytes;
+	}
+
+	std::size_t memory_tracker::get_peak() {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+		return s.total.peak;
+	}
+
+	void memory_tracker::reset_peak() {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		s.buffers.peak  = s.buffers.bytes;
+		s.textures.peak = s.textures.bytes;
+		s.total.peak    = s.total.bytes;
+		for (auto& [label, u] : s.labels)
+			u.peak = u.bytes;
+	}
+
+	void memory_tracker::set_budget(std::size_t bytes) {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+
+		s.budget = bytes;
+		check_budget(s);
+	}
+
+	bool memory_tracker::is_over_budget() {
+		auto& s = get_state();
+		std::lock_guard lock(s.mutex);
+		return s.budget != 0 && s.total.bytes > s.budget;
+	}
+
+	memory_tracker::device_memory memory_tracker::query_device() {
+		device_memory result = {};
+		if (epoxy_has_gl_extension("GL_NVX_gpu_memory_info")) {
+			result.is_available = true;
+			result.total        = get_kilobytes(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX);
+			result.available    = get_kilobytes(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX);
+			result.evicted      = get_kilobytes(GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX);
+
+			GLint evictions = 0;
+			glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX, &evictions);
+			result.evictions = (std::size_t)std::max(evictions, 0);
+		} else if (epoxy_has_gl_extension("GL_ATI_meminfo")) {
+			// The first of the four values is the total free memory of the
+			// pool; textures share their pool with buffers on current drivers.
+			GLint values[4] = {};
+			glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, values);
+
+			result.is_available = true;
+			result.available    = (std::size_t)std::max(values[0], 0) * 1024;
+		}
+
+		return result;
+	}
+}
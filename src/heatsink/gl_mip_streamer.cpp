@@ -0,0 +1,100 @@
+#include <heatsink/gl/mip_streamer.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <utility>
+
+#include <heatsink/error/exception.hpp>
+
+namespace heatsink::gl {
+	mip_streamer::mip_streamer(std::size_t budget)
+	: m_budget{budget}, m_cursor{0} {}
+
+	void mip_streamer::stream(texture& t, texture_file file, std::size_t resident) {
+		if (t.get_format() != file.get_format() || t.get_extents() != file.get_extents() || t.get_mipmap_count() != file.get_mipmap_count())
+			throw exception("gl::mip_streamer", "texture does not match file.");
+
+		this->cancel(t);
+
+		auto levels = file.get_mipmap_count();
+		auto base   = levels - std::clamp<std::size_t>(resident, 1, levels);
+
+		auto pending = file.get_images();
+		// Every level is uploaded starting from the smallest. The sort is
+		// stable so that layers keep their file order within a level.
+		std::stable_sort(pending.begin(), pending.end(), [](const auto& a, const auto& b) {
+			return a.mip > b.mip;
+		});
+
+		auto e = entry{&t, std::move(file), std::move(pending), 0};
+		while (e.next != e.pending.size() && e.pending[e.next].mip >= base)
+			e.file.upload(t, e.pending[e.next++]);
+
+		t.set_level_range(base, levels - 1);
+		if (e.next != e.pending.size())
+			m_entries.push_back(std::move(e));
+	}
+
+	void mip_streamer::cancel(const texture& t) {
+		auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const auto& e) {
+			return e.target == &t;
+		});
+
+		if (it == m_entries.end())
+			return;
+
+		// Keep the round-robin position pointing at the same next entry.
+		if ((std::size_t)std::distance(m_entries.begin(), it) < m_cursor)
+			--m_cursor;
+
+		m_entries.erase(it);
+	}
+
+	void mip_streamer::advance() {
+		std::size_t uploaded = 0;
+		while (!m_entries.empty() && (uploaded == 0 || uploaded < m_budget)) {
+			if (m_cursor >= m_entries.size())
+				m_cursor = 0;
+
+			auto& e = m_entries[m_cursor];
+			uploaded += this->upload_next(e);
+
+			if (e.next == e.pending.size())
+				m_entries.erase(m_entries.begin() + m_cursor);
+			else
+				++m_cursor;
+		}
+	}
+
+	bool mip_streamer::is_resident(const texture& t) const {
+		return std::none_of(m_entries.begin(), m_entries.end(), [&](const auto& e) {
+			return e.target == &t;
+		});
+	}
+
+	std::size_t mip_streamer::get_pending_size() const {
+		return std::accumulate(m_entries.begin(), m_entries.end(), std::size_t{0}, [](auto n, const auto& e) {
+			for (auto i = e.next; i != e.pending.size(); ++i)
+				n += e.pending[i].size;
+
+			return n;
+		});
+	}
+
+	std::size_t mip_streamer::get_budget() const {
+		return m_budget;
+	}
+
+	std::size_t mip_streamer::upload_next(entry& e) {
+		assert(e.next != e.pending.size());
+		const auto& img = e.pending[e.next++];
+		e.file.upload(*e.target, img);
+
+		// Once every layer of a level is present, it can be sampled.
+		if (e.next == e.pending.size() || e.pending[e.next].mip != img.mip)
+			e.target->set_level_range(img.mip, e.target->get_mipmap_count() - 1);
+
+		return img.size;
+	}
+}
@@ -0,0 +1,156 @@
+#include <heatsink/gl/occlusion_cache.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+#include <heatsink/error/exception.hpp>
+
+namespace heatsink::gl {
+	occlusion_cache::occlusion_cache(GLenum target, std::size_t latency)
+	: m_target{target}, m_latency{latency}, m_frame{0}, m_active{nullptr} {
+		if (target != GL_SAMPLES_PASSED && target != GL_ANY_SAMPLES_PASSED && target != GL_ANY_SAMPLES_PASSED_CONSERVATIVE)
+			throw exception("gl::occlusion_cache", "invalid occlusion query target.");
+	}
+
+	void occlusion_cache::begin(key k) {
+		if (m_active)
+			throw exception("gl::occlusion_cache", "an occlusion test is already active.");
+
+		auto& e = m_entries[k];
+		e.queries.push_back(issued{this->acquire(), m_frame, false});
+		e.queries.back().test.begin();
+
+		m_active = &e;
+	}
+
+	void occlusion_cache::end() {
+		if (!m_active)
+			throw exception("gl::occlusion_cache", "no occlusion test is active.");
+
+		m_active->queries.back().test.end();
+		m_active = nullptr;
+	}
+
+	occlusion_cache::scope occlusion_cache::test(key k) {
+		return scope(*this, k);
+	}
+
+	void occlusion_cache::advance() {
+		assert(!m_active);
+		for (auto& [k, e] : m_entries) {
+			// Results become available in submission order, so polling can
+			// stop at the first query that is still pending.
+			for (auto& q : e.queries) {
+				if (q.collected)
+					continue;
+				if (!q.test.is_available())
+					break;
+
+				q.collected = true;
+				if (!e.known || q.frame >= e.frame) {
+					e.known   = true;
+					e.samples = q.test.get_result();
+					e.frame   = q.frame;
+				}
+			}
+
+			// Recycle every collected query but the newest, which may still be
+			// used for conditional rendering.
+			auto last = std::prev(e.queries.end());
+			auto end  = std::find_if(e.queries.begin(), last, [](const issued& q) { return !q.collected; });
+			for (auto it = e.queries.begin(); it != end; ++it)
+				m_free.push_back(std::move(it->test));
+
+			e.queries.erase(e.queries.begin(), end);
+		}
+
+		++m_frame;
+	}
+
+	bool occlusion_cache::is_visible(key k) const {
+		auto it = m_entries.find(k);
+		if (it == m_entries.end() || !it->second.known)
+			return true;
+
+		// A result older than the latency is no longer trusted; the object may
+		// have moved into view since.
+		const auto& e = it->second;
+		if (m_frame - e.frame > m_latency)
+			return true;
+
+		return e.samples != 0;
+	}
+
+	std::uint64_t occlusion_cache::get_samples(key k) const {
+		auto it = m_entries.find(k);
+		if (it == m_entries.end() || !it->second.known)
+			throw exception("gl::occlusion_cache", "object has no occlusion result.");
+
+		return it->second.samples;
+	}
+
+	const query* occlusion_cache::get_query(key k) const {
+		auto it = m_entries.find(k);
+		if (it == m_entries.end() || it->second.queries.empty())
+			return nullptr;
+
+		return &it->second.queries.back().test;
+	}
+
+	conditional_render occlusion_cache::conditional(key k, GLenum mode) const {
+		// A query that is still active cannot be used for conditional
+		// rendering, so objects being tested are always drawn.
+		auto* q = this->get_query(k);
+		if (!q || (m_active && &m_active->queries.back().test == q))
+			return conditional_render(nullptr);
+
+		return conditional_render(*q, mode);
+	}
+
+	void occlusion_cache::erase(key k) {
+		auto it = m_entries.find(k);
+		if (it == m_entries.end())
+			return;
+
+		assert(&it->second != m_active);
+		// Pending queries are deleted rather than recycled; it is not known
+		// when their results (which are discarded) become available.
+		m_entries.erase(it);
+	}
+
+	void occlusion_cache::clear() {
+		assert(!m_active);
+		m_entries.clear();
+	}
+
+	std::size_t occlusion_cache::get_size() const {
+		return m_entries.size();
+	}
+
+	std::size_t occlusion_cache::get_pending_count() const {
+		std::size_t count = 0;
+		for (const auto& [k, e] : m_entries)
+			count += std::count_if(e.queries.begin(), e.queries.end(), [](const issued& q) { return !q.collected; });
+
+		return count;
+	}
+
+	query occlusion_cache::acquire() {
+		if (m_free.empty())
+			return query(m_target);
+
+		auto q = std::move(m_free.back());
+		m_free.pop_back();
+		return q;
+	}
+
+	occlusion_cache::scope::scope(occlusion_cache& c, key k)
+	: m_cache{c} {
+		m_cache.begin(k);
+	}
+
+	occlusion_cache::scope::~scope() {
+		m_cache.end();
+	}
+}
@@ -0,0 +1,196 @@
+#include <heatsink/gl/packed.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HEATSINK_ENCODE_SSE2
+	#include <emmintrin.h>
+#endif
+#if defined(__F16C__)
+	#define HEATSINK_ENCODE_F16C
+	#include <immintrin.h>
+#endif
+
+namespace {
+	// Convert a float to a half with round-to-nearest-even, handling
+	// overflow, subnormals, infinity and NaN; see F. Giesen, "half.hpp".
+	GLhalf to_half(float value) {
+		constexpr std::uint32_t infinity     = 255u << 23;
+		constexpr std::uint32_t maximum      = (127u + 16u) << 23;
+		constexpr std::uint32_t denorm_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+		auto bits = std::bit_cast<std::uint32_t>(value);
+		auto sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		std::uint32_t result;
+		if (bits >= maximum) {
+			// Too large for a half (becomes infinity), or infinity/NaN.
+			result = (bits > infinity) ? 0x7e00 : 0x7c00;
+		} else if (bits < (113u << 23)) {
+			// Subnormal (or zero); align the mantissa by adding a float
+			// whose exponent shifts it into place, rounding along the way.
+			auto f = std::bit_cast<float>(bits) + std::bit_cast<float>(denorm_magic);
+			result = std::bit_cast<std::uint32_t>(f) - denorm_magic;
+		} else {
+			// Normal; rebias the exponent and round the mantissa to even.
+			auto odd = (bits >> 13) & 1;
+			bits += ((15u - 127u) << 23) + 0xfff + odd;
+			result = bits >> 13;
+		}
+
+		return (GLhalf)(result | (sign >> 16));
+	}
+
+	// Convert a float to a normalized integer of the given type, with the
+	// same (nearest-even) rounding as the vectorized conversion.
+	template<class T>
+	T to_norm(float value) {
+		constexpr auto scale = (float)std::numeric_limits<T>::max();
+		constexpr auto low   = std::is_signed_v<T> ? -1.0f : 0.0f;
+
+		return (T)std::nearbyint(std::clamp(value, low, 1.0f) * scale);
+	}
+
+#if defined(HEATSINK_ENCODE_SSE2)
+	// Clamp, scale and round eight floats to 32-bit integers.
+	void to_norm_x8(const float* in, float low, float scale, __m128i& a, __m128i& b) {
+		auto lo = _mm_set1_ps(low);
+		auto hi = _mm_set1_ps(1.0f);
+		auto s  = _mm_set1_ps(scale);
+
+		a = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + 0), lo), hi), s));
+		b = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + 4), lo), hi), s));
+	}
+#endif
+
+	// Convert floats to normalized integers, eight at a time where possible.
+	template<class T>
+	void encode_norm(const float* begin, const float* end, T* out) {
+		auto n = (std::size_t)(end - begin);
+		std::size_t i = 0;
+
+#if defined(HEATSINK_ENCODE_SSE2)
+		constexpr auto scale = (float)std::numeric_limits<T>::max();
+		constexpr auto low   = std::is_signed_v<T> ? -1.0f : 0.0f;
+
+		for (; i + 8 <= n; i += 8) {
+			__m128i a, b;
+			to_norm_x8(begin + i, low, scale, a, b);
+
+			if constexpr (std::is_same_v<T, GLshort>) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+			} else if constexpr (std::is_same_v<T, GLushort>) {
+				// There is no unsigned 32-to-16 pack in SSE2; bias into the
+				// signed range, pack with saturation, then flip the sign bit.
+				auto bias = _mm_set1_epi32(0x8000);
+				auto s    = _mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(s, _mm_set1_epi16((short)0x8000)));
+			} else if constexpr (std::is_same_v<T, GLbyte>) {
+				auto s = _mm_packs_epi32(a, b);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi16(s, s));
+			} else {
+				auto s = _mm_packs_epi32(a, b);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(s, s));
+			}
+		}
+#endif
+
+		for (; i != n; ++i)
+			out[i] = to_norm<T>(begin[i]);
+	}
+
+	// Pack four normalized components into a 2_10_10_10 value, as either
+	// snorm or unorm components.
+	template<bool Signed>
+	GLuint to_2_10_10_10(const float* in) {
+		auto pack = [](float value, int bits) {
+			auto maximum = (float)((1 << (bits - (Signed ? 1 : 0))) - 1);
+			auto low     = Signed ? -1.0f : 0.0f;
+			auto v = (std::int32_t)std::nearbyint(std::clamp(value, low, 1.0f) * maximum);
+			return (GLuint)v & ((1u << bits) - 1);
+		};
+
+		return pack(in[0], 10) | (pack(in[1], 10) << 10) | (pack(in[2], 10) << 20) | (pack(in[3], 2) << 30);
+	}
+
+	void validate_packed_count(const float* begin, const float* end) {
+		if ((end - begin) % 4 != 0) {
+			heatsink::make_error_stream("gl::encode")
+				<< "cannot pack "
+				<< (end - begin) << " components into four-component values." << std::endl;
+
+			throw heatsink::exception("gl::encode", "packed types require four components per value.");
+		}
+	}
+}
+
+namespace heatsink::gl {
+	void encode(const GLfloat* begin, const GLfloat* end, half* out) {
+		auto n = (std::size_t)(end - begin);
+		std::size_t i = 0;
+
+#if defined(HEATSINK_ENCODE_F16C)
+		for (; i + 4 <= n; i += 4) {
+			auto h = _mm_cvtps_ph(_mm_loadu_ps(begin + i), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), h);
+		}
+#endif
+
+		for (; i != n; ++i)
+			out[i].bits = to_half(begin[i]);
+	}
+
+	void encode(const GLfloat* begin, const GLfloat* end, GLbyte* out) {
+		encode_norm(begin, end, out);
+	}
+
+	void encode(const GLfloat* begin, const GLfloat* end, GLshort* out) {
+		encode_norm(begin, end, out);
+	}
+
+	void encode(const GLfloat* begin, const GLfloat* end, GLubyte* out) {
+		encode_norm(begin, end, out);
+	}
+
+	void encode(const GLfloat* begin, const GLfloat* end, GLushort* out) {
+		encode_norm(begin, end, out);
+	}
+
+	void encode(const GLfloat* begin, const GLfloat* end, int_2_10_10_10_rev* out) {
+		validate_packed_count(begin, end);
+		for (auto* it = begin; it != end; it += 4)
+			(out++)->bits = to_2_10_10_10<true>(it);
+	}
+
+	void encode(const GLfloat* begin, const GLfloat* end, uint_2_10_10_10_rev* out) {
+		validate_packed_count(begin, end);
+		for (auto* it = begin; it != end; it += 4)
+			(out++)->bits = to_2_10_10_10<false>(it);
+	}
+
+	GLenum select_index_type(std::size_t vertex_count) {
+		return (vertex_count <= std::numeric_limits<GLushort>::max()) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	index_buffer make_index_buffer(const GLuint* begin, const GLuint* end, std::size_t vertex_count, GLenum usage) {
+		assert(std::all_of(begin, end, [&](GLuint i) { return i < vertex_count; }));
+
+		auto count = (std::size_t)(end - begin);
+		auto type  = select_index_type(vertex_count);
+		if (type == GL_UNSIGNED_INT)
+			return {buffer(GL_ELEMENT_ARRAY_BUFFER, begin, end, usage), type, count};
+
+		std::vector<GLushort> narrowed(begin, end);
+		return {buffer(GL_ELEMENT_ARRAY_BUFFER, narrowed.begin(), narrowed.end(), usage), type, count};
+	}
+}
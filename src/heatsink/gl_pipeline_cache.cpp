@@ -0,0 +1,35 @@
+#include <heatsink/gl/pipeline_cache.hpp>
+
+#include <algorithm>
+
+namespace heatsink::gl {
+	const program_pipeline& pipeline_cache::get(const std::vector<std::reference_wrapper<const program>>& programs) {
+		std::vector<GLuint> key;
+		for (const auto& p : programs)
+			key.push_back(p.get().get());
+
+		if (auto it = m_pipelines.find(key); it != m_pipelines.end())
+			return it->second;
+
+		program_pipeline pipeline;
+		for (const auto& p : programs)
+			pipeline.set_program(p.get());
+
+		return m_pipelines.emplace(std::move(key), std::move(pipeline)).first->second;
+	}
+
+	void pipeline_cache::erase(const program& p) {
+		std::erase_if(m_pipelines, [&](const auto& entry) {
+			const auto& [key, pipeline] = entry;
+			return std::find(key.begin(), key.end(), p.get()) != key.end();
+		});
+	}
+
+	void pipeline_cache::clear() {
+		m_pipelines.clear();
+	}
+
+	std::size_t pipeline_cache::get_size() const {
+		return m_pipelines.size();
+	}
+}
@@ -56,7 +56,7 @@ namespace heatsink::gl {
 		return m_datatype;
 	}
 
-	std::size_t size_of(pixel_format format) const {
+	std::size_t size_of(pixel_format format) {
 		auto ptype = format.get_datatype();
 
 		auto datasize = size_of(ptype);
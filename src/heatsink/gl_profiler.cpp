@@ -0,0 +1,138 @@
+#include <heatsink/gl/profiler.hpp>
+
+#include <cassert>
+#include <numeric>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+
+namespace heatsink::gl {
+	profiler::profiler(std::size_t latency, std::size_t window)
+	: m_frames(latency), m_frame{0}, m_window{window}, m_dropped{0} {
+		assert(latency > 0 && window > 0);
+		for (auto& f : m_frames)
+			f.used = 0;
+
+		// Debug groups are core in OpenGL 4.3, and otherwise part of KHR_debug.
+		m_debug_groups = (context_state::get_current().get_version() >= context::version{4,3})
+			|| epoxy_has_gl_extension("GL_KHR_debug");
+	}
+
+	void profiler::begin(const std::string& name) {
+		auto& f = m_frames[m_frame];
+
+		// Scopes are identified by their full path, so the same name under
+		// different parents is measured separately.
+		auto path = name;
+		if (!m_stack.empty())
+			path = m_scopes[f.samples[m_stack.back()].history].path + "/" + path;
+
+		auto [it, inserted] = m_paths.try_emplace(path, m_scopes.size());
+		if (inserted) {
+			auto h = history{path, name, m_stack.size(), {}, 0, {}};
+			h.durations.reserve(m_window);
+			m_scopes.push_back(std::move(h));
+		}
+
+		m_stack.push_back(f.samples.size());
+		f.samples.push_back(sample{it->second, this->record(f), 0});
+
+		if (m_debug_groups)
+			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, (GLsizei)name.size(), name.c_str());
+	}
+
+	void profiler::end() {
+		if (m_stack.empty())
+			throw exception("gl::profiler", "no profiler scope to end.");
+
+		if (m_debug_groups)
+			glPopDebugGroup();
+
+		auto& f = m_frames[m_frame];
+		f.samples[m_stack.back()].last = this->record(f);
+		m_stack.pop_back();
+	}
+
+	profiler::scope profiler::profile(const std::string& name) {
+		return scope(*this, name);
+	}
+
+	void profiler::advance() {
+		if (!m_stack.empty())
+			throw exception("gl::profiler", "cannot advance with open profiler scopes.");
+
+		m_frame = (m_frame + 1) % m_frames.size();
+		// The frame being reused was recorded `latency` frames ago, which is
+		// (usually) long enough for its queries to be available.
+		this->collect(m_frames[m_frame]);
+	}
+
+	std::vector<profiler::result> profiler::get_results() const {
+		std::vector<result> results;
+		for (const auto& h : m_scopes) {
+			auto total = std::accumulate(h.durations.begin(), h.durations.end(), std::chrono::nanoseconds{0});
+			auto count = h.durations.size();
+
+			auto average = count ? total / (std::chrono::nanoseconds::rep)count : std::chrono::nanoseconds{0};
+			results.push_back(result{h.name, h.depth, h.last, average, count});
+		}
+
+		return results;
+	}
+
+	void profiler::write(std::ostream& out) const {
+		using milliseconds = std::chrono::duration<double, std::milli>;
+		for (const auto& r : this->get_results()) {
+			out << std::string(2 * r.depth, ' ') << r.name << ": "
+				<< milliseconds(r.last).count() << "ms "
+				<< "(avg=" << milliseconds(r.average).count() << "ms, "
+				<< "n=" << r.samples << ")" << std::endl;
+		}
+	}
+
+	std::size_t profiler::get_dropped_count() const {
+		return m_dropped;
+	}
+
+	std::size_t profiler::record(frame& f) {
+		if (f.used == f.queries.size())
+			f.queries.emplace_back(GL_TIMESTAMP);
+
+		f.queries[f.used].record();
+		return f.used++;
+	}
+
+	void profiler::collect(frame& f) {
+		for (const auto& s : f.samples) {
+			// The end is recorded after the start, so it is available last.
+			if (!f.queries[s.last].is_available()) {
+				++m_dropped;
+				continue;
+			}
+
+			auto first = f.queries[s.first].get_result();
+			auto last  = f.queries[s.last].get_result();
+
+			auto& h = m_scopes[s.history];
+			h.last = std::chrono::nanoseconds(last - first);
+			if (h.durations.size() < m_window)
+				h.durations.push_back(h.last);
+			else
+				h.durations[h.head] = h.last;
+
+			h.head = (h.head + 1) % m_window;
+		}
+
+		f.samples.clear();
+		f.used = 0;
+	}
+
+	profiler::scope::scope(profiler& p, const std::string& name)
+	: m_profiler{p} {
+		m_profiler.begin(name);
+	}
+
+	profiler::scope::~scope() {
+		m_profiler.end();
+	}
+}
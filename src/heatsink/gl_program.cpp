@@ -1,11 +1,13 @@
 #include <heatsink/gl/program.hpp>
 
+#include <algorithm>
 #include <cassert>
-#include <iostream>
+#include <ostream>
 
 #include <heatsink/error/compile.hpp>
 #include <heatsink/error/debug.hpp>
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
 
 namespace {
 	// Convert a set of `shader`/`shader_name`s into their `GLuint` values.
@@ -17,6 +19,18 @@ namespace {
 
 		return names;
 	}
+
+	// Retrieve the stage of each of the given `GL_SHADER` identifiers.
+	std::vector<GLenum> to_stages(const std::vector<GLuint>& names) {
+		std::vector<GLenum> stages;
+		for (const auto& n : names) {
+			GLint type;
+			glGetShaderiv(n, GL_SHADER_TYPE, &type);
+			stages.push_back((GLenum)type);
+		}
+
+		return stages;
+	}
 }
 
 namespace heatsink::gl {
@@ -35,14 +49,33 @@ namespace heatsink::gl {
 		while (!from.extension().empty())
 			from = from.stem();
 
-		return program(to_names(shaders), from.string());
+		return program(to_names(shaders), from.string(), false, false);
+	}
+
+	program program::retrievable(const std::vector<shader_name>& shaders, const std::string& from) {
+		return program(to_names(shaders), from, true, false);
+	}
+
+	program program::from_binary(const binary& b, const std::string& from) {
+		return program(b, from);
+	}
+
+	program program::deferred(const std::vector<shader_name>& shaders, const std::string& from) {
+		return program(to_names(shaders), from, false, true);
+	}
+
+	program program::separable(const std::vector<shader_name>& shaders, const std::string& from) {
+		return program(to_names(shaders), from, false, false, true);
 	}
 
 	program::program(const std::vector<shader_name>& shaders, const std::string& from)
-	: program(to_names(shaders), from) {}
+	: program(to_names(shaders), from, false, false) {}
 
 	program::program(program&& other) noexcept
-	: m_name{other.m_name} {
+	: m_name{other.m_name}, m_stages{std::move(other.m_stages)}, m_separable{other.m_separable}, m_from{std::move(other.m_from)},
+	  m_pending{std::move(other.m_pending)}, m_work_group_size{other.m_work_group_size},
+	  m_attributes{std::move(other.m_attributes)}, m_uniforms{std::move(other.m_uniforms)},
+	  m_uniform_blocks{std::move(other.m_uniform_blocks)}, m_storage_blocks{std::move(other.m_storage_blocks)} {
 		other.m_name = 0;
 	}
 
@@ -55,28 +88,153 @@ namespace heatsink::gl {
 		if (m_name)
 			glDeleteProgram(m_name);
 
-		m_name = other.m_name;
+		m_name            = other.m_name;
+		m_stages          = std::move(other.m_stages);
+		m_separable       = other.m_separable;
+		m_from            = std::move(other.m_from);
+		m_pending         = std::move(other.m_pending);
+		m_work_group_size = other.m_work_group_size;
+		m_attributes      = std::move(other.m_attributes);
+		m_uniforms        = std::move(other.m_uniforms);
+		m_uniform_blocks  = std::move(other.m_uniform_blocks);
+		m_storage_blocks  = std::move(other.m_storage_blocks);
 
 		other.m_name = 0;
 		return *this;
 	}
 
-	program::program(const std::vector<GLuint>& names, const std::string& from)
-	: m_name{glCreateProgram()} {
+	program::program(const std::vector<GLuint>& names, const std::string& from, bool retrievable, bool deferred, bool separable)
+	: m_name{glCreateProgram()}, m_stages{to_stages(names)}, m_separable{separable}, m_from{from}, m_work_group_size{0} {
 		if (!m_name)
 			throw exception("gl::program", "could not allocate program.");
 
-		this->link(names, from);
+		// The hint must be given before linking for the binary to be kept.
+		if (retrievable)
+			glProgramParameteri(m_name, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		if (separable)
+			glProgramParameteri(m_name, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
-		m_attributes = attribute::from_program(*this);
-		m_uniforms = uniform::from_program(*this);
+		this->link(names);
+		if (!deferred)
+			this->finish();
+	}
+
+	program::program(const binary& b, const std::string& from)
+	: m_name{glCreateProgram()}, m_stages{b.stages}, m_separable{false}, m_from{from}, m_work_group_size{0} {
+		if (!m_name)
+			throw exception("gl::program", "could not allocate program.");
+
+		// Keep the binary retrievable, so a reloaded program can be cached again.
+		glProgramParameteri(m_name, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glProgramBinary(m_name, b.format, b.data.data(), (GLsizei)b.data.size());
+
+		// A binary may be rejected at any time (for example, after a driver
+		// update); the caller is expected to fall back to a normal link.
+		GLint result;
+		if (glGetProgramiv(m_name, GL_LINK_STATUS, &result); result != GL_TRUE) {
+			glDeleteProgram(m_name);
+			make_error_stream("gl::program")
+				<< "program binary for "
+				<< "\"" << from << "\" "
+				<< "was rejected." << std::endl;
+
+			throw exception("gl::program", "could not load program binary.");
+		}
+
+		// The binary restores whether the program was linked as separable.
+		glGetProgramiv(m_name, GL_PROGRAM_SEPARABLE, &result);
+		m_separable = (result == GL_TRUE);
+
+		this->introspect();
+	}
+
+	bool program::is_complete() const {
+		assert(this->is_valid());
+		if (m_pending.empty() || !context_state::get_current().has_parallel_shader_compile())
+			return true;
+
+		GLint result;
+		glGetProgramiv(m_name, GL_COMPLETION_STATUS_KHR, &result);
+		return (result == GL_TRUE);
+	}
+
+	void program::finish() {
+		assert(this->is_valid());
+		if (m_pending.empty())
+			return;
+
+		// Querying the status blocks until the link has finished.
+		GLint result;
+		if (glGetProgramiv(m_name, GL_LINK_STATUS, &result); result != GL_TRUE) {
+			// Deferred shaders may not have been checked yet; their logs are
+			// more useful than the link log for a compile error.
+			for (const auto& n : m_pending) {
+				if (glGetShaderiv(n, GL_COMPILE_STATUS, &result); result != GL_TRUE) {
+					auto& os = make_error_stream("gl::program") << "shader compile errors:" << std::endl;
+					write_shader_log(os, n, m_from);
+				}
+			}
+
+			auto& os = make_error_stream("gl::program") << "program link errors:" << std::endl;
+			write_program_log(os, m_name, m_from);
+
+			throw exception("gl::program", "could not link shader sources.");
+		}
+
+		// Once the program is set up, the shaders no longer need to be
+		// associated with the `GL_PROGRAM` object.
+		for (const auto& n : m_pending)
+			glDetachShader(m_name, n);
+
+		m_pending.clear();
+		this->introspect();
 	}
 
 	void program::use() const {
 		assert(this->is_valid());
+		this->validate_finished();
 		glUseProgram(m_name);
 	}
 
+	void program::dispatch(glm::uvec3 groups) const {
+		assert(this->is_valid());
+		this->validate_finished();
+		if (!this->is_compute())
+			throw exception("gl::program", "cannot dispatch non-compute program.");
+
+		auto limit = context_state::get_current().get_max_work_group_count();
+		if (glm::any(glm::equal(groups, glm::uvec3(0))) || glm::any(glm::greaterThan(groups, limit))) {
+			make_error_stream("gl::program")
+				<< "cannot dispatch "
+				<< "(" << groups.x << ", " << groups.y << ", " << groups.z << ") "
+				<< "work groups "
+				<< "(max=" << limit.x << ", " << limit.y << ", " << limit.z << ")." << std::endl;
+
+			throw exception("gl::program", "work group count out of range.");
+		}
+
+		this->use();
+		glDispatchCompute(groups.x, groups.y, groups.z);
+	}
+
+	void program::dispatch_indirect(const buffer::const_view& v) const {
+		assert(this->is_valid());
+		this->validate_finished();
+		if (!this->is_compute())
+			throw exception("gl::program", "cannot dispatch non-compute program.");
+
+		if (v.get_target() != GL_DISPATCH_INDIRECT_BUFFER)
+			throw exception("gl::program", "indirect dispatch must be sourced from dispatch indirect buffer.");
+		if (v.get_size() < 3 * sizeof(GLuint))
+			throw exception("gl::program", "buffer view too small for dispatch command.");
+		if (v.get_offset() % sizeof(GLuint) != 0)
+			throw exception("gl::program", "misaligned buffer view.");
+
+		this->use();
+		v.bind();
+		glDispatchComputeIndirect((GLintptr)v.get_offset());
+	}
+
 	bool program::is_valid() const {
 		return (m_name != 0);
 	}
@@ -86,8 +244,33 @@ namespace heatsink::gl {
 		return m_name;
 	}
 
+	bool program::is_compute() const {
+		assert(this->is_valid());
+		this->validate_finished();
+		return (m_work_group_size != glm::uvec3(0));
+	}
+
+	bool program::is_separable() const {
+		assert(this->is_valid());
+		return m_separable;
+	}
+
+	const std::vector<GLenum>& program::get_stages() const {
+		assert(this->is_valid());
+		return m_stages;
+	}
+
+	glm::uvec3 program::get_work_group_size() const {
+		assert(this->is_valid());
+		if (!this->is_compute())
+			throw exception("gl::program", "non-compute program has no work group size.");
+
+		return m_work_group_size;
+	}
+
 	attribute program::get_attribute(const std::string& name) const {
 		assert(this->is_valid());
+		this->validate_finished();
 		if (!m_attributes.count(name)) {
 			make_error_stream("gl::program")
 				<< "could not find attribute "
@@ -101,6 +284,7 @@ namespace heatsink::gl {
 
 	uniform program::get_uniform(const std::string& name) {
 		assert(this->is_valid());
+		this->validate_finished();
 		if (!m_uniforms.count(name)) {
 			make_error_stream("gl::program")
 				<< "could not find uniform "
@@ -112,24 +296,76 @@ namespace heatsink::gl {
 		return m_uniforms.at(name);
 	}
 
-	void program::link(const std::vector<GLuint>& names, const std::string& from) {
+	uniform_block& program::get_uniform_block(const std::string& name) {
+		assert(this->is_valid());
+		this->validate_finished();
+		if (!m_uniform_blocks.count(name)) {
+			make_error_stream("gl::program")
+				<< "could not find uniform block "
+				<< "\"" << name << "\"." << std::endl;
+
+			throw exception("gl::program", "uniform block does not exist.");
+		}
+
+		return m_uniform_blocks.at(name);
+	}
+
+	storage_block& program::get_storage_block(const std::string& name) {
+		assert(this->is_valid());
+		this->validate_finished();
+		if (!m_storage_blocks.count(name)) {
+			make_error_stream("gl::program")
+				<< "could not find storage block "
+				<< "\"" << name << "\"." << std::endl;
+
+			throw exception("gl::program", "storage block does not exist.");
+		}
+
+		return m_storage_blocks.at(name);
+	}
+
+	program::binary program::get_binary() const {
+		assert(this->is_valid());
+		this->validate_finished();
+		binary result;
+		result.stages = m_stages;
+
+		GLint size;
+		glGetProgramiv(m_name, GL_PROGRAM_BINARY_LENGTH, &size);
+		if (size == 0)
+			throw exception("gl::program", "program binary is not retrievable.");
+
+		result.data.resize(size);
+		glGetProgramBinary(m_name, size, nullptr, &result.format, result.data.data());
+
+		return result;
+	}
+
+	void program::link(const std::vector<GLuint>& names) {
 		for (const auto& n : names)
 			glAttachShader(m_name, n);
 
 		glLinkProgram(m_name);
+		// The shaders are detached once the link status has been checked.
+		m_pending = names;
+	}
 
-		GLint result;
-		if (glGetProgramiv(m_name, GL_LINK_STATUS, &result); result != GL_TRUE) {
-			make_error_stream("gl::program") << "program link errors:" << std::endl;
-			write_program_log(std::cerr, m_name, from);
+	void program::validate_finished() const {
+		if (!m_pending.empty())
+			throw exception("gl::program", "program has not finished linking.");
+	}
 
-			throw exception("gl::program", "could not link shader sources.");
+	void program::introspect() {
+		if (std::find(m_stages.begin(), m_stages.end(), GL_COMPUTE_SHADER) != m_stages.end()) {
+			GLint size[3];
+			glGetProgramiv(m_name, GL_COMPUTE_WORK_GROUP_SIZE, size);
+			m_work_group_size = glm::uvec3(size[0], size[1], size[2]);
 		}
 
-		// Once the program is set up, the shaders no longer need to be
-		// associated with the `GL_PROGRAM` object.
-		for (const auto& n : names)
-			glDetachShader(m_name, n);
+		m_attributes = attribute::from_program(*this);
+		m_uniforms = uniform::from_program(*this);
+		m_uniform_blocks = uniform_block::from_program(*this);
+		m_storage_blocks = storage_block::from_program(*this);
 	}
 
 	uniform program::operator [](const std::string& name) {
@@ -0,0 +1,272 @@
+#include <heatsink/gl/program_cache.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/shader.hpp>
+
+namespace {
+	using steady_clock = std::chrono::steady_clock;
+
+	// Identifies a file as a heatsink program cache entry.
+	constexpr char g_magic[4] = {'H', 'S', 'P', 'B'};
+	// The extension of cache entries; used to know what `clear()` removes.
+	constexpr auto g_extension = ".hspb";
+
+	// The fixed-size portion of a cache entry, followed by the stages and
+	// the binary data. Entries are only ever read by the machine (and driver)
+	// that wrote them, so the native byte order is used.
+	struct entry_header {
+	public:
+		char magic[4];
+		std::uint64_t key;
+		std::uint32_t format;
+		std::uint32_t stages;
+		std::uint64_t size;
+		// The time taken to compile and link the program, in nanoseconds.
+		std::int64_t link_time;
+	};
+
+	// Accumulate bytes into a 64-bit FNV-1a hash.
+	std::uint64_t hash_bytes(std::uint64_t hash, const void* data, std::size_t size) {
+		const auto* bytes = static_cast<const unsigned char*>(data);
+		for (std::size_t i = 0; i != size; ++i) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3;
+		}
+
+		return hash;
+	}
+
+	// Accumulate a string into a hash, including a terminator so that the
+	// boundaries between consecutive strings affect the result.
+	std::uint64_t hash_string(std::uint64_t hash, const std::string& s) {
+		return hash_bytes(hash, s.c_str(), s.size() + 1);
+	}
+
+	// Retrieve a driver identification string (`GL_VENDOR`, etc.).
+	std::string get_string(GLenum e) {
+		const auto* s = glGetString(e);
+		return s ? reinterpret_cast<const char*>(s) : "";
+	}
+
+	// Read a cache entry; `false` is returned if the file does not exist or
+	// is not a valid entry for the given key.
+	bool read_entry(const std::filesystem::path& path, std::uint64_t key,
+		heatsink::gl::program::binary& result, steady_clock::duration& link_time) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		entry_header header;
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			return false;
+		if (!std::equal(std::begin(g_magic), std::end(g_magic), header.magic) || header.key != key)
+			return false;
+
+		result.format = header.format;
+		result.stages.resize(header.stages);
+		result.data.resize(header.size);
+
+		for (auto& stage : result.stages) {
+			std::uint32_t value;
+			if (!file.read(reinterpret_cast<char*>(&value), sizeof(value)))
+				return false;
+
+			stage = value;
+		}
+
+		if (!file.read(reinterpret_cast<char*>(result.data.data()), (std::streamsize)result.data.size()))
+			return false;
+
+		link_time = std::chrono::nanoseconds(header.link_time);
+		return true;
+	}
+
+	// Write a cache entry. The entry is written to a temporary file first, so
+	// that a partially written entry is never read by another process.
+	bool write_entry(const std::filesystem::path& path, std::uint64_t key,
+		const heatsink::gl::program::binary& b, steady_clock::duration link_time) {
+		auto temp = path;
+		temp += ".tmp";
+
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+				return false;
+
+			entry_header header = {};
+			std::copy(std::begin(g_magic), std::end(g_magic), header.magic);
+			header.key       = key;
+			header.format    = b.format;
+			header.stages    = (std::uint32_t)b.stages.size();
+			header.size      = b.data.size();
+			header.link_time = std::chrono::duration_cast<std::chrono::nanoseconds>(link_time).count();
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			for (auto stage : b.stages) {
+				auto value = (std::uint32_t)stage;
+				file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+			}
+
+			file.write(reinterpret_cast<const char*>(b.data.data()), (std::streamsize)b.data.size());
+			if (!file)
+				return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temp, path, error);
+		return !error;
+	}
+
+	// Derive the program ID from its paths, like `program::from_files()`.
+	std::string to_from(const std::filesystem::path& path) {
+		auto from = path;
+		while (!from.extension().empty())
+			from = from.stem();
+
+		return from.string();
+	}
+}
+
+namespace heatsink::gl {
+	program_cache::program_cache(std::filesystem::path directory)
+	: m_directory{std::move(directory)}, m_driver{0xcbf29ce484222325}, m_statistics{} {
+		GLint formats;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		if (formats == 0)
+			throw exception("gl::program_cache", "program binaries are not supported.");
+
+		std::filesystem::create_directories(m_directory);
+
+		// Any change to the driver may change (or invalidate) the binary
+		// format, so every identifying string is part of the key.
+		m_driver = hash_string(m_driver, get_string(GL_VENDOR));
+		m_driver = hash_string(m_driver, get_string(GL_RENDERER));
+		m_driver = hash_string(m_driver, get_string(GL_VERSION));
+
+		auto version = context_state::get_current().get_version();
+		m_driver = hash_bytes(m_driver, &version.major, sizeof(version.major));
+		m_driver = hash_bytes(m_driver, &version.minor, sizeof(version.minor));
+	}
+
+	program program_cache::load(const std::vector<std::filesystem::path>& paths) {
+		assert(!paths.empty());
+
+		std::vector<GLenum> stages;
+		std::vector<std::string> sources;
+		std::vector<std::string> ids;
+		for (const auto& p : paths) {
+			stages.push_back(shader::to_stage(p));
+			sources.push_back(shader::read_source(p));
+			ids.push_back(p.filename().string());
+		}
+
+		return this->load(stages, sources, ids, to_from(paths.front()), nullptr);
+	}
+
+	program program_cache::load(const std::vector<GLenum>& stages, const std::vector<std::string>& sources,
+		const std::string& from, shader_cache* shaders) {
+		return this->load(stages, sources, std::vector<std::string>(stages.size(), from), from, shaders);
+	}
+
+	program program_cache::load(const std::vector<GLenum>& stages, const std::vector<std::string>& sources,
+		const std::vector<std::string>& ids, const std::string& from, shader_cache* shaders) {
+		assert(!stages.empty() && stages.size() == sources.size());
+
+		auto key  = this->make_key(stages, sources);
+		auto path = this->make_path(key);
+
+		auto start = steady_clock::now();
+		program::binary cached;
+		steady_clock::duration link_time;
+		if (read_entry(path, key, cached, link_time)) {
+			try {
+				auto result = program::from_binary(cached, from);
+
+				auto saved = link_time - (steady_clock::now() - start);
+				if (saved > steady_clock::duration::zero())
+					m_statistics.time_saved += std::chrono::duration_cast<std::chrono::nanoseconds>(saved);
+
+				++m_statistics.hits;
+				return result;
+			} catch (const exception&) {
+				// Fall through to a normal link; the entry is overwritten.
+				++m_statistics.rejected;
+			}
+		}
+
+		++m_statistics.misses;
+		start = steady_clock::now();
+
+		// The vector `owned` must exist until the `program` is constructed;
+		// see `program::from_files()`. Cached shaders outlive the program.
+		std::vector<shader> owned;
+		std::vector<program::shader_name> names;
+		for (std::size_t i = 0; i != stages.size(); ++i) {
+			if (shaders) {
+				names.emplace_back(shaders->get_preprocessed(sources[i], stages[i], ids[i]));
+			} else {
+				owned.emplace_back(sources[i], stages[i], ids[i]);
+				names.emplace_back(owned.back());
+			}
+		}
+
+		auto result = program::retrievable(names, from);
+		link_time = steady_clock::now() - start;
+
+		if (!write_entry(path, key, result.get_binary(), link_time)) {
+			make_error_stream("gl::program_cache")
+				<< "could not write cache entry "
+				<< "\"" << path.string() << "\"." << std::endl;
+		}
+
+		return result;
+	}
+
+	void program_cache::clear() {
+		for (const auto& entry : std::filesystem::directory_iterator(m_directory)) {
+			if (entry.path().extension() == g_extension)
+				std::filesystem::remove(entry.path());
+		}
+	}
+
+	const std::filesystem::path& program_cache::get_directory() const {
+		return m_directory;
+	}
+
+	program_cache::statistics program_cache::get_statistics() const {
+		return m_statistics;
+	}
+
+	void program_cache::reset_statistics() {
+		m_statistics = {};
+	}
+
+	std::uint64_t program_cache::make_key(const std::vector<GLenum>& stages, const std::vector<std::string>& sources) const {
+		auto hash = m_driver;
+		for (std::size_t i = 0; i != stages.size(); ++i) {
+			hash = hash_bytes(hash, &stages[i], sizeof(stages[i]));
+			hash = hash_string(hash, sources[i]);
+		}
+
+		return hash;
+	}
+
+	std::filesystem::path program_cache::make_path(std::uint64_t key) const {
+		static constexpr char digits[] = "0123456789abcdef";
+
+		std::string name(16, '0');
+		for (std::size_t i = 0; i != name.size(); ++i)
+			name[name.size() - 1 - i] = digits[(key >> (4 * i)) & 0xf];
+
+		return m_directory / (name + g_extension);
+	}
+}
@@ -0,0 +1,55 @@
+#include <heatsink/gl/program_interface.hpp>
+
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/uniform.hpp>
+#include <heatsink/traits/shader.hpp>
+
+namespace heatsink::gl {
+	program_interface_base::program_interface_base(const program& p, const std::vector<member>& members)
+	: m_program{p.get()} {
+		auto uniforms = uniform::from_program(p);
+
+		for (const auto& m : members) {
+			auto it = uniforms.find(m.name);
+			if (it == uniforms.end()) {
+				make_error_stream("gl::program_interface")
+					<< "could not find uniform "
+					<< "\"" << m.name << "\"." << std::endl;
+
+				throw exception("gl::program_interface", "uniform does not exist.");
+			}
+
+			const auto& u = it->second;
+			if (!shader_traits::is_assignable(u.get_datatype(), m.datatype)) {
+				make_error_stream("gl::program_interface")
+					<< "cannot bind member of datatype "
+					<< to_string(m.datatype) << " "
+					<< "to uniform "
+					<< "\"" << m.name << "\" "
+					<< "of type "
+					<< to_string(u.get_datatype()) << "." << std::endl;
+
+				throw exception("gl::program_interface", "type mismatch.");
+			}
+			if (u.get_size() != m.size) {
+				make_error_stream("gl::program_interface")
+					<< "cannot bind member array "
+					<< "(size=" << m.size << ") "
+					<< "to uniform "
+					<< "\"" << m.name << "\" "
+					<< "(size=" << u.get_size() << ")." << std::endl;
+
+				throw exception("gl::program_interface", "array size mismatch.");
+			}
+
+			m_locations.push_back((GLint)u.get());
+		}
+	}
+
+	GLuint program_interface_base::get_program() const {
+		return m_program;
+	}
+}
@@ -0,0 +1,75 @@
+#include <heatsink/gl/program_pipeline.hpp>
+
+#include <cassert>
+#include <ostream>
+
+#include <heatsink/error/compile.hpp>
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Convert a shader stage to its bit for `glUseProgramStages()`.
+	GLbitfield to_stage_bit(GLenum stage) {
+		switch (stage) {
+			case GL_VERTEX_SHADER:          return GL_VERTEX_SHADER_BIT;
+			case GL_TESS_CONTROL_SHADER:    return GL_TESS_CONTROL_SHADER_BIT;
+			case GL_TESS_EVALUATION_SHADER: return GL_TESS_EVALUATION_SHADER_BIT;
+			case GL_GEOMETRY_SHADER:        return GL_GEOMETRY_SHADER_BIT;
+			case GL_FRAGMENT_SHADER:        return GL_FRAGMENT_SHADER_BIT;
+			case GL_COMPUTE_SHADER:         return GL_COMPUTE_SHADER_BIT;
+
+			default: return 0;
+		}
+	}
+}
+
+namespace heatsink::gl {
+	program_pipeline::program_pipeline(const std::string& from)
+	: object<GL_PROGRAM_PIPELINE>(), m_from{from} {}
+
+	void program_pipeline::set_program(const program& p) {
+		GLbitfield stages = 0;
+		for (auto s : p.get_stages())
+			stages |= to_stage_bit(s);
+
+		this->set_program(stages, p);
+	}
+
+	void program_pipeline::set_program(GLbitfield stages, const program& p) {
+		assert(this->is_valid() && p.is_valid());
+		if (!p.is_separable()) {
+			make_error_stream("gl::program_pipeline")
+				<< "cannot use program "
+				<< "(name=" << p.get() << ") "
+				<< "that was not linked with GL_PROGRAM_SEPARABLE." << std::endl;
+
+			throw exception("gl::program_pipeline", "program is not separable.");
+		}
+
+		glUseProgramStages(this->get(), stages, p.get());
+	}
+
+	void program_pipeline::reset_stages(GLbitfield stages) {
+		assert(this->is_valid());
+		glUseProgramStages(this->get(), stages, 0);
+	}
+
+	void program_pipeline::validate() const {
+		assert(this->is_valid());
+		glValidateProgramPipeline(this->get());
+
+		GLint result;
+		if (glGetProgramPipelineiv(this->get(), GL_VALIDATE_STATUS, &result); result != GL_TRUE) {
+			auto& os = make_error_stream("gl::program_pipeline") << "program pipeline errors:" << std::endl;
+			write_pipeline_log(os, this->get(), m_from);
+
+			throw exception("gl::program_pipeline", "could not validate program pipeline.");
+		}
+	}
+
+	void program_pipeline::use() const {
+		assert(this->is_valid());
+		glUseProgram(0);
+		this->bind();
+	}
+}
@@ -0,0 +1,154 @@
+#include <heatsink/gl/program_reloader.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Derive the program ID from its paths, like `program::from_files()`.
+	std::string to_from(const std::filesystem::path& path) {
+		auto from = path;
+		while (!from.extension().empty())
+			from = from.stem();
+
+		return from.string();
+	}
+
+	// Collect the names of a set of shaders, replacing those given by index.
+	template<class Replacements>
+	std::vector<heatsink::gl::program::shader_name> to_names(
+		const std::vector<heatsink::gl::shader>& shaders, const Replacements& replacements) {
+		std::vector<heatsink::gl::program::shader_name> names;
+		for (std::size_t i = 0; i != shaders.size(); ++i) {
+			auto it = replacements.find(i);
+			names.emplace_back((it != replacements.end()) ? it->second : shaders[i]);
+		}
+
+		return names;
+	}
+}
+
+namespace heatsink::gl {
+	program_reloader::program_reloader() = default;
+
+	program& program_reloader::load(const std::vector<std::filesystem::path>& paths) {
+		assert(!paths.empty());
+
+		entry e;
+		e.paths = paths;
+		for (const auto& p : paths) {
+			e.stages.push_back(shader::to_stage(p));
+			e.shaders.push_back(shader::from_file(p, e.stages.back()));
+		}
+
+		auto names = to_names(e.shaders, e.replacements);
+		e.target   = std::make_unique<program>(names, to_from(paths.front()));
+
+		for (const auto& p : paths)
+			m_watcher.watch(p);
+
+		return *m_entries.emplace_back(std::move(e)).target;
+	}
+
+	void program_reloader::unload(const program& p) {
+		auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const entry& e) {
+			return e.target.get() == &p;
+		});
+		if (it == m_entries.end())
+			throw exception("gl::program_reloader", "program was not loaded by this reloader.");
+
+		for (const auto& path : it->paths)
+			m_watcher.unwatch(path);
+
+		// Any pending build is finished and dropped, so that the queue does
+		// not keep a ticket that will never be taken.
+		if (it->build) {
+			try {
+				m_queue.take(*it->build);
+			} catch (const exception&) {}
+		}
+
+		m_entries.erase(it);
+	}
+
+	std::vector<program*> program_reloader::update() {
+		auto changed = m_watcher.poll();
+		for (auto& e : m_entries) {
+			if (changed.empty())
+				break;
+
+			for (std::size_t i = 0; i != e.paths.size(); ++i) {
+				auto path = std::filesystem::weakly_canonical(e.paths[i]);
+				if (std::find(changed.begin(), changed.end(), path) != changed.end())
+					e.changed.push_back(i);
+			}
+		}
+
+		std::vector<program*> results;
+		m_queue.poll();
+
+		for (auto& e : m_entries) {
+			if (e.build && m_queue.is_ready(*e.build) && this->complete(e))
+				results.push_back(e.target.get());
+			if (!e.build && !e.changed.empty())
+				this->rebuild(e);
+		}
+
+		return results;
+	}
+
+	bool program_reloader::is_pending(const program& p) const {
+		return std::any_of(m_entries.begin(), m_entries.end(), [&](const entry& e) {
+			return e.target.get() == &p && e.build.has_value();
+		});
+	}
+
+	void program_reloader::rebuild(entry& e) {
+		assert(!e.build);
+
+		std::sort(e.changed.begin(), e.changed.end());
+		e.changed.erase(std::unique(e.changed.begin(), e.changed.end()), e.changed.end());
+
+		for (auto i : e.changed) {
+			// A file may be caught in the middle of being replaced; it will be
+			// reported again once it has been written.
+			try {
+				auto source = shader::read_source(e.paths[i]);
+				e.replacements.insert_or_assign(i, shader::deferred(source, e.stages[i], e.paths[i].filename().string()));
+			} catch (const exception&) {}
+		}
+
+		e.changed.clear();
+		if (e.replacements.empty())
+			return;
+
+		e.build = m_queue.submit(to_names(e.shaders, e.replacements), to_from(e.paths.front()));
+	}
+
+	bool program_reloader::complete(entry& e) {
+		assert(e.build);
+		auto ticket = *e.build;
+		e.build.reset();
+
+		try {
+			*e.target = m_queue.take(ticket);
+		} catch (const exception&) {
+			make_error_stream("gl::program_reloader")
+				<< "could not reload program "
+				<< "\"" << to_from(e.paths.front()) << "\"; "
+				<< "keeping the previous version." << std::endl;
+
+			e.replacements.clear();
+			return false;
+		}
+
+		for (auto& [i, s] : e.replacements)
+			e.shaders[i] = std::move(s);
+
+		e.replacements.clear();
+		return true;
+	}
+}
@@ -0,0 +1,80 @@
+#include <heatsink/gl/query.hpp>
+
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace heatsink::gl {
+	query::query(GLenum target)
+	: object<GL_QUERY>(target) {}
+
+	void query::begin() {
+		assert(this->is_valid());
+		if (this->get_target() == GL_TIMESTAMP)
+			throw exception("gl::query", "cannot begin timestamp query.");
+
+		// Binding a query name begins it; see `name_traits<GL_QUERY>`.
+		this->bind();
+	}
+
+	void query::end() {
+		assert(this->is_valid());
+		if (this->get_target() == GL_TIMESTAMP)
+			throw exception("gl::query", "cannot end timestamp query.");
+
+		glEndQuery(this->get_target());
+	}
+
+	void query::record() {
+		assert(this->is_valid());
+		if (this->get_target() != GL_TIMESTAMP)
+			throw exception("gl::query", "only timestamp queries can be recorded.");
+
+		glQueryCounter(this->get(), GL_TIMESTAMP);
+	}
+
+	bool query::is_available() const {
+		assert(this->is_valid());
+		GLuint result;
+		glGetQueryObjectuiv(this->get(), GL_QUERY_RESULT_AVAILABLE, &result);
+
+		return (result == GL_TRUE);
+	}
+
+	std::uint64_t query::get_result() const {
+		assert(this->is_valid());
+		GLuint64 result;
+		glGetQueryObjectui64v(this->get(), GL_QUERY_RESULT, &result);
+
+		return result;
+	}
+
+	conditional_render::conditional_render(const query& q, GLenum mode)
+	: m_active{false} {
+		assert(q.is_valid());
+		auto target = q.get_target();
+		if (target != GL_SAMPLES_PASSED && target != GL_ANY_SAMPLES_PASSED && target != GL_ANY_SAMPLES_PASSED_CONSERVATIVE) {
+			make_error_stream("gl::conditional_render")
+				<< "cannot render conditionally on query target "
+				<< to_string(target) << "." << std::endl;
+
+			throw exception("gl::conditional_render", "query is not an occlusion query.");
+		}
+
+		glBeginConditionalRender(q.get(), mode);
+		m_active = true;
+	}
+
+	conditional_render::conditional_render(std::nullptr_t)
+	: m_active{false} {}
+
+	conditional_render::~conditional_render() {
+		if (m_active)
+			glEndConditionalRender();
+	}
+
+	bool conditional_render::is_active() const {
+		return m_active;
+	}
+}
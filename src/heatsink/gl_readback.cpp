@@ -0,0 +1,63 @@
+#include <heatsink/gl/readback.hpp>
+
+#include <cassert>
+#include <utility>
+
+#include <heatsink/error/exception.hpp>
+#include <heatsink/traits/name.hpp>
+
+namespace heatsink::gl {
+	readback::readback(buffer&& b)
+	: m_buffer{std::move(b)}, m_fence{} {}
+
+	bool readback::is_ready() const {
+		return m_fence.is_signaled();
+	}
+
+	void readback::wait() const {
+		m_fence.wait();
+	}
+
+	std::size_t readback::get_size() const {
+		return m_buffer.get_size();
+	}
+
+	const buffer& readback::get_buffer() const {
+		return m_buffer;
+	}
+
+	readback buffer::read() const {
+		assert(this->is_valid());
+		auto result = buffer::immutable(GL_PIXEL_PACK_BUFFER, m_size, GL_MAP_READ_BIT);
+		result.copy(const_view(*this));
+
+		return readback(std::move(result));
+	}
+
+	readback texture::read(std::size_t mip, pixel_format format) const {
+		assert(this->is_valid());
+		if (mip >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+
+		auto t = this->get_target();
+		if (texture_traits::is_multisample(t))
+			throw exception("gl::texture", "cannot read multisample texture directly.");
+		if (texture_traits::is_cubemap(t) && m_extents.z != 1)
+			throw exception("gl::texture", "cannot read multiple cubemap faces simultaneously.");
+
+		auto size   = size_of(this->get_extents(mip), format);
+		auto result = buffer::immutable(GL_PIXEL_PACK_BUFFER, size, GL_MAP_READ_BIT);
+		// The buffer is sized for tightly packed rows, which the default
+		// (4-byte) row alignment would pad past the end of the buffer.
+		{
+			auto alignment = pixel_store_scope(GL_PACK_ALIGNMENT, 1);
+			result.bind();
+			this->download(mip, size, format);
+		}
+		// Leaving the pack buffer bound would redirect every later client
+		// read (such as `glReadPixels()`) into it.
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_PACK_BUFFER);
+
+		return readback(std::move(result));
+	}
+}
@@ -0,0 +1,93 @@
+#include <heatsink/gl/render_target_pool.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/traits/texture.hpp>
+
+namespace heatsink::gl {
+	render_target_pool::render_target_pool(std::size_t lifetime)
+	: m_lifetime{lifetime}, m_frame{0} {}
+
+	texture render_target_pool::acquire(GLenum ifmt, glm::uvec2 size, std::size_t samples) {
+		auto k  = key(ifmt, size.x, size.y, samples);
+		auto it = m_free.find(k);
+
+		if (it != m_free.end() && !it->second.empty()) {
+			auto t = std::move(it->second.back().target);
+			it->second.pop_back();
+			if (it->second.empty())
+				m_free.erase(it);
+
+			m_acquired.insert_or_assign(t.get(), k);
+			return t;
+		}
+
+		auto t = (samples == 0)
+			? texture::immutable(GL_TEXTURE_2D, ifmt, size)
+			: texture::multisample(GL_TEXTURE_2D_MULTISAMPLE, ifmt, size, samples);
+
+		// A name may still be recorded if an acquired texture was destroyed
+		// instead of released, and the name was since reused by OpenGL.
+		m_acquired.insert_or_assign(t.get(), k);
+		return t;
+	}
+
+	void render_target_pool::release(texture&& t) {
+		auto it = m_acquired.find(t.get());
+		if (it == m_acquired.end()) {
+			make_error_stream("gl::render_target_pool")
+				<< "cannot release texture "
+				<< "(name=" << t.get() << ") "
+				<< "that was not acquired from this pool." << std::endl;
+
+			throw exception("gl::render_target_pool", "unknown render target.");
+		}
+
+		// The name may be that of a texture acquired earlier, but destroyed
+		// and reused since; it must never be filed under the wrong key.
+		auto [ifmt, width, height, samples] = it->second;
+		auto size = t.get_extents().get(1);
+		if (t.get_format() != ifmt || size.x != width || size.y != height || texture_traits::is_multisample(t.get_target()) != (samples != 0)) {
+			m_acquired.erase(it);
+			throw exception("gl::render_target_pool", "render target does not match its acquisition.");
+		}
+
+		m_free[it->second].push_back(entry{std::move(t), m_frame});
+		m_acquired.erase(it);
+	}
+
+	void render_target_pool::advance() {
+		++m_frame;
+		for (auto it = m_free.begin(); it != m_free.end();) {
+			// Free lists are appended to in release order, so the oldest
+			// entries are always at the front.
+			auto& entries = it->second;
+			auto expired  = std::find_if(entries.begin(), entries.end(), [&](const entry& e) {
+				return m_frame - e.frame <= m_lifetime;
+			});
+
+			entries.erase(entries.begin(), expired);
+			it = entries.empty() ? m_free.erase(it) : std::next(it);
+		}
+	}
+
+	void render_target_pool::clear() {
+		m_free.clear();
+	}
+
+	std::size_t render_target_pool::get_free_count() const {
+		std::size_t count = 0;
+		for (const auto& [k, entries] : m_free)
+			count += entries.size();
+
+		return count;
+	}
+
+	std::size_t render_target_pool::get_acquired_count() const {
+		return m_acquired.size();
+	}
+}
@@ -0,0 +1,169 @@
+#include <heatsink/gl/residency_tracker.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+
+#include <glm/gtx/string_cast.hpp>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/pixel_format.hpp>
+#include <heatsink/traits/format.hpp>
+#include <heatsink/traits/texture.hpp>
+
+namespace {
+	using texture_traits = heatsink::gl::texture_traits;
+
+	// See `spatial_rank()` in `gl_texture.cpp`.
+	std::size_t spatial_rank(GLenum target) {
+		auto rank = texture_traits::rank(target);
+		if (texture_traits::is_array(target) || texture_traits::is_cubemap(target))
+			return rank - 1;
+		else
+			return rank;
+	}
+}
+
+namespace heatsink::gl {
+	residency_tracker::residency_tracker(texture& t, std::size_t budget)
+	: m_texture{&t}, m_budget{budget}, m_frame{0} {
+		if (!t.is_sparse())
+			throw exception("gl::residency_tracker", "texture is not sparse.");
+
+		auto format = t.get_format();
+		m_levels    = t.get_sparse_level_count();
+		m_page      = t.get_page_size();
+
+		// Layers are committed one at a time, regardless of the page depth.
+		if (spatial_rank(t.get_target()) < 3)
+			m_page.z = 1;
+
+		if (format_traits::is_compressed(format))
+			m_page_size = format_traits::compressed_size(format, m_page.x, m_page.y, m_page.z);
+		else
+			m_page_size = (std::size_t)m_page.x * m_page.y * m_page.z * size_of(pixel_format(format));
+
+		// Any level of the tail commits all of it.
+		if (m_levels < t.get_mipmap_count())
+			t.commit(m_levels);
+	}
+
+	residency_tracker::status residency_tracker::request(const page& p) {
+		auto k = this->to_key(p);
+		if (auto it = m_pages.find(k); it != m_pages.end()) {
+			m_recent.splice(m_recent.begin(), m_recent, it->second.position);
+			it->second.frame = m_frame;
+
+			return status::resident;
+		}
+
+		while (this->get_resident_size() + m_page_size > m_budget) {
+			// The oldest page is at the back; if even that one is in use,
+			// nothing can be evicted this frame.
+			if (m_recent.empty() || m_pages.at(m_recent.back()).frame == m_frame)
+				return status::rejected;
+
+			auto oldest = m_recent.back();
+			this->set_commitment(oldest, false);
+			m_pages.erase(oldest);
+			m_recent.pop_back();
+		}
+
+		this->set_commitment(k, true);
+		m_recent.push_front(k);
+		m_pages.emplace(k, record{m_recent.begin(), m_frame});
+
+		return status::committed;
+	}
+
+	void residency_tracker::release(const page& p) {
+		auto k = this->to_key(p);
+		if (auto it = m_pages.find(k); it != m_pages.end()) {
+			this->set_commitment(k, false);
+			m_recent.erase(it->second.position);
+			m_pages.erase(it);
+		}
+	}
+
+	void residency_tracker::advance() {
+		++m_frame;
+	}
+
+	bool residency_tracker::is_resident(const page& p) const {
+		return m_pages.contains(this->to_key(p));
+	}
+
+	texture::view residency_tracker::make_view(const page& p) const {
+		auto [mip, x, y, z] = this->to_key(p);
+
+		auto t     = m_texture->get_target();
+		auto rank  = texture_traits::rank(t);
+		auto n     = spatial_rank(t);
+		auto whole = m_texture->get_extents().get(1);
+		auto level = m_texture->get_extents(mip).get(1);
+
+		// Views are specified at the base level, so the page is scaled up;
+		// pages at the edge of a level are clamped to it.
+		auto index  = glm::uvec3(x, y, z);
+		auto offset = index * m_page;
+		auto size   = glm::min(m_page, level - offset);
+		for (std::size_t i = 0; i != 3; ++i) {
+			if (i >= n)
+				continue;
+
+			offset[i] <<= mip;
+			size[i]     = std::min(size[i] << mip, whole[i] - offset[i]);
+		}
+
+		return m_texture->make_view(texture::extents(offset, rank), texture::extents(size, rank));
+	}
+
+	glm::uvec3 residency_tracker::get_page_count(std::size_t mip) const {
+		auto level = m_texture->get_extents(mip).get(1);
+		return (level + m_page - glm::uvec3(1)) / m_page;
+	}
+
+	glm::uvec3 residency_tracker::get_page_extents() const {
+		return m_page;
+	}
+
+	std::size_t residency_tracker::get_page_size() const {
+		return m_page_size;
+	}
+
+	std::size_t residency_tracker::get_resident_size() const {
+		return m_pages.size() * m_page_size;
+	}
+
+	std::size_t residency_tracker::get_budget() const {
+		return m_budget;
+	}
+
+	residency_tracker::key residency_tracker::to_key(const page& p) const {
+		if (p.mip >= m_levels)
+			throw exception("gl::residency_tracker", "page is not in a sparse mipmap level.");
+
+		if (!glm::all(glm::lessThan(p.index, this->get_page_count(p.mip)))) {
+			make_error_stream("gl::residency_tracker")
+				<< "page "
+				<< "(mip=" << p.mip << ", index=" << glm::to_string(p.index) << ") "
+				<< "is outside of level "
+				<< "(pages=" << glm::to_string(this->get_page_count(p.mip)) << ")." << std::endl;
+
+			throw exception("gl::residency_tracker", "page out of bounds.");
+		}
+
+		return key(p.mip, p.index.x, p.index.y, p.index.z);
+	}
+
+	void residency_tracker::set_commitment(const key& k, bool commit) {
+		auto p = page{std::get<0>(k), glm::uvec3(std::get<1>(k), std::get<2>(k), std::get<3>(k))};
+		auto v = this->make_view(p);
+
+		if (commit)
+			v.commit(p.mip);
+		else
+			v.decommit(p.mip);
+	}
+}
@@ -0,0 +1,145 @@
+#include <heatsink/gl/ring_buffer.hpp>
+
+#include <numeric>
+#include <ostream>
+#include <utility>
+
+#include <heatsink/error/debug.hpp>
+
+namespace {
+	// The storage is only ever written by the CPU, and must stay mapped while
+	// the GPU is reading from it.
+	constexpr GLbitfield g_access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	// Round the value up to the nearest multiple of the alignment. Note that
+	// the alignment does not have to be a power of two (such as for structs).
+	std::size_t align_up(std::size_t value, std::size_t align) {
+		return ((value + align - 1) / align) * align;
+	}
+
+	// Retrieve the minimum offset alignment for ranges bound to the target.
+	std::size_t target_alignment(GLenum target) {
+		GLint result = 1;
+		switch (target) {
+			case GL_UNIFORM_BUFFER:
+				glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &result);
+				break;
+			case GL_SHADER_STORAGE_BUFFER:
+				glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &result);
+				break;
+			case GL_TEXTURE_BUFFER:
+				glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &result);
+				break;
+		}
+
+		return (result > 0) ? (std::size_t)result : 1;
+	}
+}
+
+namespace heatsink::gl {
+	ring_buffer::ring_buffer(GLenum target, std::size_t size, std::size_t frames)
+	: m_buffer{buffer::immutable(target, align_up(size, target_alignment(target)) * frames, g_access)},
+	  m_mapping{m_buffer.map(g_access)}, m_alignment{target_alignment(target)},
+	  m_frame_size{align_up(size, m_alignment)}, m_frame{0}, m_head{0} {
+		// An immutable buffer (above) already throws for an empty size.
+		assert(frames > 0);
+
+		// Fences are not copyable, so they cannot be filled by the constructor.
+		m_fences.reserve(frames);
+		for (std::size_t i = 0; i != frames; ++i)
+			m_fences.push_back(fence::null());
+	}
+
+	ring_buffer::ring_buffer(ring_buffer&& other) noexcept
+	: m_buffer{std::move(other.m_buffer)}, m_mapping{std::move(other.m_mapping)},
+	  m_fences{std::move(other.m_fences)}, m_alignment{other.m_alignment}, m_frame_size{other.m_frame_size},
+	  m_frame{other.m_frame}, m_head{other.m_head} {
+		other.m_fences.clear();
+	}
+
+	ring_buffer::~ring_buffer() {}
+
+	ring_buffer& ring_buffer::operator =(ring_buffer&& other) noexcept {
+		// The mapping must be released before the buffer it refers to.
+		m_mapping = std::move(other.m_mapping);
+		m_buffer  = std::move(other.m_buffer);
+
+		m_fences     = std::exchange(other.m_fences, {});
+		m_alignment  = other.m_alignment;
+		m_frame_size = other.m_frame_size;
+		m_frame      = other.m_frame;
+		m_head       = other.m_head;
+
+		return *this;
+	}
+
+	buffer::view ring_buffer::allocate(std::size_t size, std::size_t align) {
+		assert(this->is_valid() && align > 0);
+
+		// The absolute position is aligned, not the offset within the frame;
+		// the frame size is only a multiple of the target alignment, so frames
+		// after the first may not start on a multiple of `align`.
+		auto base   = m_frame * m_frame_size;
+		auto offset = align_up(base + m_head, std::lcm(align, m_alignment)) - base;
+		if (offset + size > m_frame_size) {
+			make_error_stream("gl::ring_buffer")
+				<< "could not allocate range "
+				<< "(size=" << size << ", align=" << align << ") "
+				<< "from frame "
+				<< "(size=" << m_frame_size << ", remaining=" << this->get_remaining() << ")." << std::endl;
+
+			throw exception("gl::ring_buffer", "frame capacity exceeded.");
+		}
+
+		m_head = offset + size;
+		return m_buffer.make_view(base + offset, size);
+	}
+
+	void ring_buffer::advance() {
+		assert(this->is_valid());
+
+		// Guard the frame that was just written; the fence is signaled once
+		// every command that could read from it has completed.
+		m_fences[m_frame] = fence();
+
+		m_frame = (m_frame + 1) % m_fences.size();
+		m_head  = 0;
+
+		// The CPU only has to wait if it has caught up to the GPU.
+		if (auto& f = m_fences[m_frame]; f.is_valid()) {
+			f.wait();
+			f = fence::null();
+		}
+	}
+
+	bool ring_buffer::would_block() const {
+		assert(this->is_valid());
+
+		const auto& f = m_fences[(m_frame + 1) % m_fences.size()];
+		return (f.is_valid() && !f.is_signaled());
+	}
+
+	bool ring_buffer::is_valid() const {
+		return (m_mapping.is_valid() && !m_fences.empty());
+	}
+
+	const buffer& ring_buffer::get_buffer() const {
+		assert(this->is_valid());
+		return m_buffer;
+	}
+
+	std::size_t ring_buffer::get_frame_count() const {
+		assert(this->is_valid());
+		return m_fences.size();
+	}
+
+	std::size_t ring_buffer::get_frame_size() const {
+		assert(this->is_valid());
+		return m_frame_size;
+	}
+
+	std::size_t ring_buffer::get_remaining() const {
+		assert(this->is_valid());
+		return m_frame_size - m_head;
+	}
+}
@@ -0,0 +1,60 @@
+#include <heatsink/gl/sampler.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#include <heatsink/gl/context_state.hpp>
+
+namespace {
+	// Retrieve the largest supported anisotropy, or `0` if anisotropic
+	// filtering is not supported (it is core in OpenGL 4.6).
+	GLfloat get_max_anisotropy() {
+		auto supported = heatsink::gl::context_state::get_current().get_version() >= heatsink::context::version{4,6}
+			|| epoxy_has_gl_extension("GL_ARB_texture_filter_anisotropic")
+			|| epoxy_has_gl_extension("GL_EXT_texture_filter_anisotropic");
+		if (!supported)
+			return 0.0f;
+
+		GLfloat max = 0.0f;
+		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &max);
+		return max;
+	}
+}
+
+namespace heatsink::gl {
+	void sampler::unbind(std::size_t unit) {
+		name_traits<GL_SAMPLER>::bind(0, unit);
+	}
+
+	sampler::sampler(const parameters& p)
+	: object<GL_SAMPLER>(), m_parameters{p} {
+		// Sampler parameters are always set by name; there is no bind-to-edit
+		// variant to choose between.
+		auto name = this->get();
+		glSamplerParameteri(name, GL_TEXTURE_MIN_FILTER, p.min_filter);
+		glSamplerParameteri(name, GL_TEXTURE_MAG_FILTER, p.mag_filter);
+
+		glSamplerParameteri(name, GL_TEXTURE_WRAP_S, p.wrap_s);
+		glSamplerParameteri(name, GL_TEXTURE_WRAP_T, p.wrap_t);
+		glSamplerParameteri(name, GL_TEXTURE_WRAP_R, p.wrap_r);
+
+		glSamplerParameterf(name, GL_TEXTURE_MIN_LOD,  p.min_lod);
+		glSamplerParameterf(name, GL_TEXTURE_MAX_LOD,  p.max_lod);
+		glSamplerParameterf(name, GL_TEXTURE_LOD_BIAS, p.lod_bias);
+
+		glSamplerParameteri(name, GL_TEXTURE_COMPARE_MODE, p.compare_mode);
+		glSamplerParameteri(name, GL_TEXTURE_COMPARE_FUNC, p.compare_func);
+
+		glSamplerParameterfv(name, GL_TEXTURE_BORDER_COLOR, p.border_color.data());
+
+		if (p.anisotropy > 1.0f) {
+			if (auto max = get_max_anisotropy(); max > 0.0f)
+				glSamplerParameterf(name, GL_TEXTURE_MAX_ANISOTROPY, std::min(p.anisotropy, max));
+		}
+	}
+
+	const sampler::parameters& sampler::get_parameters() const {
+		assert(this->is_valid());
+		return m_parameters;
+	}
+}
@@ -0,0 +1,23 @@
+#include <heatsink/gl/sampler_cache.hpp>
+
+namespace heatsink::gl {
+	const sampler& sampler_cache::get(const sampler::parameters& p) {
+		auto it = m_samplers.find(p);
+		if (it == m_samplers.end())
+			it = m_samplers.emplace(p, sampler(p)).first;
+
+		return it->second;
+	}
+
+	void sampler_cache::bind(const sampler::parameters& p, std::size_t unit) {
+		this->get(p).bind(unit);
+	}
+
+	void sampler_cache::clear() {
+		m_samplers.clear();
+	}
+
+	std::size_t sampler_cache::get_size() const {
+		return m_samplers.size();
+	}
+}
@@ -1,30 +1,25 @@
 #include <heatsink/gl/shader.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
-#include <iostream>
+#include <ostream>
 
 #include <heatsink/error/compile.hpp>
 #include <heatsink/error/debug.hpp>
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
 
-namespace {
-	// Read the contents of the specified file.
-	std::string read_string(const std::filesystem::path& path) {
-		std::ifstream data(path.native());
-		if (!data.is_open()) {
-			heatsink::make_error_stream("gl::shader")
-				<< "unknown path "
-				<< "\"" << path.string() << "\"." << std::endl;
-			
-			throw heatsink::exception("gl::shader", "could not open path.");
-		}
+namespace heatsink::gl {
+	shader shader::from_file(const std::filesystem::path& path, GLenum stage) {
+		auto source = read_source(path);
+		if (stage == GL_NONE)
+			stage = to_stage(path);
 
-		std::istreambuf_iterator<char> begin{data};
-		return std::string(begin, {});
+		return shader(source, stage, path.filename().string());
 	}
 
-	GLenum to_stage(const std::filesystem::path& path) {
+	GLenum shader::to_stage(const std::filesystem::path& path) {
 		auto ext = path.extension();
 		// Find the extension before the ".glsl"
 		if (ext == ".glsl")
@@ -37,31 +32,63 @@ namespace {
 		else if (ext == ".geom") return GL_GEOMETRY_SHADER;
 		else if (ext == ".comp") return GL_COMPUTE_SHADER;
 		else {
-			heatsink::make_error_stream("gl::shader")
+			make_error_stream("gl::shader")
 				<< "unknown file extension "
 				<< "\"" << ext.string() << "\"." << std::endl;
 			
-			throw heatsink::exception("gl::shader", "unknown GLSL source extension.");
+			throw exception("gl::shader", "unknown GLSL source extension.");
 		}
 	}
-}
 
-namespace heatsink::gl {
-	shader shader::from_file(const std::filesystem::path& path, GLenum stage) {
-		auto source = read_string(path);
-		if (stage == GL_NONE)
-			stage = to_stage(path);
+	std::string shader::read_source(const std::filesystem::path& path) {
+		std::ifstream data(path.native());
+		if (!data.is_open()) {
+			make_error_stream("gl::shader")
+				<< "unknown path "
+				<< "\"" << path.string() << "\"." << std::endl;
+			
+			throw exception("gl::shader", "could not open path.");
+		}
 
-		return shader(source, stage, path.filename().string());
+		std::istreambuf_iterator<char> begin{data};
+		return std::string(begin, {});
 	}
 
-	shader::shader(const std::string& src, GLenum stage, const std::string& from)
-	: m_name{glCreateShader(stage)}, m_stage{stage} {
-		this->compile(src, from);
+	std::string shader::preprocess(const std::string& src, const std::map<std::string, std::string>& defines) {
+		if (defines.empty())
+			return src;
+
+		// The `#version` directive must come before anything else, so the
+		// definitions are inserted on the line following it.
+		std::size_t insert = 0;
+		if (auto version = src.find("#version"); version != std::string::npos) {
+			auto end = src.find('\n', version);
+			insert = (end == std::string::npos) ? src.size() : end + 1;
+		}
+
+		auto line = std::count(src.begin(), src.begin() + insert, '\n') + 1;
+
+		std::string injected;
+		if (insert != 0 && src[insert - 1] != '\n')
+			injected += '\n';
+		for (const auto& [name, value] : defines)
+			injected += "#define " + name + (value.empty() ? "" : " " + value) + "\n";
+		injected += "#line " + std::to_string(line) + "\n";
+
+		auto result = src;
+		result.insert(insert, injected);
+		return result;
+	}
+
+	shader shader::deferred(const std::string& src, GLenum stage, const std::string& from) {
+		return shader(src, stage, from, true);
 	}
 
+	shader::shader(const std::string& src, GLenum stage, const std::string& from)
+	: shader(src, stage, from, false) {}
+
 	shader::shader(shader&& other) noexcept
-	: m_name{other.m_name}, m_stage{other.m_stage} {
+	: m_name{other.m_name}, m_stage{other.m_stage}, m_from{std::move(other.m_from)}, m_pending{other.m_pending} {
 		other.m_name = 0;
 	}
 
@@ -74,13 +101,48 @@ namespace heatsink::gl {
 		if (m_name)
 			glDeleteShader(m_name);
 
-		m_name  = other.m_name;
-		m_stage = other.m_stage;
+		m_name    = other.m_name;
+		m_stage   = other.m_stage;
+		m_from    = std::move(other.m_from);
+		m_pending = other.m_pending;
 
 		other.m_name = 0;
 		return *this;
 	}
 
+	shader::shader(const std::string& src, GLenum stage, const std::string& from, bool deferred)
+	: m_name{glCreateShader(stage)}, m_stage{stage}, m_from{from}, m_pending{true} {
+		this->compile(src);
+		if (!deferred)
+			this->finish();
+	}
+
+	bool shader::is_complete() const {
+		assert(this->is_valid());
+		if (!m_pending || !context_state::get_current().has_parallel_shader_compile())
+			return true;
+
+		GLint result;
+		glGetShaderiv(m_name, GL_COMPLETION_STATUS_KHR, &result);
+		return (result == GL_TRUE);
+	}
+
+	void shader::finish() {
+		assert(this->is_valid());
+		if (!m_pending)
+			return;
+
+		// Querying the status blocks until the compile has finished.
+		m_pending = false;
+		GLint result;
+		if (glGetShaderiv(m_name, GL_COMPILE_STATUS, &result); result != GL_TRUE) {
+			auto& os = make_error_stream("gl::shader") << "shader compile errors:" << std::endl;
+			write_shader_log(os, m_name, m_from);
+
+			throw exception("gl::shader", "could not compile shader source.");
+		}
+	}
+
 	bool shader::is_valid() const {
 		return (m_name != 0);
 	}
@@ -95,18 +157,10 @@ namespace heatsink::gl {
 		return m_stage;
 	}
 
-	void shader::compile(const std::string& src, const std::string& from) {
+	void shader::compile(const std::string& src) {
 		const auto* raw = src.c_str();
 		glShaderSource(m_name, 1, &raw, nullptr);
 
 		glCompileShader(m_name);
-
-		GLint result;
-		if (glGetShaderiv(m_name, GL_COMPILE_STATUS, &result); result != GL_TRUE) {
-			make_error_stream("gl::shader") << "shader compile errors:" << std::endl;
-			write_shader_log(std::cerr, m_name, from);
-
-			throw exception("gl::shader", "could not compile shader source.");
-		}
 	}
 }
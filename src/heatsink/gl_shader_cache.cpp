@@ -0,0 +1,54 @@
+#include <heatsink/gl/shader_cache.hpp>
+
+#include <functional>
+#include <string_view>
+
+namespace {
+	// Combine the stage into the source hash, so that identical sources of
+	// different stages are separate entries.
+	std::uint64_t make_key(const std::string& source, GLenum stage) {
+		auto hash = (std::uint64_t)std::hash<std::string_view>{}(source);
+		return hash ^ ((std::uint64_t)stage * 0x9e3779b97f4a7c15);
+	}
+}
+
+namespace heatsink::gl {
+	shader_cache::shader_cache()
+	: m_statistics{} {}
+
+	const shader& shader_cache::get(const std::string& source, GLenum stage, const defines& ds, const std::string& from) {
+		return this->get_preprocessed(shader::preprocess(source, ds), stage, from);
+	}
+
+	const shader& shader_cache::get_preprocessed(const std::string& source, GLenum stage, const std::string& from) {
+		auto key = make_key(source, stage);
+
+		auto [first, last] = m_entries.equal_range(key);
+		for (auto it = first; it != last; ++it) {
+			if (it->second.stage == stage && it->second.source == source) {
+				++m_statistics.hits;
+				return it->second.result;
+			}
+		}
+
+		++m_statistics.misses;
+		auto it = m_entries.emplace(key, entry{stage, source, shader(source, stage, from)});
+		return it->second.result;
+	}
+
+	void shader_cache::clear() {
+		m_entries.clear();
+	}
+
+	std::size_t shader_cache::get_size() const {
+		return m_entries.size();
+	}
+
+	shader_cache::statistics shader_cache::get_statistics() const {
+		return m_statistics;
+	}
+
+	void shader_cache::reset_statistics() {
+		m_statistics = {};
+	}
+}
@@ -0,0 +1,133 @@
+#include <heatsink/gl/storage_block.hpp>
+
+#include <cassert>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/program.hpp>
+
+namespace {
+	GLint get_parameter(GLuint p, GLuint index, GLenum e) {
+		GLint result;
+		glGetProgramResourceiv(p, GL_SHADER_STORAGE_BLOCK, index, 1, &e, 1, nullptr, &result);
+
+		return result;
+	}
+
+	GLuint get_block_index(GLuint p, const std::string& name) {
+		auto index = glGetProgramResourceIndex(p, GL_SHADER_STORAGE_BLOCK, name.c_str());
+		if (index == GL_INVALID_INDEX) {
+			heatsink::make_error_stream("gl::storage_block")
+				<< "unknown storage block name "
+				<< "\"" << name << "\"." << std::endl;
+
+			throw heatsink::exception("gl::storage_block", "could not find storage block index.");
+		}
+
+		return index;
+	}
+
+	std::size_t get_offset_alignment() {
+		GLint result;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &result);
+
+		return (std::size_t)result;
+	}
+}
+
+namespace heatsink::gl {
+	std::map<std::string, storage_block> storage_block::from_program(const program& p) {
+		auto owner = p.get();
+		std::map<std::string, storage_block> results;
+
+		// The program interface queries do not exist before OpenGL 4.3.
+		if (context_state::get_current().get_version() < context::version{4,3})
+			return results;
+
+		GLint count;
+		glGetProgramInterfaceiv(owner, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &count);
+		// The indices are guaranteed to be in the range [0, ACTIVE_RESOURCES).
+		for (GLuint i = 0; i != (GLuint)count; ++i) {
+			auto b = storage_block(owner, i);
+			results.emplace(b.get_name(), b);
+		}
+
+		return results;
+	}
+
+	storage_block::storage_block(const program& p, std::string name)
+	: storage_block(p.get(), get_block_index(p.get(), name)) {}
+
+	storage_block::storage_block(GLuint owner, GLuint index)
+	: m_program{owner}, m_index{index} {
+		m_size    = get_parameter(m_program, m_index, GL_BUFFER_DATA_SIZE);
+		m_binding = get_parameter(m_program, m_index, GL_BUFFER_BINDING);
+
+		auto namelen = get_parameter(m_program, m_index, GL_NAME_LENGTH);
+		// `std::string::resize` does not include the null terminator.
+		m_name.resize(namelen - 1);
+		glGetProgramResourceName(m_program, GL_SHADER_STORAGE_BLOCK, m_index, namelen, nullptr, m_name.data());
+	}
+
+	void storage_block::set_binding(std::size_t index) {
+		assert(this->is_valid());
+		glShaderStorageBlockBinding(m_program, m_index, (GLuint)index);
+
+		m_binding = index;
+	}
+
+	void storage_block::bind(const buffer::const_view& v) const {
+		assert(this->is_valid());
+		if (v.get_target() != GL_SHADER_STORAGE_BUFFER)
+			throw exception("gl::storage_block", "storage block must be sourced from storage buffer.");
+
+		if (v.get_size() < m_size) {
+			make_error_stream("gl::storage_block")
+				<< "cannot bind buffer view "
+				<< "(size=" << v.get_size() << ") "
+				<< "to storage block "
+				<< "\"" << m_name << "\" "
+				<< "(size=" << m_size << ")." << std::endl;
+
+			throw exception("gl::storage_block", "buffer view too small for block.");
+		}
+
+		if (auto align = get_offset_alignment(); v.get_offset() % align != 0) {
+			make_error_stream("gl::storage_block")
+				<< "buffer view offset " << v.get_offset() << " "
+				<< "is not a multiple of "
+				<< "GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT "
+				<< "(" << align << ")." << std::endl;
+
+			throw exception("gl::storage_block", "misaligned buffer view.");
+		}
+
+		v.bind_range(m_binding);
+	}
+
+	bool storage_block::is_valid() const {
+		return (m_index != GL_INVALID_INDEX);
+	}
+
+	GLuint storage_block::get() const {
+		assert(this->is_valid());
+		return m_index;
+	}
+
+	const std::string& storage_block::get_name() const {
+		assert(this->is_valid());
+		return m_name;
+	}
+
+	std::size_t storage_block::get_size() const {
+		assert(this->is_valid());
+		return m_size;
+	}
+
+	std::size_t storage_block::get_binding() const {
+		assert(this->is_valid());
+		return m_binding;
+	}
+}
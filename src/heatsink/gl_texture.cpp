@@ -1,11 +1,36 @@
 #include <heatsink/gl/texture.hpp>
 
+#include <algorithm>
+
+#include <heatsink/traits/format.hpp>
+
 namespace {
-	//
+	using texture_traits = heatsink::gl::texture_traits;
+
+	// Determine how many of the (leading) dimensions of a texture target are
+	// reduced between mipmap levels; the layer dimension of an array texture
+	// (or the faces of a cubemap) stays the same at every level.
+	std::size_t spatial_rank(GLenum target) {
+		auto rank = texture_traits::rank(target);
+		if (texture_traits::is_array(target) || texture_traits::is_cubemap(target))
+			return rank - 1;
+		else
+			return rank;
+	}
+
+	// Scale a position or size to the given mipmap level. Reduced components
+	// are clamped to the given minimum (`1` for sizes, `0` for positions).
+	glm::uvec3 scale_to_mip(GLenum target, glm::uvec3 v, std::size_t mip, glm::uvec3::value_type min) {
+		auto n = spatial_rank(target);
+		for (std::size_t i = 0; i != n; ++i)
+			v[i] = std::max(v[i] >> mip, min);
+
+		return v;
+	}
 }
 
 namespace heatsink::gl {
-	texture texture::immutable(GLenum target, GLenum ifmt, extents es, std::size_t mips) {
+	texture texture::immutable(GLenum target, GLenum ifmt, extents es, std::size_t mips, bool sparse) {
 		assert(!texture_traits::is_multisample(target));
 		assert(es.get_length() == texture_traits::rank(target));
 		assert(mips > 0);
@@ -18,18 +43,37 @@ namespace heatsink::gl {
 
 		// TODO: validate mip count.
 
-		return texture(target, ifmt, es, mips);
+		if (sparse && !epoxy_has_gl_extension("GL_ARB_sparse_texture"))
+			throw exception("gl::texture", "sparse textures are not supported.");
+		// Formats without any virtual page size cannot be sparse.
+		if (sparse && glm::any(glm::equal(texture_traits::page_size(target, ifmt), glm::uvec3(0)))) {
+			make_error_stream("gl::texture")
+				<< "cannot allocate sparse storage of format "
+				<< to_string(ifmt) << "." << std::endl;
+
+			throw exception("gl::texture", "format cannot be sparse.");
+		}
+
+		auto result = texture(target, ifmt, es, mips, 0, false, sparse);
+		// Sparse storage holds no memory until it is committed.
+		if (!sparse)
+			result.track_storage(1);
+
+		return result;
 	}
 
 	texture texture::multisample(GLenum target, GLenum ifmt, extents es, std::size_t n, bool fix) {
 		assert(texture_traits::is_multisample(target));
 		assert(n > 0);
 
-		return texture(target, ifmt, es, n, fix);
+		auto result = texture(target, ifmt, es, 1, n, fix, false);
+		result.track_storage(n);
+
+		return result;
 	}
 
 	texture::texture(GLenum target)
-	: object<GL_TEXTURE>(target), m_immutable{false}, m_base{}, m_format{GL_NONE} {
+	: object<GL_TEXTURE>(target), m_immutable{false}, m_sparse{false}, m_base{}, m_extents{}, m_bounds{}, m_format{GL_NONE}, m_levels{0}, m_page{0}, m_sparse_levels{0} {
 		assert(!texture_traits::is_multisample(target));
 	}
 
@@ -39,9 +83,10 @@ namespace heatsink::gl {
 	}
 
 	texture::texture(const texture& t, extents offset, extents size)
-	: object<GL_TXETURE>(t), m_immutable{t.m_immutable}, m_levels{t.m_levels} {
+	: object<GL_TEXTURE>(t), m_immutable{t.m_immutable}, m_sparse{t.m_sparse}, m_bounds{t.m_bounds}, m_format{t.m_format}, m_levels{t.m_levels},
+	  m_page{t.m_page}, m_sparse_levels{t.m_sparse_levels} {
 		assert(t.is_valid());
-		
+
 		auto rank = texture_traits::rank(t.get_target());
 		assert(offset.get_length() == rank && size.get_length() == rank);
 
@@ -55,46 +100,706 @@ namespace heatsink::gl {
 		m_extents = es;
 	}
 
-	texture::texture(GLenum target, GLenum ifmt, extents es, std::size_t mips)
-	: object<GL_TEXTURE>(target), m_immutable{true}, m_base{}, m_extents{es.get(1)}, m_format{ifmt}, m_levels{mips} {
-		auto t = this->get_target();
+	texture::texture(GLenum target, GLenum ifmt, extents es, std::size_t mips, std::size_t n, bool fix, bool sparse)
+	: object<GL_TEXTURE>(target), m_immutable{true}, m_sparse{sparse}, m_base{}, m_extents{es.get(1)}, m_bounds{m_extents}, m_format{ifmt}, m_levels{mips},
+	  m_page{0}, m_sparse_levels{0} {
+		auto t    = this->get_target();
+		auto rank = texture_traits::rank(t);
+		if (t == GL_TEXTURE_CUBE_MAP) {
+			// Cubemap storage can be allocated using the 2D method. Note that
+			// unlike setting data, storage for all 6 faces is allocated.
+			rank = 2;
+		}
+
+		auto e = m_extents;
+		if (has_direct_state_access()) {
+			auto name = this->get();
+			if (n != 0) {
+				// Note that there are no 1D multisample textures.
+				switch (rank) {
+					case 2: glTextureStorage2DMultisample(name, n, m_format, e.x, e.y,      fix); break;
+					case 3: glTextureStorage3DMultisample(name, n, m_format, e.x, e.y, e.z, fix); break;
+				}
+
+				return;
+			}
+
+			glTextureParameteri(name, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+			// Sparse storage must be requested before the storage is allocated.
+			if (m_sparse)
+				glTextureParameteri(name, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+
+			switch (rank) {
+				case 1: glTextureStorage1D(name, m_levels, m_format, e.x          ); break;
+				case 2: glTextureStorage2D(name, m_levels, m_format, e.x, e.y     ); break;
+				case 3: glTextureStorage3D(name, m_levels, m_format, e.x, e.y, e.z); break;
+			}
+
+			this->query_sparse();
+			return;
+		}
 
 		this->bind(0);
+		if (n != 0) {
+			switch (rank) {
+				case 2: glTexStorage2DMultisample(t, n, m_format, e.x, e.y,      fix); break;
+				case 3: glTexStorage3DMultisample(t, n, m_format, e.x, e.y, e.z, fix); break;
+			}
+
+			return;
+		}
+
 		glTexParameteri(t, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+		if (m_sparse)
+			glTexParameteri(t, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
 
+		switch (rank) {
+			case 1: glTexStorage1D(t, m_levels, m_format, e.x          ); break;
+			case 2: glTexStorage2D(t, m_levels, m_format, e.x, e.y     ); break;
+			case 3: glTexStorage3D(t, m_levels, m_format, e.x, e.y, e.z); break;
+		}
+
+		this->query_sparse();
+	}
+
+	void texture::set(GLenum ifmt, extents es, std::size_t mips) {
+		assert(this->is_valid() && !this->is_immutable());
+		assert(m_base == glm::uvec3(0));
+		assert(mips > 0);
+
+		auto t    = this->get_target();
 		auto rank = texture_traits::rank(t);
+		if (rank != es.get_length()) {
+			make_error_stream("gl::texture")
+				<< "cannot allocate "
+				<< es.get_length() << "-dimensional "
+				<< "storage for "
+				<< rank << "-dimensional "
+				<< "texture." << std::endl;
+
+			throw exception("gl::texture", "data dimension mismatch.");
+		}
+
+		// Like the data variant, allocating `0` bytes is silently ignored.
+		if (es == extents::zero(rank))
+			return;
+		if (auto zeroes = glm::equal(es.get(1), glm::uvec3(0)); glm::any(zeroes))
+			throw exception("gl::texture", "invalid texture extents.");
+		// A normal cubemap always has all six faces allocated at once.
+		if (t == GL_TEXTURE_CUBE_MAP && es.get(1).z != 6)
+			throw exception("gl::texture", "cubemap must be allocated with six faces.");
+
+		m_extents = es.get(1);
+		m_bounds  = m_extents;
+		m_format  = ifmt;
+		m_levels  = mips;
+
+		// No data is uploaded, but the format/type must still be compatible
+		// with the internal format (for example, for depth textures).
+		auto format = pixel_format(ifmt);
+		auto pfmt   = format.get();
+		auto ptype  = format.get_datatype();
+		// Compressed formats have no natural data type, but any will do.
+		if (format_traits::is_compressed(ifmt))
+			ptype = GL_UNSIGNED_BYTE;
+
+		// There is no direct state access variant of `glTexImage*()`, so the
+		// texture is always bound to allocate mutable storage. A bound pixel
+		// unpack buffer would turn the null pointers into offsets.
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
+		this->bind(0);
+		glTexParameteri(t, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+
+		for (std::size_t mip = 0; mip != m_levels; ++mip) {
+			auto e = scale_to_mip(t, m_extents, mip, 1);
+			if (t == GL_TEXTURE_CUBE_MAP) {
+				for (GLenum face = 0; face != 6; ++face)
+					glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, m_format, e.x, e.y, 0, pfmt, ptype, nullptr);
+
+				continue;
+			}
+
+			switch (rank) {
+				case 1: glTexImage1D(t, mip, m_format, e.x,           0, pfmt, ptype, nullptr); break;
+				case 2: glTexImage2D(t, mip, m_format, e.x, e.y,      0, pfmt, ptype, nullptr); break;
+				case 3: glTexImage3D(t, mip, m_format, e.x, e.y, e.z, 0, pfmt, ptype, nullptr); break;
+			}
+		}
+
+		this->track_storage(1);
+	}
+
+	void texture::update(std::size_t mip, const buffer::const_view& v, pixel_format format) {
+		assert(this->is_valid());
+		if (v.get_target() != GL_PIXEL_UNPACK_BUFFER)
+			throw exception("gl::texture", "texture update must be sourced from pixel unpack buffer.");
+
+		this->validate_update(mip, v.get_size(), format);
+		if (this->is_empty())
+			return;
+
+		// The data pointer is interpreted as an offset into the bound buffer.
+		// The buffer is unbound afterwards, so that later client pointers are
+		// not read as offsets into it.
+		v.bind();
+		this->upload(mip, reinterpret_cast<const void*>(v.get_offset()), format);
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
+	}
+
+	void texture::update(std::size_t mip, const buffer::const_view& v) {
+		assert(this->is_valid());
+		if (v.get_target() != GL_PIXEL_UNPACK_BUFFER)
+			throw exception("gl::texture", "texture update must be sourced from pixel unpack buffer.");
+
+		this->validate_compressed_update(mip, v.get_size());
+		if (this->is_empty())
+			return;
+
+		v.bind();
+		this->upload_compressed(mip, reinterpret_cast<const void*>(v.get_offset()), v.get_size());
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
+	}
+
+	void texture::invalidate(std::size_t mip) {
+		assert(this->is_valid());
+		if (mip >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+
+		if (this->is_empty())
+			return;
+
+		auto base = this->get_base(mip);
+		auto size = this->get_extents(mip).get(1);
+		// Like clearing, invalidation always takes the texture name directly.
+		glInvalidateTexSubImage(this->get(), mip, base.x, base.y, base.z, size.x, size.y, size.z);
+	}
+
+	void texture::generate_mipmaps() {
+		assert(this->is_valid() && m_base == glm::uvec3(0));
+		auto t = this->get_target();
+		if (texture_traits::is_multisample(t))
+			throw exception("gl::texture", "cannot generate mipmaps for multisample texture.");
+		if (format_traits::is_compressed(m_format))
+			throw exception("gl::texture", "cannot generate mipmaps for compressed texture.");
+
+		if (this->is_empty() || m_levels == 1)
+			return;
+
+		if (has_direct_state_access()) {
+			glGenerateTextureMipmap(this->get());
+		} else {
+			this->bind(0);
+			glGenerateMipmap(t);
+		}
+	}
+
+	void texture::set_level_range(std::size_t base, std::size_t max) {
+		assert(this->is_valid());
+		if (base > max || max >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+
+		if (has_direct_state_access()) {
+			glTextureParameteri(this->get(), GL_TEXTURE_BASE_LEVEL, base);
+			glTextureParameteri(this->get(), GL_TEXTURE_MAX_LEVEL,  max);
+		} else {
+			auto t = this->get_target();
+			this->bind(0);
+			glTexParameteri(t, GL_TEXTURE_BASE_LEVEL, base);
+			glTexParameteri(t, GL_TEXTURE_MAX_LEVEL,  max);
+		}
+	}
+
+	void texture::bind(std::size_t unit, const sampler& s) const {
+		assert(this->is_valid() && s.is_valid());
+		this->bind(unit);
+		s.bind(unit);
+	}
+
+	void texture::commit(std::size_t mip) {
+		assert(this->is_valid());
+		this->set_commitment(mip, true);
+	}
+
+	void texture::decommit(std::size_t mip) {
+		assert(this->is_valid());
+		this->set_commitment(mip, false);
+	}
+
+	texture::const_view texture::make_view(extents offset, extents size) const {
+		assert(this->is_valid());
+		return const_view(*this, offset, size);
+	}
+
+	texture::view texture::make_view(extents offset, extents size) {
+		assert(this->is_valid());
+		return view(*this, offset, size);
+	}
+
+	bool texture::is_immutable() const {
+		assert(this->is_valid());
+		return m_immutable;
+	}
+
+	bool texture::is_compressed() const {
+		assert(this->is_valid());
+		return format_traits::is_compressed(m_format);
+	}
+
+	bool texture::is_sparse() const {
+		assert(this->is_valid());
+		return m_sparse;
+	}
+
+	bool texture::is_empty() const {
+		assert(this->is_valid());
+		return (m_extents == glm::uvec3(0));
+	}
+
+	texture::extents texture::get_extents(std::size_t mip) const {
+		assert(this->is_valid());
+		// The base level is always available, even for an empty texture.
+		if (mip != 0 && mip >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+
+		auto t = this->get_target();
+		return extents(scale_to_mip(t, m_extents, mip, 1), texture_traits::rank(t));
+	}
+
+	std::size_t texture::get_rank() const {
+		assert(this->is_valid());
+		return texture_traits::rank(this->get_target());
+	}
+
+	GLenum texture::get_format() const {
+		assert(this->is_valid());
+		return m_format;
+	}
+
+	std::size_t texture::get_mipmap_count() const {
+		assert(this->is_valid());
+		return m_levels;
+	}
+
+	std::size_t texture::get_sparse_level_count() const {
+		assert(this->is_valid());
+		return m_sparse_levels;
+	}
+
+	glm::uvec3 texture::get_page_size() const {
+		assert(this->is_valid());
+		return m_page;
+	}
+
+	GLuint64 texture::get_handle() const {
+		assert(this->is_valid());
+		if (!context_state::get_current().has_bindless_texture())
+			throw exception("gl::texture", "bindless textures are not supported.");
+
+		return glGetTextureHandleARB(this->get());
+	}
+
+	void texture::make_resident() {
+		assert(this->is_valid());
+		auto handle = this->get_handle();
+		if (context_state::get_current().set_resident(this->get(), handle))
+			glMakeTextureHandleResidentARB(handle);
+	}
+
+	void texture::make_non_resident() {
+		assert(this->is_valid());
+		if (auto handle = context_state::get_current().clear_resident(this->get()))
+			glMakeTextureHandleNonResidentARB(handle);
+	}
+
+	bool texture::is_resident() const {
+		assert(this->is_valid());
+		return context_state::get_current().is_resident(this->get());
+	}
+
+	glm::uvec3 texture::get_base(std::size_t mip) const {
+		return scale_to_mip(this->get_target(), m_base, mip, 0);
+	}
+
+	void texture::validate_update(std::size_t mip, std::size_t size, pixel_format format) const {
+		if (mip >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+
+		auto es = this->get_extents(mip);
+		if (size != size_of(es, format)) {
+			make_error_stream("gl::texture")
+				<< "cannot assign data "
+				<< "(size=" << size << ") "
+				<< "to texture "
+				<< "(extents=" << glm::to_string(es.get(1)) << ", format=" << to_string(m_format) << ")." << std::endl;
+
+			throw exception("gl::texture", "data size mismatch.");
+		}
+
+		auto t = this->get_target();
+		if (texture_traits::is_multisample(t))
+			throw exception("gl::texture", "cannot update multisample texture directly.");
+		// If this is a cubemap, only single-face views should be updated.
+		if (texture_traits::is_cubemap(t) && m_extents.z != 1)
+			throw exception("gl::texture", "cannot update multiple cubemap faces simultaneously.");
+		// Not every compressed format can be encoded by the driver.
+		if (format_traits::is_compressed(m_format))
+			throw exception("gl::texture", "cannot update compressed texture with pixel data.");
+	}
+
+	void texture::upload(std::size_t mip, const void* data, pixel_format format) {
+		auto t     = this->get_target();
+		auto base  = this->get_base(mip);
+		auto size  = this->get_extents(mip).get(1);
+		auto pfmt  = format.get();
+		auto ptype = format.get_datatype();
+
+		// Updates are validated as tightly packed (see `size_of()`), whether
+		// they are sourced from client memory or a pixel unpack buffer.
+		auto alignment = pixel_store_scope(GL_UNPACK_ALIGNMENT, 1);
+
+		auto rank = texture_traits::rank(t);
+		if (has_direct_state_access()) {
+			// With direct state access, the face of a cubemap is addressed as
+			// a layer, so no special handling is needed.
+			auto name = this->get();
+			switch (rank) {
+				case 1: glTextureSubImage1D(name, mip, base.x,                 size.x,                 pfmt, ptype, data); break;
+				case 2: glTextureSubImage2D(name, mip, base.x, base.y,         size.x, size.y,         pfmt, ptype, data); break;
+				case 3: glTextureSubImage3D(name, mip, base.x, base.y, base.z, size.x, size.y, size.z, pfmt, ptype, data); break;
+			}
+
+			return;
+		}
+
 		if (t == GL_TEXTURE_CUBE_MAP) {
-			// Cubemap storage can be allocated using the 2D method. Note that
-			// unlike setting data, storage for all 6 faces is allocated.
+			// Normal cube maps must be treated as separate 2D textures, based
+			// on the current offset of this view. Note that while the 3D
+			// variant can be used in OpenGL 4.5, the old method is used to
+			// support all version, including 3.3 - 4.4.
+			t = GL_TEXTURE_CUBE_MAP_POSITIVE_X + m_base.z;
+			rank = 2;
+		}
+
+		this->bind(0);
+		switch (rank) {
+			case 1: glTexSubImage1D(t, mip, base.x,                 size.x,                 pfmt, ptype, data); break;
+			case 2: glTexSubImage2D(t, mip, base.x, base.y,         size.x, size.y,         pfmt, ptype, data); break;
+			case 3: glTexSubImage3D(t, mip, base.x, base.y, base.z, size.x, size.y, size.z, pfmt, ptype, data); break;
+		}
+	}
+
+	void texture::validate_compressed_update(std::size_t mip, std::size_t size) const {
+		if (mip >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+		if (!format_traits::is_compressed(m_format))
+			throw exception("gl::texture", "cannot update uncompressed texture with compressed data.");
+
+		auto es = this->get_extents(mip);
+		if (size != compressed_size_of(es, m_format)) {
+			make_error_stream("gl::texture")
+				<< "cannot assign compressed data "
+				<< "(size=" << size << ") "
+				<< "to texture "
+				<< "(extents=" << glm::to_string(es.get(1)) << ", format=" << to_string(m_format) << ")." << std::endl;
+
+			throw exception("gl::texture", "data size mismatch.");
+		}
+
+		auto t = this->get_target();
+		if (texture_traits::is_cubemap(t) && m_extents.z != 1)
+			throw exception("gl::texture", "cannot update multiple cubemap faces simultaneously.");
+
+		// Blocks cannot be split, so a view must start on a block boundary,
+		// and end on one unless it reaches the edge of the level.
+		auto [bw, bh] = format_traits::block_extents(m_format);
+		auto block = glm::uvec3(bw, bh, 1);
+		auto base  = this->get_base(mip);
+		auto end   = base + es.get(1);
+		auto edge  = scale_to_mip(t, m_bounds, mip, 1);
+
+		for (std::size_t i = 0; i != 2; ++i) {
+			if (base[i] % block[i] == 0 && (end[i] % block[i] == 0 || end[i] == edge[i]))
+				continue;
+
+			make_error_stream("gl::texture")
+				<< "cannot update texture range "
+				<< "(offset=" << glm::to_string(base) << ", extents=" << glm::to_string(es.get(1)) << ") "
+				<< "with compressed blocks "
+				<< "(size=" << bw << "x" << bh << ")." << std::endl;
+
+			throw exception("gl::texture", "compressed update not block aligned.");
+		}
+	}
+
+	void texture::upload_compressed(std::size_t mip, const void* data, std::size_t size) {
+		auto t     = this->get_target();
+		auto base  = this->get_base(mip);
+		auto es    = this->get_extents(mip).get(1);
+		auto bytes = (GLsizei)size;
+
+		auto rank = texture_traits::rank(t);
+		if (has_direct_state_access()) {
+			auto name = this->get();
+			switch (rank) {
+				case 1: glCompressedTextureSubImage1D(name, mip, base.x,                 es.x,             m_format, bytes, data); break;
+				case 2: glCompressedTextureSubImage2D(name, mip, base.x, base.y,         es.x, es.y,       m_format, bytes, data); break;
+				case 3: glCompressedTextureSubImage3D(name, mip, base.x, base.y, base.z, es.x, es.y, es.z, m_format, bytes, data); break;
+			}
+
+			return;
+		}
+
+		if (t == GL_TEXTURE_CUBE_MAP) {
+			// See `upload()`.
+			t = GL_TEXTURE_CUBE_MAP_POSITIVE_X + m_base.z;
 			rank = 2;
 		}
 
-		auto [x, y, z] = m_extents;
+		this->bind(0);
 		switch (rank) {
-			case 1: glTexStorage1D(t, m_levels, m_format, x      ); break;
-			case 2: glTexStorage2D(t, m_levels, m_format, x, y   ); break;
-			case 3: glTexStorage3D(t, m_levels, m_format, x, y, z); break;
+			case 1: glCompressedTexSubImage1D(t, mip, base.x,                 es.x,             m_format, bytes, data); break;
+			case 2: glCompressedTexSubImage2D(t, mip, base.x, base.y,         es.x, es.y,       m_format, bytes, data); break;
+			case 3: glCompressedTexSubImage3D(t, mip, base.x, base.y, base.z, es.x, es.y, es.z, m_format, bytes, data); break;
 		}
 	}
 
-	texture::texture(GLenum target, GLenum ifmt, extents es, std::size_t n, bool fix)
-	: object<GL_TEXTURE>(target), m_immutable{true}, m_base{}, m_extents{es.get(1)}, m_format{ifmt}, m_levels{1} {
+	void texture::set_compressed(GLenum ifmt, extents es, const void* data, std::size_t size) {
+		if (this->is_immutable())
+			throw exception("gl::texture", "cannot reallocate immutable texture.");
+		if (!format_traits::is_compressed(ifmt))
+			throw exception("gl::texture", "cannot allocate uncompressed texture with compressed data.");
+
+		if (size != compressed_size_of(es, ifmt)) {
+			make_error_stream("gl::texture")
+				<< "cannot allocate compressed data "
+				<< "(size=" << size << ") "
+				<< "for texture "
+				<< "(extents=" << glm::to_string(es.get(1)) << ", format=" << to_string(ifmt) << ")." << std::endl;
+
+			throw exception("gl::texture", "data size mismatch.");
+		}
+
 		auto t = this->get_target();
-		auto [x, y, z] = m_extents;
+		if (texture_traits::is_cubemap(t))
+			throw exception("gl::texture", "cannot reallocate cubemap with texture data.");
 
+		auto rank = texture_traits::rank(t);
+		if (rank != es.get_length()) {
+			make_error_stream("gl::texture")
+				<< "cannot assign "
+				<< es.get_length() << "-dimensional "
+				<< "data to "
+				<< rank << "-dimensional "
+				<< "texture." << std::endl;
+
+			throw exception("gl::texture", "data dimension mismatch.");
+		}
+
+		if (es == extents::zero(rank))
+			return;
+		if (auto zeroes = glm::equal(es.get(1), glm::uvec3(0)); glm::any(zeroes))
+			throw exception("gl::texture", "invalid texture extents.");
+
+		m_extents = es.get(1);
+		m_bounds  = m_extents;
+		m_format  = ifmt;
+		m_levels  = 1;
+
+		auto e     = m_extents;
+		auto bytes = (GLsizei)size;
+
+		name_traits<GL_BUFFER>::bind(0, GL_PIXEL_UNPACK_BUFFER);
 		this->bind(0);
+		glTexParameteri(t, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+
 		switch (rank) {
-			// Note that there are no 1D multisample textures.
-			case 2: glTexStorage2DMultisample(t, n, m_format, x, y,    fix); break;
-			case 3: glTexStorage3DMultisample(t, n, m_format, x, y, z, fix); break;
+			case 1: glCompressedTexImage1D(t, 0, m_format, e.x,           0, bytes, data); break;
+			case 2: glCompressedTexImage2D(t, 0, m_format, e.x, e.y,      0, bytes, data); break;
+			case 3: glCompressedTexImage3D(t, 0, m_format, e.x, e.y, e.z, 0, bytes, data); break;
 		}
+
+		this->track_storage(1);
 	}
 
-	void texture::set(GLenum ifmt, extents es, std::size_t mips) {
-		assert(this->is_valid() && !this->is_immutable());
-		assert(m_base == glm::uvec3(0));
-		assert(mips > 0);
+	void texture::track_storage(std::size_t samples) const {
+		auto t = this->get_target();
+
+		std::size_t bytes = 0;
+		for (std::size_t mip = 0; mip != m_levels; ++mip) {
+			auto e = scale_to_mip(t, m_extents, mip, 1);
+			if (format_traits::is_compressed(m_format))
+				bytes += format_traits::compressed_size(m_format, e.x, e.y, e.z);
+			else
+				bytes += (std::size_t)e.x * e.y * e.z * size_of(pixel_format(m_format));
+		}
+
+		memory_tracker::allocate(GL_TEXTURE, this->get(), bytes * samples);
+	}
+
+	void texture::set_commitment(std::size_t mip, bool commit) {
+		if (!m_sparse)
+			throw exception("gl::texture", "cannot commit memory of non-sparse texture.");
+		if (mip >= m_levels)
+			throw exception("gl::texture", "mipmap level out of bounds.");
+
+		auto t     = this->get_target();
+		auto base  = this->get_base(mip);
+		auto es    = this->get_extents(mip).get(1);
+		auto end   = base + es;
+		auto edge  = scale_to_mip(t, m_bounds, mip, 1);
+		auto page  = m_page;
+
+		// Like compressed blocks, pages can only be committed whole; the mip
+		// tail is the exception, as it is always committed at once.
+		if (mip < this->get_sparse_level_count()) {
+			for (std::size_t i = 0; i != spatial_rank(t); ++i) {
+				if (base[i] % page[i] == 0 && (end[i] % page[i] == 0 || end[i] == edge[i]))
+					continue;
+
+				make_error_stream("gl::texture")
+					<< "cannot commit texture range "
+					<< "(offset=" << glm::to_string(base) << ", extents=" << glm::to_string(es) << ") "
+					<< "with virtual pages "
+					<< "(size=" << glm::to_string(page) << ")." << std::endl;
+
+				throw exception("gl::texture", "commitment not page aligned.");
+			}
+		}
+
+		// There is no core direct state access variant of the commitment.
+		this->bind(0);
+		glTexPageCommitmentARB(t, mip, base.x, base.y, base.z, es.x, es.y, es.z, commit ? GL_TRUE : GL_FALSE);
+	}
+
+	void texture::query_sparse() {
+		if (!m_sparse)
+			return;
+
+		// Neither value changes once the storage is allocated; the format was
+		// already checked to have pages by `immutable()`.
+		m_page = texture_traits::page_size(this->get_target(), m_format);
+
+		GLint levels = 0;
+		if (has_direct_state_access()) {
+			glGetTextureParameteriv(this->get(), GL_NUM_SPARSE_LEVELS_ARB, &levels);
+		} else {
+			this->bind(0);
+			glGetTexParameteriv(this->get_target(), GL_NUM_SPARSE_LEVELS_ARB, &levels);
+		}
+
+		m_sparse_levels = (std::size_t)levels;
+	}
+
+	void texture::download(std::size_t mip, std::size_t size, pixel_format format) const {
+		auto t     = this->get_target();
+		auto base  = this->get_base(mip);
+		auto es    = this->get_extents(mip).get(1);
+		auto pfmt  = format.get();
+		auto ptype = format.get_datatype();
+
+		if (has_direct_state_access()) {
+			// Like updates, the face of a cubemap is addressed as a layer.
+			glGetTextureSubImage(this->get(), mip, base.x, base.y, base.z, es.x, es.y, es.z, pfmt, ptype, (GLsizei)size, nullptr);
+			return;
+		}
+
+		if (t == GL_TEXTURE_CUBE_MAP)
+			t = GL_TEXTURE_CUBE_MAP_POSITIVE_X + m_base.z;
+
+		// Without `glGetTextureSubImage()`, only entire levels can be read.
+		this->bind(0);
+		GLint level[3] = {1, 1, 1};
+		glGetTexLevelParameteriv(t, mip, GL_TEXTURE_WIDTH,  &level[0]);
+		glGetTexLevelParameteriv(t, mip, GL_TEXTURE_HEIGHT, &level[1]);
+		glGetTexLevelParameteriv(t, mip, GL_TEXTURE_DEPTH,  &level[2]);
+
+		auto whole = glm::uvec3(level[0], level[1], level[2]);
+		if (t != this->get_target())
+			whole.z = 1;
+
+		if (base.x != 0 || base.y != 0 || (t == this->get_target() && base.z != 0) || es != whole)
+			throw exception("gl::texture", "partial texture readback requires direct state access.");
+
+		glGetTexImage(t, mip, pfmt, ptype, nullptr);
+	}
+
+	texture::extents texture::extents::zero(std::size_t length) {
+		return extents(glm::uvec3(0), length);
+	}
+
+	texture::extents::extents(glm::uvec1 v)
+	: m_components{v.x, 0, 0}, m_length{1} {}
+
+	texture::extents::extents(glm::uvec2 v)
+	: m_components{v.x, v.y, 0}, m_length{2} {}
+
+	texture::extents::extents(glm::uvec3 v)
+	: m_components{v}, m_length{3} {}
+
+	texture::extents::extents(glm::uvec3 v, std::size_t length)
+	: m_components{0}, m_length{length} {
+		assert(length > 0 && length <= 3);
+		for (std::size_t i = 0; i != length; ++i)
+			m_components[i] = v[i];
+	}
+
+	glm::uvec3 texture::extents::get(glm::uvec3::value_type fill) const {
+		auto result = glm::uvec3(fill);
+		for (std::size_t i = 0; i != m_length; ++i)
+			result[i] = m_components[i];
+
+		return result;
+	}
+
+	std::size_t texture::extents::get_length() const {
+		return m_length;
+	}
+
+	bool texture::extents::operator ==(const extents& other) const {
+		return (m_length == other.m_length && m_components == other.m_components);
+	}
+
+	bool texture::extents::operator !=(const extents& other) const {
+		return !(*this == other);
+	}
+
+	texture::extents::operator glm::uvec1() const {
+		if (m_length != 1)
+			throw exception("gl::texture::extents", "extents length mismatch.");
+
+		return glm::uvec1(m_components.x);
+	}
+
+	texture::extents::operator glm::uvec2() const {
+		if (m_length != 2)
+			throw exception("gl::texture::extents", "extents length mismatch.");
+
+		return glm::uvec2(m_components.x, m_components.y);
+	}
+
+	texture::extents::operator glm::uvec3() const {
+		if (m_length != 3)
+			throw exception("gl::texture::extents", "extents length mismatch.");
+
+		return m_components;
+	}
+
+	texture::const_view texture::const_view::make_view(extents offset, extents size) const {
+		return texture::make_view(offset, size);
+	}
+
+	texture::view::operator const_view() const {
+		// The texture base already represents the range of this view.
+		return const_view(static_cast<const texture&>(*this));
+	}
+
+	std::size_t size_of(texture::extents es, pixel_format format) {
+		auto e = es.get(1);
+		return (std::size_t)e.x * e.y * e.z * size_of(format);
+	}
 
-		//
+	std::size_t compressed_size_of(texture::extents es, GLenum ifmt) {
+		auto e = es.get(1);
+		return format_traits::compressed_size(ifmt, e.x, e.y, e.z);
 	}
 }
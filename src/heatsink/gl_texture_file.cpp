@@ -0,0 +1,508 @@
+#include <heatsink/gl/texture_file.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/traits/format.hpp>
+#include <heatsink/traits/texture.hpp>
+
+namespace {
+	using format_traits  = heatsink::gl::format_traits;
+	using texture_traits = heatsink::gl::texture_traits;
+
+	// The signatures identifying each container.
+	constexpr unsigned char g_ktx2_magic[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+	constexpr unsigned char g_dds_magic[4]   = {'D', 'D', 'S', ' '};
+
+	// The size of the fixed KTX2 header (up to the level index), and of a
+	// single level index entry.
+	constexpr std::size_t g_ktx2_header_size = 80;
+	constexpr std::size_t g_ktx2_level_size  = 24;
+	// The size of the magic and `DDS_HEADER`, and of the `DDS_HEADER_DXT10`.
+	constexpr std::size_t g_dds_header_size = 128;
+	constexpr std::size_t g_dxt10_size      = 20;
+
+	// The internal format of an image, and whether its data is stored with
+	// the red and blue channels swapped (see `pixel_format`).
+	struct file_format {
+	public:
+		GLenum format;
+		bool reverse;
+	};
+
+	// Read a little-endian integer from an unaligned location in a file.
+	template<typename T>
+	T read(const std::byte* data, std::size_t offset) {
+		T result;
+		std::memcpy(&result, data + offset, sizeof(T));
+		return result;
+	}
+
+	constexpr std::uint32_t make_fourcc(char a, char b, char c, char d) {
+		return (std::uint32_t)a | ((std::uint32_t)b << 8) | ((std::uint32_t)c << 16) | ((std::uint32_t)d << 24);
+	}
+
+	// Map a `VkFormat` (used by KTX2) to an OpenGL internal format.
+	file_format from_vk_format(std::uint32_t f) {
+		switch (f) {
+			case 9:   return {GL_R8,                 false};
+			case 16:  return {GL_RG8,                false};
+			case 23:  return {GL_RGB8,               false};
+			case 29:  return {GL_SRGB8,              false};
+			case 37:  return {GL_RGBA8,              false};
+			case 43:  return {GL_SRGB8_ALPHA8,       false};
+			case 44:  return {GL_RGBA8,              true};
+			case 50:  return {GL_SRGB8_ALPHA8,       true};
+			case 76:  return {GL_R16F,               false};
+			case 83:  return {GL_RG16F,              false};
+			case 97:  return {GL_RGBA16F,            false};
+			case 100: return {GL_R32F,               false};
+			case 103: return {GL_RG32F,              false};
+			case 106: return {GL_RGB32F,             false};
+			case 109: return {GL_RGBA32F,            false};
+			case 122: return {GL_R11F_G11F_B10F,     false};
+			case 123: return {GL_RGB9_E5,            false};
+
+			case 131: return {GL_COMPRESSED_RGB_S3TC_DXT1_EXT,         false};
+			case 132: return {GL_COMPRESSED_SRGB_S3TC_DXT1_EXT,        false};
+			case 133: return {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,        false};
+			case 134: return {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,  false};
+			case 135: return {GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,        false};
+			case 136: return {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT,  false};
+			case 137: return {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,        false};
+			case 138: return {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,  false};
+			case 139: return {GL_COMPRESSED_RED_RGTC1,                 false};
+			case 140: return {GL_COMPRESSED_SIGNED_RED_RGTC1,          false};
+			case 141: return {GL_COMPRESSED_RG_RGTC2,                  false};
+			case 142: return {GL_COMPRESSED_SIGNED_RG_RGTC2,           false};
+			case 143: return {GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,   false};
+			case 144: return {GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT,     false};
+			case 145: return {GL_COMPRESSED_RGBA_BPTC_UNORM,           false};
+			case 146: return {GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,     false};
+			case 147: return {GL_COMPRESSED_RGB8_ETC2,                 false};
+			case 148: return {GL_COMPRESSED_SRGB8_ETC2,                false};
+			case 149: return {GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,  false};
+			case 150: return {GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2, false};
+			case 151: return {GL_COMPRESSED_RGBA8_ETC2_EAC,            false};
+			case 152: return {GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,     false};
+			case 153: return {GL_COMPRESSED_R11_EAC,                   false};
+			case 154: return {GL_COMPRESSED_SIGNED_R11_EAC,            false};
+			case 155: return {GL_COMPRESSED_RG11_EAC,                  false};
+			case 156: return {GL_COMPRESSED_SIGNED_RG11_EAC,           false};
+
+			case 157: return {GL_COMPRESSED_RGBA_ASTC_4x4_KHR,           false};
+			case 158: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR,   false};
+			case 159: return {GL_COMPRESSED_RGBA_ASTC_5x4_KHR,           false};
+			case 160: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR,   false};
+			case 161: return {GL_COMPRESSED_RGBA_ASTC_5x5_KHR,           false};
+			case 162: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR,   false};
+			case 163: return {GL_COMPRESSED_RGBA_ASTC_6x5_KHR,           false};
+			case 164: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR,   false};
+			case 165: return {GL_COMPRESSED_RGBA_ASTC_6x6_KHR,           false};
+			case 166: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR,   false};
+			case 167: return {GL_COMPRESSED_RGBA_ASTC_8x5_KHR,           false};
+			case 168: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR,   false};
+			case 169: return {GL_COMPRESSED_RGBA_ASTC_8x6_KHR,           false};
+			case 170: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR,   false};
+			case 171: return {GL_COMPRESSED_RGBA_ASTC_8x8_KHR,           false};
+			case 172: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR,   false};
+			case 173: return {GL_COMPRESSED_RGBA_ASTC_10x5_KHR,          false};
+			case 174: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR,  false};
+			case 175: return {GL_COMPRESSED_RGBA_ASTC_10x6_KHR,          false};
+			case 176: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR,  false};
+			case 177: return {GL_COMPRESSED_RGBA_ASTC_10x8_KHR,          false};
+			case 178: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR,  false};
+			case 179: return {GL_COMPRESSED_RGBA_ASTC_10x10_KHR,         false};
+			case 180: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR, false};
+			case 181: return {GL_COMPRESSED_RGBA_ASTC_12x10_KHR,         false};
+			case 182: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR, false};
+			case 183: return {GL_COMPRESSED_RGBA_ASTC_12x12_KHR,         false};
+			case 184: return {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR, false};
+
+			default: return {GL_NONE, false};
+		}
+	}
+
+	// Map a `DXGI_FORMAT` (used by DDS files with a DX10 header) to an
+	// OpenGL internal format.
+	file_format from_dxgi_format(std::uint32_t f) {
+		switch (f) {
+			case 2:  return {GL_RGBA32F,        false};
+			case 6:  return {GL_RGB32F,         false};
+			case 10: return {GL_RGBA16F,        false};
+			case 26: return {GL_R11F_G11F_B10F, false};
+			case 28: return {GL_RGBA8,          false};
+			case 29: return {GL_SRGB8_ALPHA8,   false};
+			case 34: return {GL_RG16F,          false};
+			case 41: return {GL_R32F,           false};
+			case 49: return {GL_RG8,            false};
+			case 54: return {GL_R16F,           false};
+			case 61: return {GL_R8,             false};
+			case 67: return {GL_RGB9_E5,        false};
+			case 87: return {GL_RGBA8,          true};
+			case 91: return {GL_SRGB8_ALPHA8,   true};
+
+			case 71: return {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,        false};
+			case 72: return {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,  false};
+			case 74: return {GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,        false};
+			case 75: return {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT,  false};
+			case 77: return {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,        false};
+			case 78: return {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,  false};
+			case 80: return {GL_COMPRESSED_RED_RGTC1,                 false};
+			case 81: return {GL_COMPRESSED_SIGNED_RED_RGTC1,          false};
+			case 83: return {GL_COMPRESSED_RG_RGTC2,                  false};
+			case 84: return {GL_COMPRESSED_SIGNED_RG_RGTC2,           false};
+			case 95: return {GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,   false};
+			case 96: return {GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT,     false};
+			case 98: return {GL_COMPRESSED_RGBA_BPTC_UNORM,           false};
+			case 99: return {GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,     false};
+
+			default: return {GL_NONE, false};
+		}
+	}
+
+	// Map the pixel format of a DDS file without a DX10 header.
+	file_format from_dds_pixel_format(const std::byte* data) {
+		// The `DDS_PIXELFORMAT` structure starts at this offset.
+		constexpr std::size_t base = 76;
+
+		auto flags = read<std::uint32_t>(data, base + 4);
+		if (flags & 0x4) {
+			switch (read<std::uint32_t>(data, base + 8)) {
+				case make_fourcc('D', 'X', 'T', '1'): return {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, false};
+				case make_fourcc('D', 'X', 'T', '3'): return {GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, false};
+				case make_fourcc('D', 'X', 'T', '5'): return {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, false};
+				case make_fourcc('A', 'T', 'I', '1'): return {GL_COMPRESSED_RED_RGTC1,          false};
+				case make_fourcc('B', 'C', '4', 'U'): return {GL_COMPRESSED_RED_RGTC1,          false};
+				case make_fourcc('B', 'C', '4', 'S'): return {GL_COMPRESSED_SIGNED_RED_RGTC1,   false};
+				case make_fourcc('A', 'T', 'I', '2'): return {GL_COMPRESSED_RG_RGTC2,           false};
+				case make_fourcc('B', 'C', '5', 'U'): return {GL_COMPRESSED_RG_RGTC2,           false};
+				case make_fourcc('B', 'C', '5', 'S'): return {GL_COMPRESSED_SIGNED_RG_RGTC2,    false};
+
+				default: return {GL_NONE, false};
+			}
+		}
+
+		// Only 32-bit RGBA/BGRA layouts are supported for uncompressed data.
+		auto bits  = read<std::uint32_t>(data, base + 12);
+		auto red   = read<std::uint32_t>(data, base + 16);
+		auto alpha = read<std::uint32_t>(data, base + 28);
+		if (!(flags & 0x40) || bits != 32 || alpha != 0xFF000000)
+			return {GL_NONE, false};
+
+		switch (red) {
+			case 0x000000FF: return {GL_RGBA8, false};
+			case 0x00FF0000: return {GL_RGBA8, true};
+
+			default: return {GL_NONE, false};
+		}
+	}
+
+	// Retrieve which component of an extents holds the layer (or face) index
+	// for the given target, or `3` if the target has no layers.
+	std::size_t layer_component(GLenum target) {
+		if (texture_traits::is_array(target) || texture_traits::is_cubemap(target))
+			return texture_traits::rank(target) - 1;
+		else
+			return 3;
+	}
+}
+
+namespace heatsink::gl {
+	texture_file::texture_file(const std::filesystem::path& path)
+	: m_file{path}, m_target{GL_NONE}, m_format{GL_NONE}, m_reverse{false}, m_extents{1}, m_levels{1} {
+		auto* data = m_file.get_data();
+		auto  size = m_file.get_size();
+
+		if (size >= sizeof(g_ktx2_magic) && std::memcmp(data, g_ktx2_magic, sizeof(g_ktx2_magic)) == 0) {
+			this->parse_ktx2();
+		} else if (size >= sizeof(g_dds_magic) && std::memcmp(data, g_dds_magic, sizeof(g_dds_magic)) == 0) {
+			this->parse_dds();
+		} else {
+			make_error_stream("gl::texture_file")
+				<< "unknown container for path "
+				<< "\"" << path.string() << "\"." << std::endl;
+
+			throw exception("gl::texture_file", "unrecognized texture file.");
+		}
+	}
+
+	texture texture_file::create() const {
+		auto result = texture::immutable(m_target, m_format, this->get_extents(), m_levels);
+		this->upload(result);
+
+		return result;
+	}
+
+	void texture_file::upload(texture::view v) const {
+		if (v.get_format() != m_format || v.get_extents() != this->get_extents())
+			throw exception("gl::texture_file", "texture does not match file.");
+
+		for (const auto& img : m_images)
+			this->upload(v, img);
+	}
+
+	void texture_file::upload(texture::view v, const image& img) const {
+		auto rank  = texture_traits::rank(m_target);
+		auto layer = layer_component(m_target);
+
+		// The rows of each image are tightly packed in the file, so they
+		// must not be read with the default (4-byte) row alignment. This is
+		// set per image, as single images are also streamed by `mip_streamer`.
+		auto alignment = pixel_store_scope(GL_UNPACK_ALIGNMENT, 1);
+
+		auto* begin = reinterpret_cast<const GLubyte*>(img.data);
+		auto* end   = begin + img.size;
+
+		// Images of layered textures are uploaded through a view of only
+		// their layers; the offset is scaled by the view itself per mip.
+		auto offset = glm::uvec3(0);
+		auto extent = m_extents;
+		if (layer != 3) {
+			offset[layer] = img.layer;
+			extent[layer] = img.layers;
+		}
+
+		auto target = v.make_view(texture::extents(offset, rank), texture::extents(extent, rank));
+		if (format_traits::is_compressed(m_format))
+			target.update(img.mip, begin, end);
+		else
+			target.update(img.mip, begin, end, pixel_format(m_format, m_reverse));
+	}
+
+	GLenum texture_file::get_target() const {
+		return m_target;
+	}
+
+	GLenum texture_file::get_format() const {
+		return m_format;
+	}
+
+	texture::extents texture_file::get_extents() const {
+		return texture::extents(m_extents, texture_traits::rank(m_target));
+	}
+
+	std::size_t texture_file::get_mipmap_count() const {
+		return m_levels;
+	}
+
+	const std::vector<texture_file::image>& texture_file::get_images() const {
+		return m_images;
+	}
+
+	void texture_file::parse_ktx2() {
+		auto* data = m_file.get_data();
+		if (m_file.get_size() < g_ktx2_header_size)
+			throw exception("gl::texture_file", "truncated texture file.");
+
+		auto vk_format = read<std::uint32_t>(data, 12);
+		auto width     = read<std::uint32_t>(data, 20);
+		auto height    = read<std::uint32_t>(data, 24);
+		auto depth     = read<std::uint32_t>(data, 28);
+		auto layers    = read<std::uint32_t>(data, 32);
+		auto faces     = read<std::uint32_t>(data, 36);
+		auto levels    = read<std::uint32_t>(data, 40);
+		auto scheme    = read<std::uint32_t>(data, 44);
+
+		if (scheme != 0)
+			throw exception("gl::texture_file", "supercompressed texture files are not supported.");
+		if (width == 0 || (faces != 1 && faces != 6) || (depth != 0 && layers != 0))
+			throw exception("gl::texture_file", "invalid texture file dimensions.");
+
+		auto [format, reverse] = from_vk_format(vk_format);
+		if (format == GL_NONE) {
+			make_error_stream("gl::texture_file")
+				<< "unsupported VkFormat "
+				<< "(value=" << vk_format << ")." << std::endl;
+
+			throw exception("gl::texture_file", "unsupported texture file format.");
+		}
+
+		m_format  = format;
+		m_reverse = reverse;
+		// A level count of zero asks for mipmaps to be generated at load time;
+		// only the base level is stored in that case.
+		m_levels  = std::max<std::uint32_t>(levels, 1);
+
+		auto count = std::max<std::uint32_t>(layers, 1);
+		if (faces == 6) {
+			m_target  = (layers != 0) ? GL_TEXTURE_CUBE_MAP_ARRAY : GL_TEXTURE_CUBE_MAP;
+			m_extents = glm::uvec3(width, height, 6 * count);
+		} else if (depth != 0) {
+			m_target  = GL_TEXTURE_3D;
+			m_extents = glm::uvec3(width, height, depth);
+		} else if (height != 0) {
+			m_target  = (layers != 0) ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+			m_extents = glm::uvec3(width, height, count);
+		} else {
+			m_target  = (layers != 0) ? GL_TEXTURE_1D_ARRAY : GL_TEXTURE_1D;
+			m_extents = glm::uvec3(width, count, 1);
+		}
+
+		if (m_file.get_size() < g_ktx2_header_size + m_levels * g_ktx2_level_size)
+			throw exception("gl::texture_file", "truncated texture file.");
+
+		// Each level holds every layer and face of that mip contiguously.
+		// Cubemap faces can only be updated one at a time, so they are split.
+		auto images = count * faces;
+		for (std::size_t mip = 0; mip != m_levels; ++mip) {
+			auto entry  = g_ktx2_header_size + mip * g_ktx2_level_size;
+			auto offset = (std::size_t)read<std::uint64_t>(data, entry);
+			auto length = (std::size_t)read<std::uint64_t>(data, entry + 8);
+
+			if (faces == 6) {
+				auto face = length / images;
+				for (std::size_t i = 0; i != images; ++i)
+					this->add_image(mip, i, 1, offset + i * face, face);
+			} else {
+				this->add_image(mip, 0, (layers != 0) ? count : 1, offset, length);
+			}
+		}
+	}
+
+	void texture_file::parse_dds() {
+		auto* data = m_file.get_data();
+		if (m_file.get_size() < g_dds_header_size)
+			throw exception("gl::texture_file", "truncated texture file.");
+
+		auto flags  = read<std::uint32_t>(data, 8);
+		auto height = read<std::uint32_t>(data, 12);
+		auto width  = read<std::uint32_t>(data, 16);
+		auto depth  = read<std::uint32_t>(data, 24);
+		auto levels = read<std::uint32_t>(data, 28);
+		auto fourcc = read<std::uint32_t>(data, 84);
+		auto caps2  = read<std::uint32_t>(data, 112);
+
+		// `DDSD_MIPMAPCOUNT`; otherwise, only the base level is present.
+		m_levels = (flags & 0x20000) ? std::max<std::uint32_t>(levels, 1) : 1;
+
+		auto offset = g_dds_header_size;
+		auto count  = std::size_t{1};
+		if (fourcc == make_fourcc('D', 'X', '1', '0')) {
+			if (m_file.get_size() < g_dds_header_size + g_dxt10_size)
+				throw exception("gl::texture_file", "truncated texture file.");
+
+			auto dxgi      = read<std::uint32_t>(data, 128);
+			auto dimension = read<std::uint32_t>(data, 132);
+			auto misc      = read<std::uint32_t>(data, 136);
+			auto array     = std::max<std::uint32_t>(read<std::uint32_t>(data, 140), 1);
+
+			auto [format, reverse] = from_dxgi_format(dxgi);
+			if (format == GL_NONE) {
+				make_error_stream("gl::texture_file")
+					<< "unsupported DXGI_FORMAT "
+					<< "(value=" << dxgi << ")." << std::endl;
+
+				throw exception("gl::texture_file", "unsupported texture file format.");
+			}
+
+			m_format  = format;
+			m_reverse = reverse;
+			offset   += g_dxt10_size;
+
+			// `D3D10_RESOURCE_DIMENSION_TEXTURE1D`, `2D`, and `3D` respectively.
+			switch (dimension) {
+				case 2:
+					m_target  = (array > 1) ? GL_TEXTURE_1D_ARRAY : GL_TEXTURE_1D;
+					m_extents = glm::uvec3(width, array, 1);
+					count     = array;
+					break;
+				case 3:
+					// `D3D10_RESOURCE_MISC_TEXTURECUBE`; the array counts cubes.
+					if (misc & 0x4) {
+						m_target  = (array > 1) ? GL_TEXTURE_CUBE_MAP_ARRAY : GL_TEXTURE_CUBE_MAP;
+						m_extents = glm::uvec3(width, height, 6 * array);
+						count     = 6 * array;
+					} else {
+						m_target  = (array > 1) ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+						m_extents = glm::uvec3(width, height, array);
+						count     = array;
+					}
+					break;
+				case 4:
+					m_target  = GL_TEXTURE_3D;
+					m_extents = glm::uvec3(width, height, std::max<std::uint32_t>(depth, 1));
+					break;
+
+				default:
+					throw exception("gl::texture_file", "invalid texture file dimensions.");
+			}
+		} else {
+			auto [format, reverse] = from_dds_pixel_format(data);
+			if (format == GL_NONE)
+				throw exception("gl::texture_file", "unsupported texture file format.");
+
+			m_format  = format;
+			m_reverse = reverse;
+
+			// `DDSCAPS2_CUBEMAP` (with every face present) and `DDSCAPS2_VOLUME`.
+			if (caps2 & 0x200) {
+				if ((caps2 & 0xFC00) != 0xFC00)
+					throw exception("gl::texture_file", "partial cubemap texture files are not supported.");
+
+				m_target  = GL_TEXTURE_CUBE_MAP;
+				m_extents = glm::uvec3(width, height, 6);
+				count     = 6;
+			} else if ((caps2 & 0x200000) && depth > 1) {
+				m_target  = GL_TEXTURE_3D;
+				m_extents = glm::uvec3(width, height, depth);
+			} else {
+				m_target  = GL_TEXTURE_2D;
+				m_extents = glm::uvec3(width, std::max<std::uint32_t>(height, 1), 1);
+			}
+		}
+
+		if (width == 0)
+			throw exception("gl::texture_file", "invalid texture file dimensions.");
+
+		// Unlike KTX2, every layer (or face) holds its own full mip chain.
+		auto layered = (layer_component(m_target) != 3);
+		for (std::size_t layer = 0; layer != count; ++layer) {
+			for (std::size_t mip = 0; mip != m_levels; ++mip) {
+				auto size = this->size_of_image(mip, 1);
+				this->add_image(mip, layered ? layer : 0, 1, offset, size);
+				offset += size;
+			}
+		}
+	}
+
+	void texture_file::add_image(std::size_t mip, std::size_t layer, std::size_t layers, std::size_t offset, std::size_t size) {
+		if (offset > m_file.get_size() || size > m_file.get_size() - offset)
+			throw exception("gl::texture_file", "truncated texture file.");
+
+		if (auto expected = this->size_of_image(mip, layers); size != expected) {
+			make_error_stream("gl::texture_file")
+				<< "image data "
+				<< "(mip=" << mip << ", layer=" << layer << ", size=" << size << ") "
+				<< "does not match expected size "
+				<< "(size=" << expected << ")." << std::endl;
+
+			throw exception("gl::texture_file", "image data size mismatch.");
+		}
+
+		m_images.push_back(image{mip, layer, layers, m_file.get_data() + offset, size});
+	}
+
+	std::size_t texture_file::size_of_image(std::size_t mip, std::size_t layers) const {
+		auto rank  = texture_traits::rank(m_target);
+		auto layer = layer_component(m_target);
+
+		// Only the spatial dimensions are reduced between levels.
+		auto e = m_extents;
+		for (std::size_t i = 0; i != std::min<std::size_t>(rank, layer); ++i)
+			e[i] = std::max(e[i] >> mip, 1u);
+		if (layer != 3)
+			e[layer] = layers;
+
+		auto es = texture::extents(e, rank);
+		if (format_traits::is_compressed(m_format))
+			return compressed_size_of(es, m_format);
+		else
+			return size_of(es, pixel_format(m_format, m_reverse));
+	}
+}
@@ -0,0 +1,20 @@
+#include <heatsink/gl/texture_uploader.hpp>
+
+namespace heatsink::gl {
+	texture_uploader::texture_uploader(std::size_t size, std::size_t frames)
+	: m_ring(GL_PIXEL_UNPACK_BUFFER, size, frames) {}
+
+	buffer::view texture_uploader::allocate(std::size_t size) {
+		// Rows are uploaded tightly packed (see `texture::update()`), so only
+		// the pixel component types need aligning; 8 bytes covers all of them.
+		return m_ring.allocate(size, 8);
+	}
+
+	void texture_uploader::advance() {
+		m_ring.advance();
+	}
+
+	const ring_buffer& texture_uploader::get_ring_buffer() const {
+		return m_ring;
+	}
+}
@@ -32,6 +32,8 @@ namespace heatsink::gl {
 		GLint count;
 		glGetProgramiv(owner, GL_ACTIVE_UNIFORMS, &count);
 		std::vector<GLuint> indices(count);
+		// The indices are guaranteed to be in the range [0, ACTIVE_UNIFORMS).
+		std::iota(indices.begin(), indices.end(), 0);
 
 		// Collect all info using the `glGetActiveUniformsiv` to prevent from
 		// calling OpenGL 3 or 4 times for each uniform.
@@ -40,8 +42,6 @@ namespace heatsink::gl {
 		auto blocks  = get_parameters(owner, indices, GL_UNIFORM_BLOCK_INDEX);
 		auto lengths = get_parameters(owner, indices, GL_UNIFORM_NAME_LENGTH);
 
-		// The indices are guaranteed to be in the range [0, ACTIVE_UNIFORMS).
-		std::iota(indices.begin(), indices.end(), 0);
 		for (const auto i : indices) {
 			// If the uniform is part of a block it must be handled differently.
 			if (blocks[i] != -1)
@@ -0,0 +1,196 @@
+#include <heatsink/gl/uniform_block.hpp>
+
+#include <algorithm>
+
+#include <heatsink/gl/program.hpp>
+
+namespace {
+	GLint get_parameter(GLuint p, GLuint index, GLenum e) {
+		GLint result;
+		glGetActiveUniformBlockiv(p, index, e, &result);
+
+		return result;
+	}
+
+	std::vector<GLint> get_parameters(GLuint p, const std::vector<GLuint>& indices, GLenum e) {
+		std::vector<GLint> results(indices.size());
+		glGetActiveUniformsiv(p, (GLsizei)indices.size(), indices.data(), e, results.data());
+
+		return results;
+	}
+
+	GLuint get_block_index(GLuint p, const std::string& name) {
+		auto index = glGetUniformBlockIndex(p, name.c_str());
+		if (index == GL_INVALID_INDEX) {
+			heatsink::make_error_stream("gl::uniform_block")
+				<< "unknown uniform block name "
+				<< "\"" << name << "\"." << std::endl;
+
+			throw heatsink::exception("gl::uniform_block", "could not find uniform block index.");
+		}
+
+		return index;
+	}
+
+	std::size_t get_offset_alignment() {
+		GLint result;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &result);
+
+		return (std::size_t)result;
+	}
+}
+
+namespace heatsink::gl {
+	std::map<std::string, uniform_block> uniform_block::from_program(const program& p) {
+		auto owner = p.get();
+		std::map<std::string, uniform_block> results;
+
+		GLint count;
+		glGetProgramiv(owner, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+		// The indices are guaranteed to be in the range [0, ACTIVE_UNIFORM_BLOCKS).
+		for (GLuint i = 0; i != (GLuint)count; ++i) {
+			auto b = uniform_block(owner, i);
+			results.emplace(b.get_name(), b);
+		}
+
+		return results;
+	}
+
+	uniform_block::uniform_block(const program& p, std::string name)
+	: uniform_block(p.get(), get_block_index(p.get(), name)) {}
+
+	uniform_block::uniform_block(GLuint owner, GLuint index)
+	: m_program{owner}, m_index{index} {
+		m_size    = get_parameter(m_program, m_index, GL_UNIFORM_BLOCK_DATA_SIZE);
+		m_binding = get_parameter(m_program, m_index, GL_UNIFORM_BLOCK_BINDING);
+
+		auto namelen = get_parameter(m_program, m_index, GL_UNIFORM_BLOCK_NAME_LENGTH);
+		// `std::string::resize` does not include the null terminator.
+		m_name.resize(namelen - 1);
+		glGetActiveUniformBlockName(m_program, m_index, namelen, nullptr, m_name.data());
+
+		auto count = get_parameter(m_program, m_index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS);
+		if (count == 0)
+			return;
+
+		// The member indices are returned as `GLint`s, but are used as
+		// `GLuint`s by the uniform queries.
+		std::vector<GLint> members(count);
+		glGetActiveUniformBlockiv(m_program, m_index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, members.data());
+		std::vector<GLuint> indices(members.begin(), members.end());
+
+		auto types    = get_parameters(m_program, indices, GL_UNIFORM_TYPE);
+		auto sizes    = get_parameters(m_program, indices, GL_UNIFORM_SIZE);
+		auto offsets  = get_parameters(m_program, indices, GL_UNIFORM_OFFSET);
+		auto arrays   = get_parameters(m_program, indices, GL_UNIFORM_ARRAY_STRIDE);
+		auto matrices = get_parameters(m_program, indices, GL_UNIFORM_MATRIX_STRIDE);
+		auto lengths  = get_parameters(m_program, indices, GL_UNIFORM_NAME_LENGTH);
+
+		for (std::size_t i = 0; i != indices.size(); ++i) {
+			member m;
+			m.name.resize(lengths[i] - 1);
+			glGetActiveUniformName(m_program, indices[i], lengths[i], nullptr, m.name.data());
+			// Like `uniform`, remove the implicit subscript of array members.
+			if (m.name.ends_with("[0]"))
+				m.name.resize(m.name.size() - 3);
+
+			m.datatype      = (GLenum)types[i];
+			m.offset        = (std::size_t)offsets[i];
+			m.size          = (std::size_t)sizes[i];
+			m.array_stride  = (std::size_t)arrays[i];
+			m.matrix_stride = (std::size_t)matrices[i];
+
+			m_members.push_back(std::move(m));
+		}
+
+		// Introspection order is implementation defined; sort the members so
+		// that they match their declaration order (for the shared layouts).
+		std::sort(m_members.begin(), m_members.end(), [](const auto& a, const auto& b) {
+			return a.offset < b.offset;
+		});
+	}
+
+	void uniform_block::set_binding(std::size_t index) {
+		assert(this->is_valid());
+		glUniformBlockBinding(m_program, m_index, (GLuint)index);
+
+		m_binding = index;
+	}
+
+	void uniform_block::bind(const buffer::const_view& v) const {
+		assert(this->is_valid());
+		if (v.get_target() != GL_UNIFORM_BUFFER)
+			throw exception("gl::uniform_block", "uniform block must be sourced from uniform buffer.");
+
+		if (v.get_size() < m_size) {
+			make_error_stream("gl::uniform_block")
+				<< "cannot bind buffer view "
+				<< "(size=" << v.get_size() << ") "
+				<< "to uniform block "
+				<< "\"" << m_name << "\" "
+				<< "(size=" << m_size << ")." << std::endl;
+
+			throw exception("gl::uniform_block", "buffer view too small for block.");
+		}
+
+		if (auto align = get_offset_alignment(); v.get_offset() % align != 0) {
+			make_error_stream("gl::uniform_block")
+				<< "buffer view offset " << v.get_offset() << " "
+				<< "is not a multiple of "
+				<< "GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT "
+				<< "(" << align << ")." << std::endl;
+
+			throw exception("gl::uniform_block", "misaligned buffer view.");
+		}
+
+		v.bind_range(m_binding);
+	}
+
+	bool uniform_block::is_valid() const {
+		return (m_index != GL_INVALID_INDEX);
+	}
+
+	GLuint uniform_block::get() const {
+		assert(this->is_valid());
+		return m_index;
+	}
+
+	const std::string& uniform_block::get_name() const {
+		assert(this->is_valid());
+		return m_name;
+	}
+
+	std::size_t uniform_block::get_size() const {
+		assert(this->is_valid());
+		return m_size;
+	}
+
+	std::size_t uniform_block::get_binding() const {
+		assert(this->is_valid());
+		return m_binding;
+	}
+
+	const uniform_block::member& uniform_block::get_member(const std::string& name) const {
+		assert(this->is_valid());
+		auto it = std::find_if(m_members.begin(), m_members.end(), [&](const auto& m) {
+			return m.name == name;
+		});
+
+		if (it == m_members.end()) {
+			make_error_stream("gl::uniform_block")
+				<< "could not find member "
+				<< "\"" << name << "\" "
+				<< "in uniform block "
+				<< "\"" << m_name << "\"." << std::endl;
+
+			throw exception("gl::uniform_block", "block member does not exist.");
+		}
+
+		return *it;
+	}
+
+	const std::vector<uniform_block::member>& uniform_block::get_members() const {
+		assert(this->is_valid());
+		return m_members;
+	}
+}
@@ -0,0 +1,174 @@
+#include <heatsink/gl/uniform_state.hpp>
+
+#include <cstring>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/uniform.hpp>
+#include <heatsink/traits/shader.hpp>
+
+namespace heatsink::gl {
+	uniform_state::uniform_state(const program& p)
+	: m_program{p.get()} {
+		for (const auto& [name, u] : uniform::from_program(p)) {
+			m_names.emplace(name, m_slots.size());
+			m_slots.push_back(slot{
+				.location = (GLint)u.get(),
+				.datatype = u.get_datatype(),
+				.size     = u.get_size(),
+				.assigned = GL_NONE,
+				.offset   = 0,
+				.bytes    = 0,
+				.dirty    = false
+			});
+		}
+	}
+
+	uniform_state::handle uniform_state::find(const std::string& name) const {
+		auto it = m_names.find(name);
+		if (it == m_names.end()) {
+			make_error_stream("gl::uniform_state")
+				<< "could not find uniform "
+				<< "\"" << name << "\"." << std::endl;
+
+			throw exception("gl::uniform_state", "uniform does not exist.");
+		}
+
+		return handle{it->second};
+	}
+
+	void uniform_state::flush() {
+		if (m_dirty.empty())
+			return;
+
+		// Without separate shader objects, uniforms can only be set on the
+		// program in use; see `upload()`.
+		auto separate = context_state::get_current().has_separate_shader_objects();
+		if (!separate)
+			glUseProgram(m_program);
+
+		for (auto i : m_dirty) {
+			this->upload(m_slots[i], separate);
+			m_slots[i].dirty = false;
+		}
+
+		m_dirty.clear();
+	}
+
+	bool uniform_state::is_dirty() const {
+		return !m_dirty.empty();
+	}
+
+	GLuint uniform_state::get_program() const {
+		return m_program;
+	}
+
+	void uniform_state::set_values(handle h, GLenum datatype, std::size_t count, const void* data, std::size_t bytes) {
+		assert(h.index < m_slots.size());
+		auto& s = m_slots[h.index];
+
+		if (!shader_traits::is_assignable(s.datatype, datatype)) {
+			make_error_stream("gl::uniform_state")
+				<< "cannot assign datatype "
+				<< to_string(datatype) << " "
+				<< "to uniform type "
+				<< to_string(s.datatype) << "." << std::endl;
+
+			throw exception("gl::uniform_state", "type mismatch.");
+		}
+		if (count != s.size) {
+			make_error_stream("gl::uniform_state")
+				<< "cannot assign array "
+				<< "(size=" << count << ") "
+				<< "to uniform "
+				<< "(size=" << s.size << ")." << std::endl;
+
+			throw exception("gl::uniform_state", "array size mismatch.");
+		}
+
+		// Storage is only (re)allocated the first time a uniform is set, or if
+		// it is set from a different type; afterwards, sets never allocate.
+		// Offsets are kept aligned so values can be passed to OpenGL directly.
+		if (s.assigned != datatype || s.bytes != bytes) {
+			s.assigned = datatype;
+			s.offset   = (m_values.size() + alignof(GLfloat) - 1) / alignof(GLfloat) * alignof(GLfloat);
+			s.bytes    = bytes;
+			m_values.resize(s.offset + bytes);
+		} else if (std::memcmp(m_values.data() + s.offset, data, bytes) == 0) {
+			return;
+		}
+
+		std::memcpy(m_values.data() + s.offset, data, bytes);
+		if (!s.dirty) {
+			s.dirty = true;
+			m_dirty.push_back(h.index);
+		}
+	}
+
+	void uniform_state::upload(const slot& s, bool separate) {
+		auto count = (GLsizei)s.size;
+		auto loc   = s.location;
+		auto data  = m_values.data() + s.offset;
+
+		auto is = reinterpret_cast<const GLint*>(data);
+		auto us = reinterpret_cast<const GLuint*>(data);
+		auto fs = reinterpret_cast<const GLfloat*>(data);
+
+		// Like `uniform::update()`, booleans must be uploaded as integers.
+		switch (s.assigned) {
+			case GL_BOOL:
+			case GL_BOOL_VEC2:
+			case GL_BOOL_VEC3:
+			case GL_BOOL_VEC4: {
+				auto bs = reinterpret_cast<const bool*>(data);
+				m_scratch.assign(bs, bs + s.bytes / sizeof(bool));
+				is = m_scratch.data();
+				break;
+			}
+		}
+
+		// Call the `glProgramUniform*()` variant if available, or else the
+		// `glUniform*()` variant on the program in use.
+		auto call = [&](auto program_fn, auto fn, auto... args) {
+			if (separate)
+				program_fn(m_program, loc, count, args...);
+			else
+				fn(loc, count, args...);
+		};
+
+		switch (s.assigned) {
+			case GL_BOOL:      [[fallthrough]];
+			case GL_INT:       call(glProgramUniform1iv, glUniform1iv, is); break;
+			case GL_BOOL_VEC2: [[fallthrough]];
+			case GL_INT_VEC2:  call(glProgramUniform2iv, glUniform2iv, is); break;
+			case GL_BOOL_VEC3: [[fallthrough]];
+			case GL_INT_VEC3:  call(glProgramUniform3iv, glUniform3iv, is); break;
+			case GL_BOOL_VEC4: [[fallthrough]];
+			case GL_INT_VEC4:  call(glProgramUniform4iv, glUniform4iv, is); break;
+
+			case GL_UNSIGNED_INT:      call(glProgramUniform1uiv, glUniform1uiv, us); break;
+			case GL_UNSIGNED_INT_VEC2: call(glProgramUniform2uiv, glUniform2uiv, us); break;
+			case GL_UNSIGNED_INT_VEC3: call(glProgramUniform3uiv, glUniform3uiv, us); break;
+			case GL_UNSIGNED_INT_VEC4: call(glProgramUniform4uiv, glUniform4uiv, us); break;
+
+			case GL_FLOAT:      call(glProgramUniform1fv, glUniform1fv, fs); break;
+			case GL_FLOAT_VEC2: call(glProgramUniform2fv, glUniform2fv, fs); break;
+			case GL_FLOAT_VEC3: call(glProgramUniform3fv, glUniform3fv, fs); break;
+			case GL_FLOAT_VEC4: call(glProgramUniform4fv, glUniform4fv, fs); break;
+
+			case GL_FLOAT_MAT2:   call(glProgramUniformMatrix2fv, glUniformMatrix2fv, GL_FALSE, fs); break;
+			case GL_FLOAT_MAT2x3: call(glProgramUniformMatrix2x3fv, glUniformMatrix2x3fv, GL_FALSE, fs); break;
+			case GL_FLOAT_MAT2x4: call(glProgramUniformMatrix2x4fv, glUniformMatrix2x4fv, GL_FALSE, fs); break;
+
+			case GL_FLOAT_MAT3x2: call(glProgramUniformMatrix3x2fv, glUniformMatrix3x2fv, GL_FALSE, fs); break;
+			case GL_FLOAT_MAT3:   call(glProgramUniformMatrix3fv, glUniformMatrix3fv, GL_FALSE, fs); break;
+			case GL_FLOAT_MAT3x4: call(glProgramUniformMatrix3x4fv, glUniformMatrix3x4fv, GL_FALSE, fs); break;
+
+			case GL_FLOAT_MAT4x2: call(glProgramUniformMatrix4x2fv, glUniformMatrix4x2fv, GL_FALSE, fs); break;
+			case GL_FLOAT_MAT4x3: call(glProgramUniformMatrix4x3fv, glUniformMatrix4x3fv, GL_FALSE, fs); break;
+			case GL_FLOAT_MAT4:   call(glProgramUniformMatrix4fv, glUniformMatrix4fv, GL_FALSE, fs); break;
+		}
+	}
+}
@@ -5,14 +5,92 @@
 
 #include <heatsink/error/debug.hpp>
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
 #include <heatsink/traits/memory.hpp>
 #include <heatsink/traits/name.hpp>
 
 namespace {
+	using conversion = heatsink::gl::vertex_array::conversion;
+
 	void validate_array_buffer(GLenum target) {
 		if (target != GL_ARRAY_BUFFER)
 			throw heatsink::exception("gl::vertex_array", "attribute buffer must be GL_ARRAY_BUFFER.");
 	}
+
+	// The separated format/binding commands were added in OpenGL 4.3.
+	void validate_vertex_binding() {
+		auto version = heatsink::gl::context_state::get_current().get_version();
+		if (version < heatsink::context::version{4,3})
+			throw heatsink::exception("gl::vertex_array", "vertex buffer bindings require OpenGL 4.3.");
+	}
+
+	void validate_annotations(const heatsink::gl::attribute& a, heatsink::gl::vertex_format::extents es) {
+		if (a.is_annotated() && a.get_size() != es[1]) {
+			heatsink::make_error_stream("gl::vertex_array")
+				<< "attribute annotations "
+				<< "(size=" << a.get_size() << ") "
+				<< "do not match format extents "
+				<< "(size=" << es[1] << ")." << std::endl;
+
+			throw heatsink::exception("gl::vertex_array", "attribute array size mismatch.");
+		}
+	}
+
+	// Determine the number of components stored at the given index of a
+	// format; this only differs from the format extents for double types.
+	GLint index_components(GLenum type, GLuint components, std::size_t i) {
+		if (type == GL_DOUBLE) {
+			// In a `dvec3`, the components must be uploaded in two pieces;
+			// two in the first index, and one in the second.
+			if (components == 3)
+				return (i % 2) ? 1 : 2;
+			// In a `dvec4`, the components can be uploaded evenly; 2 each.
+			else if (components == 4)
+				return 2;
+		}
+
+		return (GLint)components;
+	}
+
+	// Determine the number of bytes of a single attribute index; a packed
+	// type holds every component in a single value.
+	std::size_t index_size(GLenum type, GLint components) {
+		return heatsink::gl::is_packed(type) ? heatsink::gl::size_of(type) : heatsink::gl::size_of(type) * components;
+	}
+
+	// Set the separated format of a single attribute index, either by name or
+	// on the currently bound vertex array.
+	void set_index_format(GLuint vao, GLuint index, GLint cs, GLenum type, GLuint offset, conversion* conv) {
+		if (vao) {
+			if (!conv) {
+				glVertexArrayAttribFormat(vao, index, cs, type, GL_TRUE, offset);
+			} else switch (*conv) {
+				case conversion::integer:
+					glVertexArrayAttribIFormat(vao, index, cs, type, offset);
+					break;
+				case conversion::floating_point:
+					glVertexArrayAttribFormat(vao, index, cs, type, GL_FALSE, offset);
+					break;
+				case conversion::double_precision:
+					glVertexArrayAttribLFormat(vao, index, cs, type, offset);
+					break;
+			}
+		} else {
+			if (!conv) {
+				glVertexAttribFormat(index, cs, type, GL_TRUE, offset);
+			} else switch (*conv) {
+				case conversion::integer:
+					glVertexAttribIFormat(index, cs, type, offset);
+					break;
+				case conversion::floating_point:
+					glVertexAttribFormat(index, cs, type, GL_FALSE, offset);
+					break;
+				case conversion::double_precision:
+					glVertexAttribLFormat(index, cs, type, offset);
+					break;
+			}
+		}
+	}
 }
 
 namespace heatsink::gl {
@@ -36,8 +114,96 @@ namespace heatsink::gl {
 	void vertex_array::set_attribute(const attribute& a, std::nullptr_t) {
 		assert(this->is_valid());
 
-		this->bind();
-		glDisableVertexAttribArray(a.get());
+		if (has_direct_state_access()) {
+			glDisableVertexArrayAttrib(this->get(), a.get());
+		} else {
+			this->bind();
+			glDisableVertexAttribArray(a.get());
+		}
+	}
+
+	void vertex_array::set_attribute_format(const attribute& a, vertex_format f, std::size_t binding) {
+		assert(this->is_valid());
+		this->set_attribute_format(a, f, binding, nullptr);
+	}
+
+	void vertex_array::set_attribute_format(const attribute& a, vertex_format f, std::size_t binding, conversion conv) {
+		assert(this->is_valid());
+		this->set_attribute_format(a, f, binding, &conv);
+	}
+
+	void vertex_array::set_binding(std::size_t index, buffer::const_view v, std::size_t stride) {
+		assert(this->is_valid());
+		validate_vertex_binding();
+		validate_array_buffer(v.get_target());
+
+		if (has_direct_state_access()) {
+			glVertexArrayVertexBuffer(this->get(), (GLuint)index, v.get(), (GLintptr)v.get_offset(), (GLsizei)stride);
+		} else {
+			this->bind();
+			glBindVertexBuffer((GLuint)index, v.get(), (GLintptr)v.get_offset(), (GLsizei)stride);
+		}
+	}
+
+	void vertex_array::set_binding(std::size_t index, std::nullptr_t) {
+		assert(this->is_valid());
+		validate_vertex_binding();
+
+		if (has_direct_state_access()) {
+			glVertexArrayVertexBuffer(this->get(), (GLuint)index, 0, 0, 0);
+		} else {
+			this->bind();
+			glBindVertexBuffer((GLuint)index, 0, 0, 0);
+		}
+	}
+
+	void vertex_array::set_bindings(std::size_t first, const std::vector<binding>& bs) {
+		assert(this->is_valid());
+		validate_vertex_binding();
+
+		// The multi-bind variants are only available from OpenGL 4.4.
+		auto version = context_state::get_current().get_version();
+		if (version < context::version{4,4}) {
+			for (std::size_t i = 0; i != bs.size(); ++i)
+				this->set_binding(first + i, bs[i].view, bs[i].stride);
+
+			return;
+		}
+
+		std::vector<GLuint>   names;
+		std::vector<GLintptr> offsets;
+		std::vector<GLsizei>  strides;
+		names.reserve(bs.size());
+		offsets.reserve(bs.size());
+		strides.reserve(bs.size());
+
+		for (const auto& b : bs) {
+			validate_array_buffer(b.view.get_target());
+
+			names.push_back(b.view.get());
+			offsets.push_back((GLintptr)b.view.get_offset());
+			strides.push_back((GLsizei)b.stride);
+		}
+
+		auto count = (GLsizei)bs.size();
+		if (has_direct_state_access()) {
+			glVertexArrayVertexBuffers(this->get(), (GLuint)first, count, names.data(), offsets.data(), strides.data());
+		} else {
+			this->bind();
+			glBindVertexBuffers((GLuint)first, count, names.data(), offsets.data(), strides.data());
+		}
+	}
+
+	void vertex_array::set_binding_divisor(std::size_t index, std::size_t divisor) {
+		assert(this->is_valid());
+		validate_vertex_binding();
+
+		if (has_direct_state_access()) {
+			glVertexArrayBindingDivisor(this->get(), (GLuint)index, (GLuint)divisor);
+		} else {
+			this->bind();
+			glVertexBindingDivisor((GLuint)index, (GLuint)divisor);
+		}
 	}
 
 	void vertex_array::set_elements(const buffer& b) {
@@ -45,15 +211,23 @@ namespace heatsink::gl {
 		if (b.get_target() != GL_ELEMENT_ARRAY_BUFFER)
 			throw exception("gl::vertex_array", "element buffer must be GL_ELEMENT_ARRAY_BUFFER.");
 
-		this->bind();
-		b.bind();
+		if (has_direct_state_access()) {
+			glVertexArrayElementBuffer(this->get(), b.get());
+		} else {
+			this->bind();
+			b.bind();
+		}
 	}
 
 	void vertex_array::set_elements(std::nullptr_t) {
 		assert(this->is_valid());
 
-		this->bind();
-		name_traits<GL_BUFFER>::bind(0, GL_ELEMENT_ARRAY_BUFFER);
+		if (has_direct_state_access()) {
+			glVertexArrayElementBuffer(this->get(), 0);
+		} else {
+			this->bind();
+			name_traits<GL_BUFFER>::bind(0, GL_ELEMENT_ARRAY_BUFFER);
+		}
 	}
 
 	void vertex_array::set_attribute(const attribute& a, vertex_format f, buffer::const_view v, conversion* conv) {
@@ -62,49 +236,81 @@ namespace heatsink::gl {
 		auto packing = f.get_packing();
 		auto offset  = v.get_offset() + packing.offset;
 
-		if (a.is_annotated() && a.get_size() != extents[1]) {
-			make_error_stream("gl::vertex_array")
-				<< "attribute annotations "
-				<< "(size=" << a.get_size() << ") "
-				<< "do not match format extents "
-				<< "(size=" << extents[1] << ")." << std::endl;
+		validate_annotations(a, extents);
 
-			throw exception("gl::vertex_array", "attribute array size mismatch.");
+		auto dsa = has_direct_state_access();
+		if (!dsa) {
+			this->bind();
+			v.bind();
 		}
 
-		this->bind();
-		v.bind();
-
-		for (auto i = 0; i != extents[1]; ++i) {
-			auto cs = extents[0];
-			if (type == GL_DOUBLE) {
-				// In a `dvec3`, the components must be uploaded in two pieces;
-				// two in the first index, and one in the second.
-				if (cs == 3)
-					cs = (i % 2) ? 1 : 2;
-				// In a `dvec4`, the components can be uploaded evenly; 2 each.
-				else if (cs == 4)
-					cs = 2;
+		for (std::size_t i = 0; i != extents[1]; ++i) {
+			auto cs    = index_components(type, extents[0], i);
+			auto index = (GLuint)(a.get() + i);
+
+			if (dsa) {
+				// Each index is given its own buffer binding point, with the
+				// offset stored in the binding rather than the format. This
+				// keeps the relative offset within its (small) maximum value.
+				auto vao = this->get();
+				glVertexArrayVertexBuffer(vao, index, v.get(), (GLintptr)offset, (GLsizei)packing.stride);
+				glVertexArrayAttribBinding(vao, index, index);
+				glEnableVertexArrayAttrib(vao, index);
+
+				set_index_format(vao, index, cs, type, 0, conv);
+				offset += index_size(type, cs);
+				continue;
 			}
 
-			auto index = a.get() + i;
 			glEnableVertexAttribArray(index);
-
 			if (!conv) {
-				glVertexAttribPointer(index, (GLint)cs, type, GL_TRUE, (GLsizei)packing.stride, (GLvoid*)offset);
+				glVertexAttribPointer(index, cs, type, GL_TRUE, (GLsizei)packing.stride, (GLvoid*)offset);
 			} else switch (*conv) {
 				case conversion::integer:
-					glVertexAttribIPointer(index, (GLint)cs, type, (GLsizei)packing.stride, (GLvoid*)offset);
+					glVertexAttribIPointer(index, cs, type, (GLsizei)packing.stride, (GLvoid*)offset);
 					break;
 				case conversion::floating_point:
-					glVertexAttribPointer(index, (GLint)cs, type, GL_FALSE, (GLsizei)packing.stride, (GLvoid*)offset);
+					glVertexAttribPointer(index, cs, type, GL_FALSE, (GLsizei)packing.stride, (GLvoid*)offset);
 					break;
 				case conversion::double_precision:
-					glVertexAttribLPointer(index, (GLint)cs, type, (GLsizei)packing.stride, (GLvoid*)offset);
+					glVertexAttribLPointer(index, cs, type, (GLsizei)packing.stride, (GLvoid*)offset);
 					break;
 			}
 
-			offset += size_of(type) * cs;
+			offset += index_size(type, cs);
+		}
+	}
+
+	void vertex_array::set_attribute_format(const attribute& a, vertex_format f, std::size_t binding, conversion* conv) {
+		validate_vertex_binding();
+
+		auto type    = f.get_datatype();
+		auto extents = f.get_extents();
+		auto offset  = f.get_packing().offset;
+
+		validate_annotations(a, extents);
+
+		// A name of `0` tells `set_index_format()` to use the bound array.
+		GLuint vao = 0;
+		if (has_direct_state_access())
+			vao = this->get();
+		else
+			this->bind();
+
+		for (std::size_t i = 0; i != extents[1]; ++i) {
+			auto cs    = index_components(type, extents[0], i);
+			auto index = (GLuint)(a.get() + i);
+
+			set_index_format(vao, index, cs, type, (GLuint)offset, conv);
+			if (vao) {
+				glVertexArrayAttribBinding(vao, index, (GLuint)binding);
+				glEnableVertexArrayAttrib(vao, index);
+			} else {
+				glVertexAttribBinding(index, (GLuint)binding);
+				glEnableVertexAttribArray(index);
+			}
+
+			offset += index_size(type, cs);
 		}
 	}
 }
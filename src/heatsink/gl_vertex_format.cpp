@@ -18,8 +18,13 @@ namespace heatsink::gl {
 		if (m_extents[0] > 4)
 			throw exception("gl::vertex_format", "format cannot specify more than 4 components.");
 
+		// Packed types hold every component of an index in a single value.
+		if (is_packed(m_datatype) && m_extents[0] != 4)
+			throw exception("gl::vertex_format", "packed formats must specify 4 components.");
+
 		// Calculate the format stride before modifying index/component values.
-		auto format_size = size_of(m_datatype) * m_extents[0] * m_extents[1];
+		auto element_size = is_packed(m_datatype) ? size_of(m_datatype) : size_of(m_datatype) * m_extents[0];
+		auto format_size  = element_size * m_extents[1];
 		// The datatype should always be a valid GL type.
 		assert(format_size > 0);
 
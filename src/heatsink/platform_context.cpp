@@ -5,6 +5,7 @@
 #include <glfw/glfw3.h>
 
 #include <heatsink/error/exception.hpp>
+#include <heatsink/platform/egl.hpp>
 #include <heatsink/platform/window.hpp>
 
 namespace {
@@ -30,7 +31,7 @@ namespace {
 
 namespace heatsink {
 	context::context(version v, profile p, bool debug)
-	: m_handle{nullptr}, m_version{v}, m_profile{p}, m_debug{debug} {
+	: m_handle{nullptr}, m_version{v}, m_profile{p}, m_debug{debug}, m_synchronous_debug{false}, m_headless{false}, m_device{0} {
 		if (g_initialized)
 			return;
 
@@ -40,8 +41,22 @@ namespace heatsink {
 		g_initialized = true;
 	}
 
+	context::context(std::nullptr_t)
+	: m_handle{nullptr}, m_version{3, 3}, m_profile{profile::any}, m_debug{true}, m_synchronous_debug{false}, m_headless{false}, m_device{0} {}
+
 	context::context(const window& w)
-	: m_handle{w.get()} {
+	: m_handle{w.get()}, m_synchronous_debug{false}, m_headless{w.is_headless()}, m_device{0} {
+#if defined(HEATSINK_EGL)
+		if (m_headless) {
+			const auto& h = *w.m_headless;
+			m_version = h.version;
+			m_profile = h.profile;
+			m_debug   = h.debug;
+			m_device  = h.device;
+			return;
+		}
+#endif
+
 		auto wh = (GLFWwindow*)m_handle;
 
 		m_version.major = glfwGetWindowAttrib(wh, GLFW_CONTEXT_VERSION_MAJOR);
@@ -54,8 +69,38 @@ namespace heatsink {
 		m_debug = glfwGetWindowAttrib(wh, GLFW_OPENGL_DEBUG_CONTEXT);
 	}
 
+	context context::headless(std::size_t device, version v, profile p, bool debug) {
+#if defined(HEATSINK_EGL)
+		// GLFW is not initialized, so no display server is needed.
+		context result(nullptr);
+		result.m_version  = v;
+		result.m_profile  = p;
+		result.m_debug    = debug;
+		result.m_headless = true;
+		result.m_device   = device;
+
+		// Fail early on a bad device index, rather than on the first window.
+		egl::get_display(device);
+		return result;
+#else
+		(void)device, (void)v, (void)p, (void)debug;
+		throw exception("context", "headless contexts require HEATSINK_EGL.");
+#endif
+	}
+
+	std::vector<std::string> context::get_devices() {
+		std::vector<std::string> result;
+#if defined(HEATSINK_EGL)
+		for (std::size_t i = 0; i != egl::get_devices().size(); ++i)
+			result.push_back(egl::get_device_name(i));
+#endif
+
+		return result;
+	}
+
 	context::context(context&& other) noexcept
-	: m_version{other.m_version}, m_profile{other.m_profile}, m_debug{other.m_debug}, m_handle{other.m_handle} {}
+	: m_handle{other.m_handle}, m_version{other.m_version}, m_profile{other.m_profile}, m_debug{other.m_debug},
+	  m_synchronous_debug{other.m_synchronous_debug}, m_headless{other.m_headless}, m_device{other.m_device} {}
 
 	context::~context() {}
 
@@ -64,6 +109,11 @@ namespace heatsink {
 		m_profile = other.m_profile;
 		m_debug   = other.m_debug;
 
+		m_synchronous_debug = other.m_synchronous_debug;
+
+		m_headless = other.m_headless;
+		m_device   = other.m_device;
+
 		m_handle = other.m_handle;
 		return *this;
 	}
@@ -83,4 +133,20 @@ namespace heatsink {
 	bool context::is_debug() const {
 		return m_debug;
 	}
+
+	void context::set_synchronous_debug(bool synchronous) {
+		m_synchronous_debug = synchronous;
+	}
+
+	bool context::is_synchronous_debug() const {
+		return m_synchronous_debug;
+	}
+
+	bool context::is_headless() const {
+		return m_headless;
+	}
+
+	std::size_t context::get_device() const {
+		return m_device;
+	}
 }
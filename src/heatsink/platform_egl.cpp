@@ -0,0 +1,86 @@
+#include <heatsink/platform/egl.hpp>
+
+#include <map>
+#include <mutex>
+#include <ostream>
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Devices and their displays are shared by every thread.
+	std::mutex g_mutex;
+	std::map<std::size_t, EGLDisplay> g_displays;
+
+	using heatsink::exception;
+
+	void validate_device(std::size_t device) {
+		auto count = heatsink::egl::get_devices().size();
+		if (device >= count) {
+			heatsink::make_error_stream("egl")
+				<< "invalid device index "
+				<< "(index=" << device << ") "
+				<< "for " << count << " device(s)." << std::endl;
+
+			throw exception("egl", "invalid device index.");
+		}
+	}
+}
+
+namespace heatsink::egl {
+	const std::vector<EGLDeviceEXT>& get_devices() {
+		static auto devices = [] {
+			// Client extensions are queried without a display.
+			if (!epoxy_has_egl_extension(EGL_NO_DISPLAY, "EGL_EXT_device_enumeration") ||
+				!epoxy_has_egl_extension(EGL_NO_DISPLAY, "EGL_EXT_platform_device"))
+				throw exception("egl", "device enumeration is not supported.");
+
+			EGLint count = 0;
+			eglQueryDevicesEXT(0, nullptr, &count);
+
+			std::vector<EGLDeviceEXT> result((std::size_t)count);
+			if (count > 0)
+				eglQueryDevicesEXT(count, result.data(), &count);
+
+			result.resize((std::size_t)count);
+			return result;
+		}();
+
+		return devices;
+	}
+
+	std::string get_device_name(std::size_t device) {
+		validate_device(device);
+		auto d = get_devices()[device];
+
+		// Device extensions are queried through the device itself.
+		const auto* extensions = eglQueryDeviceStringEXT(d, EGL_EXTENSIONS);
+		if (extensions && std::string(extensions).find("EGL_EXT_device_drm") != std::string::npos) {
+			if (const auto* file = eglQueryDeviceStringEXT(d, EGL_DRM_DEVICE_FILE_EXT))
+				return file;
+		}
+
+		return "device " + std::to_string(device);
+	}
+
+	EGLDisplay get_display(std::size_t device) {
+		validate_device(device);
+
+		std::lock_guard lock(g_mutex);
+		if (auto it = g_displays.find(device); it != g_displays.end())
+			return it->second;
+
+		auto display = eglGetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, get_devices()[device], nullptr);
+		if (display == EGL_NO_DISPLAY)
+			throw exception("egl", "could not create device display.");
+
+		EGLint major, minor;
+		if (eglInitialize(display, &major, &minor) != EGL_TRUE)
+			throw exception("egl", "could not initialize device display.");
+
+		// Terminating a display destroys every context on it, so displays
+		// are only released when the process exits.
+		g_displays.emplace(device, display);
+		return display;
+	}
+}
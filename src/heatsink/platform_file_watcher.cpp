@@ -0,0 +1,178 @@
+#include <heatsink/platform/file_watcher.hpp>
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#elif defined(__linux__)
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Retrieve the modification time of a file, or the minimum time if it
+	// does not currently exist (such as in the middle of being replaced).
+	std::filesystem::file_time_type get_time(const std::filesystem::path& path) {
+		std::error_code error;
+		auto time = std::filesystem::last_write_time(path, error);
+		return error ? std::filesystem::file_time_type::min() : time;
+	}
+
+	// Report a directory that could not be watched, and throw.
+	[[noreturn]] void throw_watch_error(const std::filesystem::path& path) {
+		heatsink::make_error_stream("file_watcher")
+			<< "cannot watch directory "
+			<< "\"" << path.string() << "\"." << std::endl;
+
+		throw heatsink::exception("file_watcher", "could not watch directory.");
+	}
+}
+
+namespace heatsink {
+	file_watcher::file_watcher()
+	: m_inotify{-1} {
+#if defined(__linux__)
+		m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotify < 0)
+			throw exception("file_watcher", "could not initialize inotify.");
+#endif
+	}
+
+	file_watcher::file_watcher(file_watcher&& other) noexcept
+	: m_directories{std::move(other.m_directories)}, m_inotify{std::exchange(other.m_inotify, -1)} {
+		other.m_directories.clear();
+	}
+
+	file_watcher::~file_watcher() {
+		this->reset();
+	}
+
+	file_watcher& file_watcher::operator =(file_watcher&& other) noexcept {
+		this->reset();
+		m_directories = std::move(other.m_directories);
+		m_inotify     = std::exchange(other.m_inotify, -1);
+
+		other.m_directories.clear();
+		return *this;
+	}
+
+	void file_watcher::watch(const std::filesystem::path& path) {
+		auto file = std::filesystem::weakly_canonical(path);
+		auto dir  = file.parent_path();
+
+		auto it = m_directories.find(dir);
+		if (it == m_directories.end()) {
+			directory d = {.handle = -1, .files = {}};
+#if defined(_WIN32)
+			auto filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME;
+			auto handle = FindFirstChangeNotificationW(dir.c_str(), FALSE, filter);
+			if (handle == INVALID_HANDLE_VALUE)
+				throw_watch_error(dir);
+
+			d.handle = reinterpret_cast<std::intptr_t>(handle);
+#elif defined(__linux__)
+			// Editors commonly save by writing a new file and renaming it over
+			// the old one, so both writes and moves into the directory count.
+			auto mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+			d.handle  = ::inotify_add_watch(m_inotify, dir.c_str(), mask);
+			if (d.handle < 0)
+				throw_watch_error(dir);
+#endif
+			it = m_directories.emplace(dir, std::move(d)).first;
+		}
+
+		it->second.files.try_emplace(file.filename(), get_time(file));
+	}
+
+	void file_watcher::unwatch(const std::filesystem::path& path) {
+		auto file = std::filesystem::weakly_canonical(path);
+		auto it   = m_directories.find(file.parent_path());
+		if (it == m_directories.end())
+			return;
+
+		auto& d = it->second;
+		d.files.erase(file.filename());
+		if (!d.files.empty())
+			return;
+
+#if defined(_WIN32)
+		FindCloseChangeNotification(reinterpret_cast<HANDLE>(d.handle));
+#elif defined(__linux__)
+		::inotify_rm_watch(m_inotify, (int)d.handle);
+#endif
+		m_directories.erase(it);
+	}
+
+	std::vector<std::filesystem::path> file_watcher::poll() {
+		std::vector<std::filesystem::path> results;
+
+#if defined(_WIN32)
+		// A notification only says that something in the directory changed,
+		// so the watched files are then compared by modification time.
+		for (auto& [path, d] : m_directories) {
+			auto handle = reinterpret_cast<HANDLE>(d.handle);
+			if (WaitForSingleObject(handle, 0) != WAIT_OBJECT_0)
+				continue;
+
+			compare_times(path, d, results);
+			FindNextChangeNotification(handle);
+		}
+#elif defined(__linux__)
+		alignas(inotify_event) char buffer[4096];
+		for (ssize_t size; (size = ::read(m_inotify, buffer, sizeof(buffer))) > 0;) {
+			for (ssize_t offset = 0; offset < size;) {
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+				offset += sizeof(inotify_event) + event->len;
+				if (event->len == 0)
+					continue;
+
+				auto it = std::find_if(m_directories.begin(), m_directories.end(), [&](const auto& entry) {
+					return entry.second.handle == event->wd;
+				});
+				if (it == m_directories.end() || !it->second.files.count(event->name))
+					continue;
+
+				auto file = it->first / event->name;
+				if (std::find(results.begin(), results.end(), file) == results.end())
+					results.push_back(file);
+			}
+		}
+#else
+		for (auto& [path, d] : m_directories)
+			compare_times(path, d, results);
+#endif
+
+		return results;
+	}
+
+	void file_watcher::reset() {
+#if defined(_WIN32)
+		for (const auto& [path, d] : m_directories)
+			FindCloseChangeNotification(reinterpret_cast<HANDLE>(d.handle));
+#elif defined(__linux__)
+		// Closing the instance also removes all of its watches.
+		if (m_inotify >= 0)
+			::close(m_inotify);
+#endif
+		m_directories.clear();
+		m_inotify = -1;
+	}
+
+	void file_watcher::compare_times(const std::filesystem::path& path, directory& d, std::vector<std::filesystem::path>& results) {
+		for (auto& [name, time] : d.files) {
+			auto current = get_time(path / name);
+			if (current == time)
+				continue;
+
+			time = current;
+			results.push_back(path / name);
+		}
+	}
+}
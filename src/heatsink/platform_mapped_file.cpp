@@ -0,0 +1,144 @@
+#include <heatsink/platform/mapped_file.hpp>
+
+#include <cassert>
+#include <ostream>
+#include <utility>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include <heatsink/error/debug.hpp>
+#include <heatsink/error/exception.hpp>
+
+namespace {
+	// Report a file that could not be mapped, and throw.
+	[[noreturn]] void throw_map_error(const std::filesystem::path& path, const char* message) {
+		heatsink::make_error_stream("mapped_file")
+			<< "cannot map path "
+			<< "\"" << path.string() << "\"." << std::endl;
+
+		throw heatsink::exception("mapped_file", message);
+	}
+}
+
+namespace heatsink {
+	mapped_file mapped_file::null() {
+		return mapped_file(nullptr);
+	}
+
+#if defined(_WIN32)
+	mapped_file::mapped_file(const std::filesystem::path& path)
+	: m_data{nullptr}, m_size{0}, m_valid{true} {
+		auto handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handle == INVALID_HANDLE_VALUE)
+			throw_map_error(path, "could not open path.");
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(handle, &size)) {
+			CloseHandle(handle);
+			throw_map_error(path, "could not stat path.");
+		}
+
+		m_size = (std::size_t)size.QuadPart;
+		if (m_size == 0) {
+			CloseHandle(handle);
+			return;
+		}
+
+		// The view keeps the file mapping alive, so both handles can be closed.
+		auto mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(handle);
+		if (mapping == nullptr)
+			throw_map_error(path, "could not map path.");
+
+		m_data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		CloseHandle(mapping);
+		if (m_data == nullptr)
+			throw_map_error(path, "could not map path.");
+	}
+#else
+	mapped_file::mapped_file(const std::filesystem::path& path)
+	: m_data{nullptr}, m_size{0}, m_valid{true} {
+		auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			throw_map_error(path, "could not open path.");
+
+		struct stat info;
+		if (::fstat(fd, &info) != 0) {
+			::close(fd);
+			throw_map_error(path, "could not stat path.");
+		}
+
+		m_size = (std::size_t)info.st_size;
+		if (m_size == 0) {
+			::close(fd);
+			return;
+		}
+
+		// The mapping stays valid after the descriptor is closed.
+		auto* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			throw_map_error(path, "could not map path.");
+
+		// Files are (almost always) read front to back, once.
+		::madvise(data, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<const std::byte*>(data);
+	}
+#endif
+
+	mapped_file::mapped_file(std::nullptr_t)
+	: m_data{nullptr}, m_size{0}, m_valid{false} {}
+
+	mapped_file::mapped_file(mapped_file&& other) noexcept
+	: m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}, m_valid{std::exchange(other.m_valid, false)} {}
+
+	mapped_file::~mapped_file() {
+		this->reset();
+	}
+
+	mapped_file& mapped_file::operator =(mapped_file&& other) noexcept {
+		this->reset();
+		m_data  = std::exchange(other.m_data, nullptr);
+		m_size  = std::exchange(other.m_size, 0);
+		m_valid = std::exchange(other.m_valid, false);
+
+		return *this;
+	}
+
+	bool mapped_file::is_valid() const {
+		return m_valid;
+	}
+
+	const std::byte* mapped_file::get_data() const {
+		assert(this->is_valid());
+		return m_data;
+	}
+
+	std::size_t mapped_file::get_size() const {
+		assert(this->is_valid());
+		return m_size;
+	}
+
+	void mapped_file::reset() {
+		if (m_data != nullptr) {
+#if defined(_WIN32)
+			UnmapViewOfFile(m_data);
+#else
+			::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+		}
+
+		m_data  = nullptr;
+		m_size  = 0;
+		m_valid = false;
+	}
+}
@@ -0,0 +1,132 @@
+#include <heatsink/platform/thread_pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace {
+	// The pool and index of the worker running on the calling thread, used to
+	// push jobs submitted from within a job onto the worker's own queue.
+	thread_local const heatsink::thread_pool* g_pool = nullptr;
+	thread_local std::size_t g_worker = 0;
+}
+
+namespace heatsink {
+	thread_pool::thread_pool(std::size_t threads)
+	: m_queued{0}, m_pending{0}, m_stopping{false}, m_next{0} {
+		threads = std::max<std::size_t>(threads, 1);
+		for (std::size_t i = 0; i != threads; ++i)
+			m_queues.push_back(std::make_unique<queue>());
+
+		// Every queue must exist before any worker may try to steal from it.
+		for (std::size_t i = 0; i != threads; ++i)
+			m_threads.emplace_back([this, i] { this->run(i); });
+	}
+
+	thread_pool::~thread_pool() {
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopping = true;
+		}
+
+		m_wake.notify_all();
+		for (auto& t : m_threads)
+			t.join();
+	}
+
+	void thread_pool::submit(job j) {
+		auto index = (g_pool == this) ? g_worker : (m_next++ % m_queues.size());
+		// The job is counted before it is published, as a worker may take it
+		// (and decrement the counters) as soon as it is in a queue. The locks
+		// are not nested, as `take()` locks them in the opposite order.
+		{
+			std::lock_guard lock(m_mutex);
+			++m_queued;
+			++m_pending;
+		}
+		{
+			std::lock_guard lock(m_queues[index]->mutex);
+			m_queues[index]->jobs.push_back(std::move(j));
+		}
+
+		m_wake.notify_one();
+	}
+
+	void thread_pool::parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)>& f) {
+		for (std::size_t i = 0; i != count; ++i)
+			this->submit([&f, i](std::size_t worker) { f(i, worker); });
+
+		this->wait();
+	}
+
+	void thread_pool::wait() {
+		assert(g_pool != this);
+
+		std::unique_lock lock(m_mutex);
+		m_done.wait(lock, [this] { return m_pending == 0; });
+
+		if (auto error = std::exchange(m_error, nullptr))
+			std::rethrow_exception(error);
+	}
+
+	std::size_t thread_pool::get_thread_count() const {
+		return m_threads.size();
+	}
+
+	void thread_pool::run(std::size_t worker) {
+		g_pool   = this;
+		g_worker = worker;
+
+		while (true) {
+			job j;
+			if (!this->take(worker, j)) {
+				std::unique_lock lock(m_mutex);
+				m_wake.wait(lock, [this] { return m_stopping || m_queued != 0; });
+
+				if (m_stopping)
+					return;
+				else
+					continue;
+			}
+
+			std::exception_ptr error;
+			try {
+				j(worker);
+			} catch (...) {
+				error = std::current_exception();
+			}
+
+			std::lock_guard lock(m_mutex);
+			if (error && !m_error)
+				m_error = error;
+			if (--m_pending == 0)
+				m_done.notify_all();
+		}
+	}
+
+	bool thread_pool::take(std::size_t worker, job& result) {
+		auto n = m_queues.size();
+		for (std::size_t i = 0; i != n; ++i) {
+			// The worker's own queue is used as a stack, and the others as
+			// queues, so that stolen jobs are the oldest (and usually largest).
+			auto& q = *m_queues[(worker + i) % n];
+			std::lock_guard lock(q.mutex);
+			if (q.jobs.empty())
+				continue;
+
+			if (i == 0) {
+				result = std::move(q.jobs.back());
+				q.jobs.pop_back();
+			} else {
+				result = std::move(q.jobs.front());
+				q.jobs.pop_front();
+			}
+
+			std::lock_guard counters(m_mutex);
+			--m_queued;
+			return true;
+		}
+
+		return false;
+	}
+}
@@ -3,11 +3,16 @@
 #include <cassert>
 #include <ostream>
 #include <tuple>
+#include <vector>
 
 #include <glfw/glfw3.h>
 
 #include <heatsink/error/debug.hpp>
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/debug_queue.hpp>
+#include <heatsink/gl/frame_pacer.hpp>
+#include <heatsink/platform/egl.hpp>
 #include <heatsink/platform/gl.hpp>
 
 namespace {
@@ -31,7 +36,46 @@ namespace {
 	}
 }
 
+#if defined(HEATSINK_EGL)
+namespace {
+	// Build the attribute list for `eglCreateContext()`.
+	std::vector<EGLint> make_context_attributes(const context& c) {
+		std::vector<EGLint> result = {
+			EGL_CONTEXT_MAJOR_VERSION, (EGLint)c.get_version().major,
+			EGL_CONTEXT_MINOR_VERSION, (EGLint)c.get_version().minor,
+		};
+
+		// Profiles only exist from OpenGL 3.2.
+		if (c.get_version() >= context::version{3,2} && c.get_profile() != context::profile::any) {
+			result.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK);
+			result.push_back((c.get_profile() == context::profile::compatibility)
+				? EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT
+				: EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT);
+		}
+
+		if (c.get_profile() == context::profile::strict) {
+			result.push_back(EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE);
+			result.push_back(EGL_TRUE);
+		}
+
+		if (c.is_debug()) {
+			result.push_back(EGL_CONTEXT_OPENGL_DEBUG);
+			result.push_back(EGL_TRUE);
+		}
+
+		result.push_back(EGL_NONE);
+		return result;
+	}
+}
+#endif
+
 namespace heatsink {
+#if !defined(HEATSINK_EGL)
+	// Headless windows cannot be created without the EGL backend, but the
+	// type must still be complete to be held by `window`.
+	struct window::headless {};
+#endif
+
 	struct window::callbacks {
 		static void resize(GLFWwindow* wh, int, int) {
 			auto& w = *(window*)glfwGetWindowUserPointer(wh);
@@ -45,15 +89,25 @@ namespace heatsink {
 		}
 
 		static void message(GLenum, GLenum type, GLuint, GLenum sev, GLsizei, const GLchar* msg, const GLvoid*) {
-			auto ts  = heatsink::gl::to_string(type);
-			auto ss  = heatsink::gl::to_string(sev);
-			auto out = ts + "(" + ss + ") - " + msg;
+			auto out = format(type, sev, msg);
 
-			if (type == GL_DEBUG_TYPE_ERROR || sev == GL_DEBUG_SEVERITY_HIGH)
+			if (is_error(type, sev))
 				throw exception("platform", out);
 			else
 				make_error_stream("platform") << out << std::endl;
 		}
+
+		// Describe a debug message, as reported by `message()`.
+		static std::string format(GLenum type, GLenum sev, const std::string& msg) {
+			auto ts = heatsink::gl::to_string(type);
+			auto ss = heatsink::gl::to_string(sev);
+			return ts + "(" + ss + ") - " + msg;
+		}
+
+		// Check if a debug message should be raised as an exception.
+		static bool is_error(GLenum type, GLenum sev) {
+			return type == GL_DEBUG_TYPE_ERROR || sev == GL_DEBUG_SEVERITY_HIGH;
+		}
 	};
 }
 
@@ -63,6 +117,9 @@ namespace heatsink {
 	}
 
 	window window::offscreen(const context& c) {
+		if (c.is_headless())
+			return make_headless(c);
+
 		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
 		// Even though the screen buffer is unusable, a valid size must be used.
@@ -73,6 +130,9 @@ namespace heatsink {
 	}
 
 	window::window(const context& c, const std::string& name, extents e, bool resize) {
+		if (c.is_headless())
+			throw exception("window", "headless contexts can only create offscreen windows.");
+
 		// FIXME: some sizes may be too small for the WM; try to catch this.
 		//assert(e.x && e.y);
 		
@@ -103,36 +163,35 @@ namespace heatsink {
 		// one to get the initial window/framebuffer size.
 		callbacks::resize(wh, -1, -1);
 
-		this->use();
-		// The OpenGL debug callback is only available in versions >=4.3
-		if (c.is_debug() && c.get_version() >= context::version{4,3}) {
-			glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-			glDebugMessageCallback((GLDEBUGPROC)callbacks::message, nullptr);
-		}
+		// The state queries the context, so it must be current first.
+		glfwMakeContextCurrent(wh);
+		this->initialize(c);
 	}
 
 	window::window(window&& other) noexcept
-	: m_handle{other.m_handle}, m_extents{other.m_extents}, m_framebuffer_extents{other.m_framebuffer_extents} {
-		if (m_handle)
+	: m_handle{other.m_handle}, m_state{std::move(other.m_state)}, m_headless{std::move(other.m_headless)},
+	  m_messages{std::move(other.m_messages)}, m_extents{other.m_extents}, m_framebuffer_extents{other.m_framebuffer_extents} {
+		if (m_handle && !m_headless)
 			glfwSetWindowUserPointer((GLFWwindow*)m_handle, (void*)this);
 
 		other.m_handle = nullptr;
 	}
 
 	window::~window() {
-		if (m_handle)
-			glfwDestroyWindow((GLFWwindow*)m_handle);
+		this->reset();
 	}
 
 	window& window::operator =(window&& other) {
-		if (m_handle)
-			glfwDestroyWindow((GLFWwindow*)m_handle);
+		this->reset();
 
 		m_handle              = other.m_handle;
+		m_state               = std::move(other.m_state);
+		m_headless            = std::move(other.m_headless);
+		m_messages            = std::move(other.m_messages);
 		m_extents             = other.m_extents;
 		m_framebuffer_extents = other.m_framebuffer_extents;
 
-		if (m_handle)
+		if (m_handle && !m_headless)
 			glfwSetWindowUserPointer((GLFWwindow*)m_handle, (void*)this);
 		
 		other.m_handle = nullptr;
@@ -142,25 +201,167 @@ namespace heatsink {
 	window::window(std::nullptr_t)
 	: m_handle{nullptr} {}
 
+	window window::make_headless(const context& c) {
+#if defined(HEATSINK_EGL)
+		auto h = std::make_unique<headless>();
+		h->display = egl::get_display(c.get_device());
+		h->device  = c.get_device();
+		h->version = c.get_version();
+		h->profile = c.get_profile();
+		h->debug   = c.is_debug();
+
+		if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+			throw exception("window", "EGL does not support desktop OpenGL.");
+
+		// Without the surfaceless extension, a minimal pbuffer is made current
+		// instead; it is never rendered to.
+		auto surfaceless = epoxy_has_egl_extension(h->display, "EGL_KHR_surfaceless_context");
+		const EGLint config_attributes[] = {
+			EGL_SURFACE_TYPE,    surfaceless ? 0 : EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE,
+		};
+
+		EGLint count = 0;
+		if (eglChooseConfig(h->display, config_attributes, &h->config, 1, &count) != EGL_TRUE || count == 0)
+			throw exception("window", "could not find a suitable EGL config.");
+
+		// Contexts created from a headless window share with it.
+		auto share = (c.get() != nullptr) ? (EGLContext)c.get() : EGL_NO_CONTEXT;
+		auto attributes = make_context_attributes(c);
+		h->context = eglCreateContext(h->display, h->config, share, attributes.data());
+		if (h->context == EGL_NO_CONTEXT)
+			throw exception("window", "could not create EGL context.");
+
+		h->surface = EGL_NO_SURFACE;
+		if (!surfaceless) {
+			const EGLint pbuffer_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+			h->surface = eglCreatePbufferSurface(h->display, h->config, pbuffer_attributes);
+			if (h->surface == EGL_NO_SURFACE) {
+				eglDestroyContext(h->display, h->context);
+				throw exception("window", "could not create EGL pbuffer surface.");
+			}
+		}
+
+		window result(nullptr);
+		result.m_handle              = (void*)h->context;
+		result.m_headless            = std::move(h);
+		result.m_extents             = {0,0};
+		result.m_framebuffer_extents = {0,0};
+
+		eglMakeCurrent(result.m_headless->display, result.m_headless->surface, result.m_headless->surface, result.m_headless->context);
+		result.initialize(c);
+		return result;
+#else
+		(void)c;
+		throw exception("window", "headless windows require HEATSINK_EGL.");
+#endif
+	}
+
+	void window::initialize(const context& c) {
+		m_state = std::make_unique<gl::context_state>();
+
+		this->use();
+		// The OpenGL debug callback is only available in versions >=4.3
+		if (!c.is_debug() || c.get_version() < context::version{4,3})
+			return;
+
+		if (c.is_synchronous_debug()) {
+			glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+			glDebugMessageCallback((GLDEBUGPROC)callbacks::message, nullptr);
+		} else {
+			// Messages are reported by `flush_messages()` instead; exceptions
+			// cannot be thrown from driver threads.
+			m_messages = std::make_unique<gl::debug_queue>();
+			m_messages->install();
+		}
+	}
+
+	void window::reset() {
+		if (!m_handle)
+			return;
+
+#if defined(HEATSINK_EGL)
+		if (m_headless) {
+			auto& h = *m_headless;
+			if (eglGetCurrentContext() == h.context)
+				eglMakeCurrent(h.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			if (h.surface != EGL_NO_SURFACE)
+				eglDestroySurface(h.display, h.surface);
+
+			eglDestroyContext(h.display, h.context);
+			m_headless.reset();
+			m_handle = nullptr;
+			return;
+		}
+#endif
+
+		glfwDestroyWindow((GLFWwindow*)m_handle);
+		m_handle = nullptr;
+	}
+
 	void window::use() const {
 		assert(this->is_valid());
+#if defined(HEATSINK_EGL)
+		if (m_headless) {
+			eglMakeCurrent(m_headless->display, m_headless->surface, m_headless->surface, m_headless->context);
+			gl::context_state::set_current(m_state.get());
+			return;
+		}
+#endif
+
 		glfwMakeContextCurrent((GLFWwindow*)m_handle);
+		gl::context_state::set_current(m_state.get());
+	}
+
+	void window::release() const {
+		assert(this->is_valid());
+#if defined(HEATSINK_EGL)
+		if (m_headless) {
+			if (eglGetCurrentContext() == m_headless->context) {
+				eglMakeCurrent(m_headless->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+				gl::context_state::set_current(nullptr);
+			}
+
+			return;
+		}
+#endif
+
+		if (glfwGetCurrentContext() == (GLFWwindow*)m_handle) {
+			glfwMakeContextCurrent(nullptr);
+			gl::context_state::set_current(nullptr);
+		}
 	}
 
 	bool window::flush_buffers() const {
+		return this->present(nullptr);
+	}
+
+	bool window::flush_buffers(gl::frame_pacer& pacer) const {
+		return this->present(&pacer);
+	}
+
+	bool window::set_swap_interval(std::size_t interval, bool adaptive) {
 		assert(this->is_valid());
-		auto* wh = (GLFWwindow*)m_handle;
+		if (m_headless)
+			return !adaptive;
 
-		glfwSwapBuffers(wh);
-		// Process events for all windows; this may invoke callbacks of any
-		// windows currently in use, not just the one being refreshed.
-		glfwPollEvents();
+		// Both the extension query and the interval apply to the current
+		// context, so this window must be made current first.
+		this->use();
 
-		return !glfwWindowShouldClose(wh);
+		// Adaptive vsync is requested with a negative interval.
+		auto tear = glfwExtensionSupported("WGL_EXT_swap_control_tear")
+			|| glfwExtensionSupported("GLX_EXT_swap_control_tear");
+		auto use_tear = adaptive && tear && interval != 0;
+
+		glfwSwapInterval(use_tear ? -(int)interval : (int)interval);
+		return use_tear || !adaptive;
 	}
 
 	void window::flush_errors() const {
 		assert(this->is_valid());
+		this->flush_messages();
 
 		// `glGetError()` acts like a stack; multiple errors can be queued, the
 		// end signified by a `GL_NO_ERROR` return value.
@@ -170,10 +371,67 @@ namespace heatsink {
 		}
 	}
 
+	void window::flush_messages() const {
+		assert(this->is_valid());
+		if (!m_messages)
+			return;
+
+		// Every message is reported before the first error is thrown, so that
+		// no message is lost (or reported out of order) by the exception.
+		std::string error;
+		m_messages->drain([&](const gl::debug_queue::message& m) {
+			auto out = callbacks::format(m.type, m.severity, m.text);
+			if (error.empty() && callbacks::is_error(m.type, m.severity))
+				error = out;
+			else
+				make_error_stream("platform") << out << std::endl;
+		});
+
+		if (auto dropped = m_messages->take_dropped()) {
+			make_error_stream("platform")
+				<< dropped << " debug messages were dropped "
+				<< "(capacity=" << m_messages->get_capacity() << ")." << std::endl;
+		}
+
+		if (!error.empty())
+			throw exception("platform", error);
+	}
+
+	bool window::present(gl::frame_pacer* pacer) const {
+		assert(this->is_valid());
+		this->flush_messages();
+		if (pacer)
+			pacer->end_frame();
+
+		// A headless window has nothing to present, and no events.
+		if (m_headless) {
+			glFlush();
+			if (pacer)
+				pacer->begin_frame();
+
+			return true;
+		}
+
+		auto* wh = (GLFWwindow*)m_handle;
+
+		glfwSwapBuffers(wh);
+		if (pacer)
+			pacer->begin_frame();
+		// Process events for all windows; this may invoke callbacks of any
+		// windows currently in use, not just the one being refreshed.
+		glfwPollEvents();
+
+		return !glfwWindowShouldClose(wh);
+	}
+
 	bool window::is_valid() const {
 		return (m_handle != nullptr);
 	}
 
+	bool window::is_headless() const {
+		return (m_headless != nullptr);
+	}
+
 	void* window::get() const {
 		assert(this->is_valid());
 		return m_handle;
@@ -3,11 +3,16 @@
 #include <cassert>
 
 #include <heatsink/error/exception.hpp>
+#include <heatsink/gl/context_state.hpp>
+#include <heatsink/gl/memory_tracker.hpp>
 
 namespace heatsink::gl {
-	GLuint name_traits<GL_BUFFER>::create() {
-		GLuint name;
-		glGenBuffers(1, &name);
+	GLuint name_traits<GL_BUFFER>::create(GLenum) {
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateBuffers(1, &name);
+		else
+			glGenBuffers(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate buffer.");
@@ -18,15 +23,21 @@ namespace heatsink::gl {
 	void name_traits<GL_BUFFER>::destroy(GLuint name) {
 		assert(name);
 		glDeleteBuffers(1, &name);
+		context_state::get_current().release_name(GL_BUFFER, name);
+		memory_tracker::release(GL_BUFFER, name);
 	}
 
 	void name_traits<GL_BUFFER>::bind(GLuint name, GLenum target) {
-		glBindBuffer(target, name);
+		if (context_state::get_current().set_binding(GL_BUFFER, target, 0, name))
+			glBindBuffer(target, name);
 	}
 
-	GLuint name_traits<GL_FRAMEBUFFER>::create() {
-		GLuint name;
-		glGenFramebuffers(1, &name);
+	GLuint name_traits<GL_FRAMEBUFFER>::create(GLenum) {
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateFramebuffers(1, &name);
+		else
+			glGenFramebuffers(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate framebuffer.");
@@ -37,15 +48,32 @@ namespace heatsink::gl {
 	void name_traits<GL_FRAMEBUFFER>::destroy(GLuint name) {
 		assert(name);
 		glDeleteFramebuffers(1, &name);
+		context_state::get_current().release_name(GL_FRAMEBUFFER, name);
 	}
 
 	void name_traits<GL_FRAMEBUFFER>::bind(GLuint name, GLenum target) {
-		glBindFramebuffer(target, name);
+		auto& state = context_state::get_current();
+		if (target != GL_FRAMEBUFFER) {
+			if (state.set_binding(GL_FRAMEBUFFER, target, 0, name))
+				glBindFramebuffer(target, name);
+
+			return;
+		}
+
+		// `GL_FRAMEBUFFER` sets both the draw and read targets, so the bind can
+		// only be skipped if the name is already bound to both.
+		auto draw = state.set_binding(GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER, 0, name);
+		auto read = state.set_binding(GL_FRAMEBUFFER, GL_READ_FRAMEBUFFER, 0, name);
+		if (draw || read)
+			glBindFramebuffer(target, name);
 	}
 
 	GLuint name_traits<GL_PROGRAM_PIPELINE>::create() {
-		GLuint name;
-		glGenProgramPipelines(1, &name);
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateProgramPipelines(1, &name);
+		else
+			glGenProgramPipelines(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate program pipeline.");
@@ -56,15 +84,20 @@ namespace heatsink::gl {
 	void name_traits<GL_PROGRAM_PIPELINE>::destroy(GLuint name) {
 		assert(name);
 		glDeleteProgramPipelines(1, &name);
+		context_state::get_current().release_name(GL_PROGRAM_PIPELINE, name);
 	}
 
 	void name_traits<GL_PROGRAM_PIPELINE>::bind(GLuint name) {
-		glBindProgramPipeline(name);
+		if (context_state::get_current().set_binding(GL_PROGRAM_PIPELINE, GL_NONE, 0, name))
+			glBindProgramPipeline(name);
 	}
 
-	GLuint name_traits<GL_QUERY>::create() {
-		GLuint name;
-		glGenQueries(1, &name);
+	GLuint name_traits<GL_QUERY>::create(GLenum target) {
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateQueries(target, 1, &name);
+		else
+			glGenQueries(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate query.");
@@ -78,7 +111,7 @@ namespace heatsink::gl {
 	}
 
 	void name_traits<GL_QUERY>::bind(GLuint name, GLenum target) {
-		// FIXME: determine the best way to handle queries as objects.
+		// A query is "bound" for as long as it is active; see `gl::query`.
 		if (name)
 			glBeginQuery(target, name);
 		else
@@ -86,8 +119,11 @@ namespace heatsink::gl {
 	}
 
 	GLuint name_traits<GL_RENDERBUFFER>::create() {
-		GLuint name;
-		glGenRenderbuffers(1, &name);
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateRenderbuffers(1, &name);
+		else
+			glGenRenderbuffers(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate renderbuffer.");
@@ -98,15 +134,20 @@ namespace heatsink::gl {
 	void name_traits<GL_RENDERBUFFER>::destroy(GLuint name) {
 		assert(name);
 		glDeleteRenderbuffers(1, &name);
+		context_state::get_current().release_name(GL_RENDERBUFFER, name);
 	}
 
 	void name_traits<GL_RENDERBUFFER>::bind(GLuint name) {
-		glBindRenderbuffer(GL_RENDERBUFFER, name);
+		if (context_state::get_current().set_binding(GL_RENDERBUFFER, GL_RENDERBUFFER, 0, name))
+			glBindRenderbuffer(GL_RENDERBUFFER, name);
 	}
 
 	GLuint name_traits<GL_SAMPLER>::create() {
-		GLuint name;
-		glGenSamplers(1, &name);
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateSamplers(1, &name);
+		else
+			glGenSamplers(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate sampler.");
@@ -117,15 +158,20 @@ namespace heatsink::gl {
 	void name_traits<GL_SAMPLER>::destroy(GLuint name) {
 		assert(name);
 		glDeleteSamplers(1, &name);
+		context_state::get_current().release_name(GL_SAMPLER, name);
 	}
 
 	void name_traits<GL_SAMPLER>::bind(GLuint name, std::size_t unit) {
-		glBindSampler((GLuint)unit, name);
+		if (context_state::get_current().set_binding(GL_SAMPLER, GL_NONE, unit, name))
+			glBindSampler((GLuint)unit, name);
 	}
 
-	GLuint name_traits<GL_TEXTURE>::create() {
-		GLuint name;
-		glGenTextures(1, &name);
+	GLuint name_traits<GL_TEXTURE>::create(GLenum target) {
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateTextures(target, 1, &name);
+		else
+			glGenTextures(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate texture.");
@@ -135,17 +181,35 @@ namespace heatsink::gl {
 
 	void name_traits<GL_TEXTURE>::destroy(GLuint name) {
 		assert(name);
+		auto& state = context_state::get_current();
+		// A resident handle must not outlive its texture.
+		if (auto handle = state.clear_resident(name))
+			glMakeTextureHandleNonResidentARB(handle);
+
 		glDeleteTextures(1, &name);
+		state.release_name(GL_TEXTURE, name);
+		memory_tracker::release(GL_TEXTURE, name);
 	}
 
 	void name_traits<GL_TEXTURE>::bind(GLuint name, GLenum target, std::size_t unit) {
-		glActiveTexture((GLenum)(GL_TEXTURE0 + unit));
-		glBindTexture(target, name);
+		auto& state = context_state::get_current();
+		// The active unit is shadowed as well, under its own "type" so that it
+		// is not affected when a texture name is released. It is selected even
+		// if the texture is already bound, as non-DSA updates that follow a
+		// bind (`glTex*()`) operate on the active unit.
+		if (state.set_binding(GL_ACTIVE_TEXTURE, GL_NONE, 0, (GLuint)unit))
+			glActiveTexture((GLenum)(GL_TEXTURE0 + unit));
+
+		if (state.set_binding(GL_TEXTURE, target, unit, name))
+			glBindTexture(target, name);
 	}
 
-	GLuint name_traits<GL_TRANSFORM_FEEDBACK>::create() {
-		GLuint name;
-		glGenTransformFeedbacks(1, &name);
+	GLuint name_traits<GL_TRANSFORM_FEEDBACK>::create(GLenum) {
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateTransformFeedbacks(1, &name);
+		else
+			glGenTransformFeedbacks(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate transform feedback.");
@@ -156,15 +220,20 @@ namespace heatsink::gl {
 	void name_traits<GL_TRANSFORM_FEEDBACK>::destroy(GLuint name) {
 		assert(name);
 		glDeleteTransformFeedbacks(1, &name);
+		context_state::get_current().release_name(GL_TRANSFORM_FEEDBACK, name);
 	}
 
 	void name_traits<GL_TRANSFORM_FEEDBACK>::bind(GLuint name, GLenum target) {
-		glBindTransformFeedback(target, name);
+		if (context_state::get_current().set_binding(GL_TRANSFORM_FEEDBACK, target, 0, name))
+			glBindTransformFeedback(target, name);
 	}
 
 	GLuint name_traits<GL_VERTEX_ARRAY>::create() {
-		GLuint name;
-		glGenVertexArrays(1, &name);
+		GLuint name = 0;
+		if (has_direct_state_access())
+			glCreateVertexArrays(1, &name);
+		else
+			glGenVertexArrays(1, &name);
 
 		if (!name)
 			throw exception("gl::name_traits", "could not allocate vertex array.");
@@ -175,9 +244,22 @@ namespace heatsink::gl {
 	void name_traits<GL_VERTEX_ARRAY>::destroy(GLuint name) {
 		assert(name);
 		glDeleteVertexArrays(1, &name);
+
+		// Deleting a bound vertex array also reverts the element buffer to that
+		// of the default vertex array.
+		auto& state = context_state::get_current();
+		state.release_name(GL_VERTEX_ARRAY, name);
+		state.invalidate_binding(GL_BUFFER, GL_ELEMENT_ARRAY_BUFFER);
 	}
 
 	void name_traits<GL_VERTEX_ARRAY>::bind(GLuint name) {
+		auto& state = context_state::get_current();
+		if (!state.set_binding(GL_VERTEX_ARRAY, GL_NONE, 0, name))
+			return;
+
+		// The element buffer binding is part of the vertex array state, so it
+		// is no longer known once a different vertex array is bound.
+		state.invalidate_binding(GL_BUFFER, GL_ELEMENT_ARRAY_BUFFER);
 		glBindVertexArray(name);
 	}
 }
@@ -0,0 +1,19 @@
+#include <heatsink/traits/texture.hpp>
+
+namespace heatsink::gl {
+	glm::uvec3 texture_traits::page_size(GLenum target, GLenum ifmt) {
+		GLint count = 0;
+		glGetInternalformativ(target, ifmt, GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &count);
+		if (count == 0)
+			return glm::uvec3(0);
+
+		// Textures always use the first page size unless
+		// `GL_VIRTUAL_PAGE_SIZE_INDEX_ARB` is changed, which is not exposed.
+		GLint x = 0, y = 0, z = 0;
+		glGetInternalformativ(target, ifmt, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &x);
+		glGetInternalformativ(target, ifmt, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &y);
+		glGetInternalformativ(target, ifmt, GL_VIRTUAL_PAGE_SIZE_Z_ARB, 1, &z);
+
+		return glm::uvec3(x, y, z);
+	}
+}